@@ -42,9 +42,15 @@ def main_file_for(snippet: str) -> str:
 #include <format>
 #include <iostream>
 #include <vector>
+#include <span>
 #include <array>
 #include <xpress/xp.hpp>
+#include <xpress/dual.hpp>
+#include <xpress/render.hpp>
+#include <xpress/tabulate.hpp>
 #include <xpress/solvers/newton.hpp>
+#include <xpress/solvers/batched_newton.hpp>
+#include <xpress/solvers/levenberg_marquardt.hpp>
 
 int main() {{
     using namespace xp;
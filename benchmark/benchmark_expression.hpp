@@ -13,3 +13,30 @@
 
 #define UNIT_EXPRESSION(a, b) a*((a + b)*b + (a*b) + b)
 #define GENERATE_EXPRESSION(a, b) ADD_192(UNIT_EXPRESSION(a, b))
+
+#define LIST_2(x) x, x
+#define LIST_4(x) LIST_2(x), LIST_2(x)
+#define LIST_8(x) LIST_4(x), LIST_4(x)
+#define LIST_16(x) LIST_8(x), LIST_8(x)
+#define LIST_32(x) LIST_16(x), LIST_16(x)
+#define LIST_64(x) LIST_32(x), LIST_32(x)
+#define LIST_192(x) LIST_64(x), LIST_64(x), LIST_64(x)
+
+// the same expression as a single flat (n-ary) sum
+#define GENERATE_FLAT_EXPRESSION(a, b) sum(LIST_192(UNIT_EXPRESSION(a, b)))
+
+// nested expressions of increasing depth, where each level adds a multiplication and an addition
+#define DEEP_1(x, a, b) ((x)*a + b)
+#define DEEP_2(x, a, b) DEEP_1(DEEP_1(x, a, b), a, b)
+#define DEEP_4(x, a, b) DEEP_2(DEEP_2(x, a, b), a, b)
+#define DEEP_8(x, a, b) DEEP_4(DEEP_4(x, a, b), a, b)
+#define DEEP_16(x, a, b) DEEP_8(DEEP_8(x, a, b), a, b)
+#define DEEP_32(x, a, b) DEEP_16(DEEP_16(x, a, b), a, b)
+#define DEEP_64(x, a, b) DEEP_32(DEEP_32(x, a, b), a, b)
+
+// a deep and a wide expression with a comparable number of operations
+#define GENERATE_DEEP_EXPRESSION(a, b) DEEP_64(a, a, b)
+#define GENERATE_WIDE_EXPRESSION(a, b) sum(LIST_64(a*b + a))
+
+// an expression in which the same (costly) sub-expression occurs many times
+#define GENERATE_REPEATED_EXPRESSION(a, b) sum(LIST_64(log(a*b + b)*a))
@@ -4,56 +4,210 @@
 #pragma once
 
 #include <type_traits>
+#include <string_view>
+#include <filesystem>
+#include <algorithm>
 #include <concepts>
 #include <iostream>
+#include <fstream>
 #include <utility>
+#include <cstddef>
 #include <vector>
 #include <chrono>
+#include <string>
+#include <cmath>
 
 namespace xp::benchmark {
 
+//! Prevent the compiler from optimizing away the computation of the given value
+template<typename T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*))
+        asm volatile("" : : "r,m"(value) : "memory");
+    else
+        asm volatile("" : : "m"(value) : "memory");
+#else
+    const volatile char* sink = reinterpret_cast<const volatile char*>(&value);
+    static_cast<void>(*sink);
+#endif
+}
+
+//! Prevent the compiler from reordering memory accesses across this point
+inline void clobber_memory() {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+//! Runtimes (in seconds per invocation) collected in a benchmark, and statistics over them
 class Measurement {
  public:
     void push(double measurement) {
         _measurements.push_back(measurement);
     }
 
-    void write_report_to(std::ostream& out) const {
+    //! Set the number of invocations that were timed together in each measurement
+    void set_batch_size(std::size_t batch_size) {
+        _batch_size = batch_size;
+    }
+
+    std::size_t size() const { return _measurements.size(); }
+    std::size_t batch_size() const { return _batch_size; }
+
+    double average() const {
         double average = 0.0;
         for (const auto& m : _measurements)
             average += m;
-        average /= static_cast<double>(_measurements.size());
-        out << "average runtime: " << average << std::endl;
+        return average/static_cast<double>(_measurements.size());
+    }
+
+    double standard_deviation() const {
+        if (_measurements.size() < 2)
+            return 0.0;
+        const double mean = average();
+        double sum_of_squares = 0.0;
+        for (const auto& m : _measurements)
+            sum_of_squares += (m - mean)*(m - mean);
+        return std::sqrt(sum_of_squares/static_cast<double>(_measurements.size() - 1));
+    }
+
+    //! Return the given percentile (in [0, 100]), interpolating linearly between the closest measurements
+    double percentile(double p) const {
+        auto sorted = _measurements;
+        std::ranges::sort(sorted);
+        const double position = std::clamp(p, 0.0, 100.0)/100.0*static_cast<double>(sorted.size() - 1);
+        const auto lower = static_cast<std::size_t>(position);
+        const auto upper = std::min(lower + 1, sorted.size() - 1);
+        const double weight = position - static_cast<double>(lower);
+        return (1.0 - weight)*sorted[lower] + weight*sorted[upper];
+    }
+
+    double median() const { return percentile(50.0); }
+    double min() const { return std::ranges::min(_measurements); }
+    double max() const { return std::ranges::max(_measurements); }
+
+    void write_report_to(std::ostream& out) const {
+        out << "average runtime: " << average() << std::endl;
+        out << "median runtime: " << median() << std::endl;
+        out << "min runtime: " << min() << std::endl;
+        out << "standard deviation: " << standard_deviation() << std::endl;
+        out << "p95/p99 runtime: " << percentile(95.0) << "/" << percentile(99.0) << std::endl;
+        out << "samples: " << size() << " (invocations per sample: " << batch_size() << ")" << std::endl;
+    }
+
+    //! Write the statistics as a json object, which is what `compare.py` reads
+    void write_json_to(std::ostream& out, std::string_view name) const {
+        const auto precision = out.precision(17);
+        out << "{\n"
+            << "  \"name\": \"" << name << "\",\n"
+            << "  \"unit\": \"s\",\n"
+            << "  \"samples\": " << size() << ",\n"
+            << "  \"batch_size\": " << batch_size() << ",\n"
+            << "  \"mean\": " << average() << ",\n"
+            << "  \"median\": " << median() << ",\n"
+            << "  \"min\": " << min() << ",\n"
+            << "  \"max\": " << max() << ",\n"
+            << "  \"stddev\": " << standard_deviation() << ",\n"
+            << "  \"p95\": " << percentile(95.0) << ",\n"
+            << "  \"p99\": " << percentile(99.0) << "\n"
+            << "}\n";
+        out.precision(precision);
     }
 
  private:
     std::vector<double> _measurements;
+    std::size_t _batch_size = 1;
+};
+
+//! Options for the adaptive measurement of runtimes
+struct Options {
+    double min_batch_time = 1e-4;          //!< invocations are timed in batches that take at least this long (in seconds)
+    double min_warmup_time = 0.05;         //!< minimum time spent on warming up (in seconds)
+    double warmup_tolerance = 0.02;        //!< warmup ends once the median of two subsequent rounds differs by less than this
+    std::size_t min_samples = 20;
+    std::size_t max_samples = 2000;
+    double target_relative_error = 0.002;  //!< sampling ends once the standard error of the mean is below this (relative)
+    double max_time = 5.0;                 //!< maximum time spent on warmup and sampling (in seconds)
 };
 
 template<std::invocable action>
 auto measure_invocation(action&& a) {
     auto t1 = std::chrono::steady_clock::now();
     auto result = a();
+    do_not_optimize(result);
     auto t2 = std::chrono::steady_clock::now();
     return std::make_pair(std::chrono::duration<double>(t2 - t1).count(), result);
 }
 
-// TODO: instead of size_ts for warmup phase etc, decide automatically based on fluctuations
+//! Measure the time (in seconds) of invoking the given action `count` times in a row
 template<std::invocable action>
-auto measure(action&& a, std::size_t warmup = 10, std::size_t measurements = 20) {
-    for (std::size_t i = 0; i < warmup; ++i)
-        a();
+double measure_batch(action& a, std::size_t count) {
+    auto t1 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        auto result = a();
+        do_not_optimize(result);
+        clobber_memory();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count();
+}
 
-    Measurement measurement;
-    for (std::size_t i = 0; i < measurements - 1; ++i) {
-        auto [runtime, _] = measure_invocation(a);
-        measurement.push(runtime);
+/*!
+ * \brief Measure the runtime of the given action. Invocations are timed in batches that take at least
+ *        `options.min_batch_time`, such that also kernels that take nanoseconds are measured accurately.
+ *        The warmup continues until the runtimes are stable, and samples are taken until the mean is
+ *        known within the target accuracy (or the time budget is exhausted).
+ */
+template<std::invocable action>
+auto measure(action&& a, const Options& options = {}) {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    const auto elapsed = [&] () { return std::chrono::duration<double>(clock::now() - start).count(); };
+
+    std::size_t batch_size = 1;
+    while (measure_batch(a, batch_size) < options.min_batch_time && batch_size < (std::size_t{1} << 30))
+        batch_size *= 2;
+
+    const auto round_median = [&] () {
+        Measurement round;
+        for (std::size_t i = 0; i < 5; ++i)
+            round.push(measure_batch(a, batch_size));
+        return round.median();
+    };
+    double previous = round_median();
+    while (elapsed() < options.max_time/4.0) {
+        const double current = round_median();
+        const bool is_stable = std::abs(current - previous) <= options.warmup_tolerance*previous;
+        previous = current;
+        if (is_stable && elapsed() >= options.min_warmup_time)
+            break;
     }
 
-    auto [runtime, result] = measure_invocation(a);
-    measurement.push(runtime);
+    Measurement measurement;
+    measurement.set_batch_size(batch_size);
+    const auto is_accurate = [&] () {
+        const double standard_error = measurement.standard_deviation()/std::sqrt(static_cast<double>(measurement.size()));
+        return standard_error <= options.target_relative_error*measurement.average();
+    };
+    while (measurement.size() < options.max_samples) {
+        measurement.push(measure_batch(a, batch_size)/static_cast<double>(batch_size));
+        if (measurement.size() >= options.min_samples && (is_accurate() || elapsed() > options.max_time))
+            break;
+    }
 
+    auto result = a();
     return std::make_pair(measurement, result);
 }
 
+//! Write the report of the given measurement to std::cout, and as json into the file given with `--json <file>`
+inline void write_reports(const Measurement& measurement, int argc, char** argv) {
+    measurement.write_report_to(std::cout);
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::string_view{argv[i]} == "--json") {
+            std::ofstream file{argv[i + 1]};
+            measurement.write_json_to(file, std::filesystem::path{argv[0]}.filename().string());
+        }
+}
+
 }  // namespace xp::benchmark
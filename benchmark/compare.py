@@ -3,7 +3,9 @@
 
 import os
 import sys
+import json
 import time
+import tempfile
 import subprocess
 import argparse
 
@@ -22,36 +24,67 @@ def binary_size(exe: str) -> float:
     return os.path.getsize(exe)
 
 
-def run(exe: str) -> float:
+def run(exe: str) -> dict:
     print(f"Running {exe}")
-    output = subprocess.run([f"./{exe}"], check=True, capture_output=True, text=True).stdout
-    print(output)
-    return float(output.split("average runtime:")[1].split("\n")[0])
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        json_file = os.path.join(tmp_dir, "report.json")
+        output = subprocess.run([f"./{exe}", "--json", json_file], check=True, capture_output=True, text=True).stdout
+        print(output)
+        with open(json_file) as report:
+            return json.load(report)
+
+
+def describe(report: dict, statistic: str) -> str:
+    if "stddev" in report:
+        return f"{report[statistic]:.4g} +- {report['stddev']:.2g} ({report['samples']} samples)"
+    return f"{report[statistic]:.4g}"
+
+
+def load(report_file: str) -> dict:
+    with open(report_file) as report:
+        return json.load(report)
 
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
-    parser.add_argument("-e", "--executables", required=True, nargs="*", help="The benchmark executables to run")
+    parser.add_argument("-e", "--executables", required=False, nargs="*", help="The benchmark executables to run")
+    parser.add_argument("-r", "--reports", required=False, nargs="*", help="Previously written json reports to compare instead")
     parser.add_argument("-n", "--names", required=True, nargs="*", help="The displayed names of the benchmarks")
     parser.add_argument("-c", "--clean", required=False, default=True, help="If set to true, recompilation is forced and compile-time info is displayed")
+    parser.add_argument("-s", "--statistic", required=False, default="median", choices=["median", "mean", "min", "p95", "p99", "wall_time", "peak_memory", "object_size"], help="The statistic to compare (the latter ones for compile-time reports)")
+    parser.add_argument("-o", "--output", required=False, help="Write the collected reports into this json file")
     args = vars(parser.parse_args())
 
-    exes = args["executables"]
+    exes = args["executables"] or []
     names = args["names"]
-    if len(exes) != len(names):
-        sys.stderr.write("Number of executables and names don't match")
+    if bool(exes) == bool(args["reports"]):
+        sys.stderr.write("Either executables or reports have to be given")
         sys.exit(1)
+    if len(exes or args["reports"]) != len(names):
+        sys.stderr.write("Number of executables/reports and names don't match")
+        sys.exit(1)
+
+    if exes:
+        if args["clean"]:
+            subprocess.run(["make", "clean"], check=True)
+
+        compile_times = [compile(e) for e in exes]
+        reports = [run(e) for e in exes]
 
-    if args["clean"]:
-        subprocess.run(["make", "clean"], check=True)
+        if args["clean"]:
+            print("Compile time ratios:")
+            print(f"\n".join(f" -- {names[i]}/{names[0]}: {compile_times[i]/compile_times[0]:.2f}" for i in range(1, len(names))))
+        print("Binary size ratios:")
+        print(f"\n".join(f" -- {names[i]}/{names[0]}: {binary_size(exes[i])/binary_size(exes[0]):.2f}" for i in range(1, len(names))))
+    else:
+        reports = [load(r) for r in args["reports"]]
 
-    compile_times = [compile(e) for e in exes]
-    runtimes = [run(e) for e in exes]
+    statistic = args["statistic"]
+    print(f"Values of {statistic}:")
+    print(f"\n".join(f" -- {names[i]}: {describe(reports[i], statistic)}" for i in range(len(names))))
+    print(f"Ratios ({statistic}):")
+    print(f"\n".join(f" -- {names[i]}/{names[0]}: {reports[i][statistic]/reports[0][statistic]:.3f}" for i in range(1, len(names))))
 
-    if args["clean"]:
-        print("Compile time ratios:")
-        print(f"\n".join(f" -- {names[i]}/{names[0]}: {compile_times[i]/compile_times[0]:.2f}" for i in range(1, len(names))))
-    print("Binary size ratios:")
-    print(f"\n".join(f" -- {names[i]}/{names[0]}: {binary_size(exes[i])/binary_size(exes[0]):.2f}" for i in range(1, len(names))))
-    print("Runtime ratios:")
-    print(f"\n".join(f" -- {names[i]}/{names[0]}: {runtimes[i]/runtimes[0]:.2f}" for i in range(1, len(names))))
+    if args["output"]:
+        with open(args["output"], "w") as output:
+            json.dump({name: report for name, report in zip(names, reports)}, output, indent=2)
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Translation unit whose compilation is measured. Select the case with XPRESS_COMPILE_TIME_CASE:
+//  1: evaluation of a chain of n unit terms
+//  2: derivatives of a chain of n unit terms w.r.t. both variables
+//  3: evaluation of the n-th derivative of a small expression
+//  4: evaluation of an expression on tensors of shape n x n
+// XPRESS_COMPILE_TIME_SIZE defines n.
+
+#include <xpress/xp.hpp>
+
+#include "generators.hpp"
+
+#ifndef XPRESS_COMPILE_TIME_CASE
+#define XPRESS_COMPILE_TIME_CASE 1
+#endif
+
+#ifndef XPRESS_COMPILE_TIME_SIZE
+#define XPRESS_COMPILE_TIME_SIZE 16
+#endif
+
+inline constexpr std::size_t n = XPRESS_COMPILE_TIME_SIZE;
+
+#if XPRESS_COMPILE_TIME_CASE == 1
+double evaluate(double a_value, double b_value) {
+    using namespace xp;
+    var a;
+    var b;
+    return value_of(benchmark::chain_of<n>(benchmark::unit_expression(a, b)), at(a = a_value, b = b_value));
+}
+#elif XPRESS_COMPILE_TIME_CASE == 2
+double evaluate(double a_value, double b_value) {
+    using namespace xp;
+    var a;
+    var b;
+    const auto derivs = derivatives_of(
+        benchmark::chain_of<n>(benchmark::unit_expression(a, b)), wrt(a, b), at(a = a_value, b = b_value)
+    );
+    return derivs[a] + derivs[b];
+}
+#elif XPRESS_COMPILE_TIME_CASE == 3
+double evaluate(double a_value, double b_value) {
+    using namespace xp;
+    var a;
+    var b;
+    return value_of(benchmark::nth_derivative_of<n>(a*a*log(a*b), a), at(a = a_value, b = b_value));
+}
+#elif XPRESS_COMPILE_TIME_CASE == 4
+double evaluate(double a_value, double) {
+    using namespace xp;
+    tensor T{shape<n, n>};
+    const linalg::tensor<double, md_shape<n, n>> T_value{a_value};
+    return value_of(T*mat_mul(T, T) + T*T, at(T = T_value));
+}
+#else
+#error "Unknown compile-time benchmark case"
+#endif
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <utility>
+#include <cstddef>
+
+#include <xpress/xp.hpp>
+
+namespace xp::benchmark {
+
+//! The unit term of the runtime benchmarks (see `UNIT_EXPRESSION` in benchmark_expression.hpp)
+template<typename A, typename B>
+constexpr auto unit_expression(const A& a, const B& b) {
+    return a*((a + b)*b + (a*b) + b);
+}
+
+//! Left-leaning sum of n copies of the given term, i.e. the expression that `ADD_n(term)` expands to
+template<std::size_t n, typename T> requires(n > 0)
+constexpr auto chain_of(const T&) {
+    return [] <std::size_t... i> (const std::index_sequence<i...>&) {
+        return (T{} + ... + (static_cast<void>(i), T{}));
+    } (std::make_index_sequence<n - 1>{});
+}
+
+//! The n-th derivative of the given expression w.r.t. the given variable
+template<std::size_t n, typename E, typename V>
+constexpr auto nth_derivative_of(const E& expression, const V& variable) {
+    if constexpr (n == 0)
+        return expression;
+    else
+        return nth_derivative_of<n - 1>(derivative_of(expression, wrt(variable)), variable);
+}
+
+}  // namespace xp::benchmark
@@ -0,0 +1,56 @@
+# SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+# SPDX-License-Identifier: MIT
+
+# Compiler launcher that runs the given compile command and writes its wall time, peak memory
+# and the size of the resulting object file as a json report (which `compare.py` can load).
+# Usage: measure_compile.py --report <file> --name <name> <compiler> <args...>
+
+import os
+import sys
+import json
+import time
+import platform
+import resource
+import subprocess
+
+
+def object_file_of(command: list[str]) -> str | None:
+    for i, arg in enumerate(command[:-1]):
+        if arg == "-o":
+            return command[i + 1]
+    return None
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 6 or sys.argv[1] != "--report" or sys.argv[3] != "--name":
+        sys.stderr.write("Usage: measure_compile.py --report <file> --name <name> <compiler> <args...>\n")
+        sys.exit(1)
+
+    report_file = sys.argv[2]
+    name = sys.argv[4]
+    command = sys.argv[5:]
+
+    t1 = time.perf_counter()
+    returncode = subprocess.run(command).returncode
+    t2 = time.perf_counter()
+    if returncode != 0:
+        sys.exit(returncode)
+
+    # ru_maxrss is given in kilobytes on Linux, but in bytes on macOS
+    peak_memory = resource.getrusage(resource.RUSAGE_CHILDREN).ru_maxrss
+    if platform.system() != "Darwin":
+        peak_memory *= 1024
+
+    object_file = object_file_of(command)
+    time_trace = os.path.splitext(object_file)[0] + ".json" if object_file else None
+    report = {
+        "name": name,
+        "wall_time": t2 - t1,
+        "peak_memory": peak_memory,
+        "object_size": os.path.getsize(object_file) if object_file and os.path.exists(object_file) else 0,
+    }
+    if time_trace and os.path.exists(time_trace):
+        report["time_trace"] = os.path.abspath(time_trace)
+
+    with open(report_file, "w") as out:
+        json.dump(report, out, indent=2)
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include <cmath>
+#include <span>
+
+#include <cuda_runtime.h>
+
+#include <xpress/symbols.hpp>
+#include <xpress/operators.hpp>
+#include <xpress/evaluation.hpp>
+#include <xpress/batch.hpp>
+
+#include "common.hpp"
+#include "benchmark_expression.hpp"
+
+// evaluates the expression at one point per thread, with the same formula that is used on the host
+template<typename E, typename A, typename B>
+__global__ void evaluate_kernel(E expr, A a, B b, const double* a_values, const double* b_values, double* out, std::size_t n) {
+    const std::size_t i = static_cast<std::size_t>(blockIdx.x)*blockDim.x + threadIdx.x;
+    if (i < n)
+        out[i] = xp::value_of(expr, xp::at(a = a_values[i], b = b_values[i]));
+}
+
+void check(cudaError_t status) {
+    if (status != cudaSuccess) {
+        std::cerr << "CUDA error: " << cudaGetErrorString(status) << std::endl;
+        std::exit(1);
+    }
+}
+
+// reports the throughput of the evaluation of an expression on the device against the batched evaluation on the host
+int main() {
+    using namespace xp;
+
+    var a;
+    var b;
+    const auto expr = GENERATE_EXPRESSION(a, b) + log(a*b)*pow(a, val<3>);
+    const std::size_t num_points = 1'000'000;
+    std::vector<double> a_values(num_points);
+    std::vector<double> b_values(num_points);
+    for (std::size_t i = 0; i < num_points; ++i) {
+        a_values[i] = 2.0 + 1e-6*static_cast<double>(i);
+        b_values[i] = 5.0 - 1e-6*static_cast<double>(i);
+    }
+
+    std::vector<double> host_out(num_points);
+    auto [host_measurement, host_result] = benchmark::measure([&] () {
+        evaluator{expr}.batch(std::span{host_out}, a = std::span{a_values}, b = std::span{b_values});
+        return host_out[0];
+    }, {.min_samples = 5, .max_time = 2.0});
+    std::cout << "host; value = " << host_result << "; ";
+    host_measurement.write_report_to(std::cout);
+    std::cout << "  throughput (points/s): " << static_cast<double>(num_points)/host_measurement.average() << std::endl;
+
+    const std::size_t bytes = num_points*sizeof(double);
+    double* device_a;
+    double* device_b;
+    double* device_out;
+    check(cudaMalloc(&device_a, bytes));
+    check(cudaMalloc(&device_b, bytes));
+    check(cudaMalloc(&device_out, bytes));
+    check(cudaMemcpy(device_a, a_values.data(), bytes, cudaMemcpyHostToDevice));
+    check(cudaMemcpy(device_b, b_values.data(), bytes, cudaMemcpyHostToDevice));
+
+    static constexpr unsigned int threads_per_block = 256;
+    const auto blocks = static_cast<unsigned int>((num_points + threads_per_block - 1)/threads_per_block);
+    auto [device_measurement, device_result] = benchmark::measure([&] () {
+        evaluate_kernel<<<blocks, threads_per_block>>>(expr, a, b, device_a, device_b, device_out, num_points);
+        check(cudaDeviceSynchronize());
+        return device_out;
+    }, {.min_samples = 5, .max_time = 2.0});
+
+    std::vector<double> device_values(num_points);
+    check(cudaMemcpy(device_values.data(), device_out, bytes, cudaMemcpyDeviceToHost));
+    double max_deviation = 0.0;
+    double max_value = 0.0;
+    for (std::size_t i = 0; i < num_points; ++i) {
+        max_deviation = std::max(max_deviation, std::abs(device_values[i] - host_out[i]));
+        max_value = std::max(max_value, std::abs(host_out[i]));
+    }
+
+    std::cout << "device; value = " << device_values[0] << "; ";
+    device_measurement.write_report_to(std::cout);
+    std::cout << "  throughput (points/s): " << static_cast<double>(num_points)/device_measurement.average() << std::endl;
+    std::cout << "  max deviation from host: " << max_deviation << std::endl;
+
+    check(cudaFree(device_a));
+    check(cudaFree(device_b));
+    check(cudaFree(device_out));
+    return max_deviation <= 1e-12*max_value ? 0 : 1;
+}
@@ -3,10 +3,22 @@
 
 #include <iostream>
 
+#ifndef USE_VALUE
+#define USE_VALUE 0
+#endif
+
+#ifndef USE_FUSED
+#define USE_FUSED 0
+#endif
+
 #ifndef USE_AUTODIFF
 #define USE_AUTODIFF 0
 #endif
 
+#ifndef USE_FLAT
+#define USE_FLAT 0
+#endif
+
 #if USE_AUTODIFF
 #include <autodiff/forward/dual.hpp>
 #include <autodiff/reverse/var.hpp>
@@ -16,6 +28,15 @@
 
 #include "common.hpp"
 #include "benchmark_expression.hpp"
+#if !USE_AUTODIFF
+#include "introspection.hpp"
+#endif
+
+#if USE_FLAT
+#define XPRESS_EXPRESSION(a, b) GENERATE_FLAT_EXPRESSION(a, b)
+#else
+#define XPRESS_EXPRESSION(a, b) GENERATE_EXPRESSION(a, b)
+#endif
 
 using namespace xp;
 
@@ -25,7 +46,7 @@ autodiff::dual f(autodiff::dual _a, autodiff::dual _b) {
 }
 #endif
 
-int main() {
+int main(int argc, char** argv) {
 
     const double a_value = 2.0;
     const double b_value = 5.0;
@@ -51,15 +72,36 @@ int main() {
 #else
     var a;
     var b;
-    auto [measurement, result] = benchmark::measure([&] () {
-        const auto derivs = derivatives_of(GENERATE_EXPRESSION(a, b), wrt(a, b), at(a = a_value, b = b_value));
-        return std::make_tuple(derivs[a], derivs[b]);
-    });
+    #if USE_FUSED
+        auto [measurement, result] = benchmark::measure([&] () {
+            const auto [value, derivs] = value_and_derivatives_of(XPRESS_EXPRESSION(a, b), wrt(a, b), at(a = a_value, b = b_value));
+            return std::make_tuple(derivs[a], derivs[b], value);
+        });
+    #elif USE_VALUE
+        auto [measurement, result] = benchmark::measure([&] () {
+            const auto value = value_of(XPRESS_EXPRESSION(a, b), at(a = a_value, b = b_value));
+            const auto derivs = derivatives_of(XPRESS_EXPRESSION(a, b), wrt(a, b), at(a = a_value, b = b_value));
+            return std::make_tuple(derivs[a], derivs[b], value);
+        });
+    #else
+        auto [measurement, result] = benchmark::measure([&] () {
+            const auto derivs = derivatives_of(XPRESS_EXPRESSION(a, b), wrt(a, b), at(a = a_value, b = b_value));
+            return std::make_tuple(derivs[a], derivs[b]);
+        });
+    #endif
 #endif
 
     std::cout << "d_da = " << std::get<0>(result) << std::endl;
     std::cout << "d_db = " << std::get<1>(result) << std::endl;
-    measurement.write_report_to(std::cout);
+#if !USE_AUTODIFF && (USE_VALUE || USE_FUSED)
+    std::cout << "value = " << std::get<2>(result) << std::endl;
+#endif
+#if !USE_AUTODIFF
+    benchmark::write_expression_info_to(std::cout, "expression", XPRESS_EXPRESSION(a, b));
+    benchmark::write_derivative_info_to(std::cout, "d_da", derivative_of(XPRESS_EXPRESSION(a, b), wrt(a)));
+    benchmark::write_derivative_info_to(std::cout, "d_db", derivative_of(XPRESS_EXPRESSION(a, b), wrt(b)));
+#endif
+    benchmark::write_reports(measurement, argc, argv);
 
     return 0;
 }
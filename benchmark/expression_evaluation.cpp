@@ -2,11 +2,25 @@
 // SPDX-License-Identifier: MIT
 
 #include <iostream>
+#include <vector>
+#include <span>
 
 #ifndef USE_AUTODIFF
 #define USE_AUTODIFF 0
 #endif
 
+#ifndef USE_FLAT
+#define USE_FLAT 0
+#endif
+
+#ifndef USE_CSE
+#define USE_CSE 0
+#endif
+
+#ifndef USE_BATCH
+#define USE_BATCH 0
+#endif
+
 #if USE_AUTODIFF
 #include <autodiff/forward/dual.hpp>
 #include <autodiff/reverse/var.hpp>
@@ -16,6 +30,15 @@
 
 #include "common.hpp"
 #include "benchmark_expression.hpp"
+#if !USE_AUTODIFF
+#include "introspection.hpp"
+#endif
+
+#if USE_FLAT
+#define XPRESS_EXPRESSION(a, b) GENERATE_FLAT_EXPRESSION(a, b)
+#else
+#define XPRESS_EXPRESSION(a, b) GENERATE_EXPRESSION(a, b)
+#endif
 
 #if USE_AUTODIFF
 autodiff::dual f(autodiff::dual _a, autodiff::dual _b) {
@@ -23,7 +46,7 @@ autodiff::dual f(autodiff::dual _a, autodiff::dual _b) {
 }
 #endif
 
-int main() {
+int main(int argc, char** argv) {
     using namespace xp;
 
     const double a_value = 2.0;
@@ -48,12 +71,32 @@ int main() {
 #else
     var a;
     var b;
+#if USE_BATCH
+    // evaluate at many points at once, reporting the value at the first point
+    const std::size_t num_points = 10000;
+    std::vector<double> a_values(num_points, a_value);
+    std::vector<double> b_values(num_points, b_value);
+    std::vector<double> out(num_points);
+    auto [measurement, result] = benchmark::measure([&] () {
+        evaluator{XPRESS_EXPRESSION(a, b)}.batch(std::span{out}, a = std::span{a_values}, b = std::span{b_values});
+        return out[0];
+    });
+    std::cout << "Number of points = " << num_points << std::endl;
+#else
     auto [measurement, result] = benchmark::measure([&] () {
-        return value_of(GENERATE_EXPRESSION(a, b), at(a = a_value, b = b_value));
+    #if USE_CSE
+        return value_of(XPRESS_EXPRESSION(a, b), at(a = a_value, b = b_value), cse);
+    #else
+        return value_of(XPRESS_EXPRESSION(a, b), at(a = a_value, b = b_value));
+    #endif
     });
+#endif
 #endif
     std::cout << "Value = " << result << std::endl;
-    measurement.write_report_to(std::cout);
+#if !USE_AUTODIFF
+    benchmark::write_expression_info_to(std::cout, "expression", XPRESS_EXPRESSION(a, b));
+#endif
+    benchmark::write_reports(measurement, argc, argv);
 
     return 0;
 }
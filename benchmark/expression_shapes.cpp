@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <iostream>
+
+#ifndef USE_DEEP
+#define USE_DEEP 0
+#endif
+
+#ifndef USE_WIDE
+#define USE_WIDE 0
+#endif
+
+#ifndef USE_MANY_VARIABLES
+#define USE_MANY_VARIABLES 0
+#endif
+
+#ifndef USE_FEW_VARIABLES
+#define USE_FEW_VARIABLES 0
+#endif
+
+#ifndef USE_REPEATED
+#define USE_REPEATED 0
+#endif
+
+#ifndef USE_CSE
+#define USE_CSE 0
+#endif
+
+#include <xpress/xp.hpp>
+
+#include "common.hpp"
+#include "benchmark_expression.hpp"
+#include "introspection.hpp"
+
+// benchmarks for different shapes of expressions (select one with the USE_* definitions)
+int main(int argc, char** argv) {
+    using namespace xp;
+
+    var a;
+    var b;
+#if USE_DEEP || USE_WIDE || USE_REPEATED
+    #if USE_DEEP
+        const auto expression = GENERATE_DEEP_EXPRESSION(a, b);
+    #elif USE_WIDE
+        const auto expression = GENERATE_WIDE_EXPRESSION(a, b);
+    #else
+        const auto expression = GENERATE_REPEATED_EXPRESSION(a, b);
+    #endif
+    auto [measurement, result] = benchmark::measure([&] () {
+    #if USE_CSE
+        return value_of(expression, at(a = 0.5, b = 0.25), cse);
+    #else
+        return value_of(expression, at(a = 0.5, b = 0.25));
+    #endif
+    });
+    std::cout << "Value = " << result << std::endl;
+#elif USE_MANY_VARIABLES
+    // gradient of a cyclic sum of products of 16 variables
+    var c; var d; var e; var f; var g; var h;
+    var i; var j; var k; var l; var m; var n; var o; var p;
+    const auto expression = sum(
+        a*b, b*c, c*d, d*e, e*f, f*g, g*h, h*i,
+        i*j, j*k, k*l, l*m, m*n, n*o, o*p, p*a
+    );
+    auto [measurement, result] = benchmark::measure([&] () {
+        const auto gradient = gradient_of(expression, at(
+            a = 1.0, b = 2.0, c = 3.0, d = 4.0, e = 5.0, f = 6.0, g = 7.0, h = 8.0,
+            i = 9.0, j = 10.0, k = 11.0, l = 12.0, m = 13.0, n = 14.0, o = 15.0, p = 16.0
+        ));
+        return gradient[a] + gradient[p];
+    });
+    std::cout << "de_da + de_dp = " << result << std::endl;
+#elif USE_FEW_VARIABLES
+    // gradient of a sum of 16 products of 2 variables (the same number of operations as above)
+    const auto expression = sum(LIST_16(a*b));
+    auto [measurement, result] = benchmark::measure([&] () {
+        const auto gradient = gradient_of(expression, at(a = 1.0, b = 2.0));
+        return gradient[a] + gradient[b];
+    });
+    std::cout << "de_da + de_db = " << result << std::endl;
+#else
+    #error "Please select an expression shape with one of the USE_* definitions"
+#endif
+
+    benchmark::write_expression_info_to(std::cout, "expression", expression);
+    benchmark::write_reports(measurement, argc, argv);
+
+    return 0;
+}
@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <iostream>
+#include <string_view>
+
+#include <xpress/xp.hpp>
+
+namespace xp::benchmark {
+
+template<typename E>
+void write_expression_info_to(std::ostream& out, std::string_view name, const E&) {
+    using namespace xp::traits;
+    out << name << " depth: " << depth_of_v<E> << std::endl;
+    out << name << " nodes: " << node_count_of_v<E> << " (unique: " << unique_node_count_of_v<E> << ")" << std::endl;
+    out << name << " operations:"
+        << " add=" << operation_count_of_v<operators::add, E>
+        << " subtract=" << operation_count_of_v<operators::subtract, E>
+        << " multiply=" << operation_count_of_v<operators::multiply, E>
+        << " divide=" << operation_count_of_v<operators::divide, E>
+        << " pow=" << operation_count_of_v<operators::pow, E>
+        << " log=" << operation_count_of_v<operators::log, E>
+        << std::endl;
+    out << name << " estimated cost: " << evaluation_cost_of_v<E>
+        << " (unique: " << unique_evaluation_cost_of_v<E> << ")" << std::endl;
+}
+
+template<typename E>
+void write_derivative_info_to(std::ostream& out, std::string_view name, const E& derivative) {
+    write_expression_info_to(out, name, derivative);
+    out << name << " estimated cost after simplification: "
+        << xp::traits::evaluation_cost_of_v<xp::traits::simplified_of_t<E>>
+        << " (unique: " << xp::traits::unique_evaluation_cost_of_v<xp::traits::simplified_of_t<E>> << ")" << std::endl;
+}
+
+}  // namespace xp::benchmark
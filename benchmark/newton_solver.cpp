@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <iostream>
+
+#ifndef USE_SYSTEM
+#define USE_SYSTEM 0
+#endif
+
+#include <xpress/xp.hpp>
+#include <xpress/solvers/newton.hpp>
+
+#include "common.hpp"
+
+// solution of a scalar equation, or of a system of two equations, with the Newton solver
+int main(int argc, char** argv) {
+    using namespace xp;
+
+    var a;
+    var b;
+    const solvers::newton solver{{.threshold = 1e-12, .max_iterations = 50}};
+#if USE_SYSTEM
+    const auto equations = vector_expression_builder<2>{}
+                            .with(a*a + b*b - val<4.0>, at<0>())
+                            .with(a*b - val<1.0>, at<1>())
+                            .build();
+    auto [measurement, result] = benchmark::measure([&] () {
+        return solver.find_root_of(equations, solvers::starting_from(a = 2.0, b = 0.3));
+    });
+    std::cout << "a = " << result.value()[a] << "; b = " << result.value()[b] << std::endl;
+#else
+    const auto equation = a*a*a - val<2.0>*a - val<5.0>;
+    auto [measurement, result] = benchmark::measure([&] () {
+        return solver.find_scalar_root_of(equation, solvers::starting_from(a = 3.0));
+    });
+    std::cout << "a = " << result.value() << std::endl;
+#endif
+    benchmark::write_reports(measurement, argc, argv);
+
+    return 0;
+}
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <span>
+
+#include <xpress/xp.hpp>
+#include <xpress/parallel.hpp>
+
+#include "common.hpp"
+#include "benchmark_expression.hpp"
+
+// reports the throughput of the (batched) parallel evaluation against the number of threads
+int main() {
+    using namespace xp;
+
+    var a;
+    var b;
+    const std::size_t num_points = 1'000'000;
+    std::vector<double> a_values(num_points);
+    std::vector<double> b_values(num_points);
+    for (std::size_t i = 0; i < num_points; ++i) {
+        a_values[i] = 2.0 + 1e-6*static_cast<double>(i);
+        b_values[i] = 5.0 - 1e-6*static_cast<double>(i);
+    }
+    std::vector<double> out(num_points);
+
+    const std::size_t max_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    for (std::size_t num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        auto [measurement, result] = benchmark::measure([&] () {
+            parallel_batch(
+                GENERATE_EXPRESSION(a, b),
+                std::span{out},
+                threads{num_threads},
+                a = std::span{a_values},
+                b = std::span{b_values}
+            );
+            return out[0];
+        }, {.min_samples = 5, .max_time = 2.0});
+        std::cout << "threads = " << num_threads << "; value = " << result << "; ";
+        measurement.write_report_to(std::cout);
+        std::cout << "  throughput (points/s): " << static_cast<double>(num_points)/measurement.average() << std::endl;
+    }
+
+    return 0;
+}
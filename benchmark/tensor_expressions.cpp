@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <iostream>
+
+#include <xpress/xp.hpp>
+
+#include "common.hpp"
+#include "introspection.hpp"
+
+// evaluation of an expression on 3x3 tensors with matrix products, determinants and element-wise operations
+int main(int argc, char** argv) {
+    using namespace xp;
+
+    tensor A{shape<3, 3>};
+    tensor B{shape<3, 3>};
+    vector<3> v;
+    const auto expression = det(mat_mul(A, B) + A*val<2> - B) + mat_mul(A, v)*v;
+
+    const linalg::tensor A_value{shape<3, 3>, 2.0, 1.0, 0.5, 0.0, 3.0, 1.0, 1.0, 0.5, 4.0};
+    const linalg::tensor B_value{shape<3, 3>, 1.0, 0.0, 2.0, 0.5, 1.0, 0.0, 0.0, 2.0, 1.0};
+    const linalg::tensor v_value{shape<3>, 1.0, 2.0, 3.0};
+    auto [measurement, result] = benchmark::measure([&] () {
+        return value_of(expression, at(A = A_value, B = B_value, v = v_value));
+    });
+
+    std::cout << "Value = " << result << std::endl;
+    benchmark::write_expression_info_to(std::cout, "expression", expression);
+    benchmark::write_reports(measurement, argc, argv);
+
+    return 0;
+}
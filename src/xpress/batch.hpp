@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Batched evaluation of expressions at many points.
+ */
+#pragma once
+
+#include <array>
+#include <span>
+#include <cassert>
+#include <ranges>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "type_traits.hpp"
+#include "bindings.hpp"
+#include "expressions.hpp"
+#include "operators.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+/*!
+ * \brief Number of points evaluated at once in batched evaluations. With double precision, each node
+ *        of an expression then produces 512 bytes of values, such that typical trees fit into the L1 cache.
+ */
+inline constexpr std::size_t batch_block_size = 64;
+
+/*!
+ * \brief The values of a scalar at a block of points, stored contiguously (structure-of-arrays).
+ *        Operators act element-wise on blocks (broadcasting scalar operands), with loops that compilers can vectorize.
+ */
+template<typename T, std::size_t n = batch_block_size>
+struct value_block {
+    static constexpr std::size_t size = n;
+    std::array<T, n> values;
+};
+
+template<typename T, std::size_t n>
+struct is_scalar<value_block<T, n>> : std::true_type {};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct is_value_block : std::false_type {};
+    template<typename T, std::size_t n>
+    struct is_value_block<value_block<T, n>> : std::true_type {};
+    template<typename T>
+    inline constexpr bool is_value_block_v = is_value_block<std::remove_cvref_t<T>>::value;
+
+    template<typename T>
+    struct block_scalar : std::type_identity<T> {};
+    template<typename T, std::size_t n>
+    struct block_scalar<value_block<T, n>> : std::type_identity<T> {};
+
+    // operands of element-wise operations on blocks: at least one block, and otherwise (broadcast) scalars
+    template<typename... T>
+    inline constexpr bool are_block_operands_v = (... or is_value_block_v<T>)
+        and (... and (is_value_block_v<T> or std::is_arithmetic_v<std::remove_cvref_t<T>>));
+
+    template<typename... T>
+    inline constexpr std::size_t block_size_of_v = std::max({(is_value_block_v<T> ? std::remove_cvref_t<T>::size : 0)...});
+
+    template<typename T>
+    inline constexpr decltype(auto) block_entry(const T& t, std::size_t i) noexcept {
+        if constexpr (is_value_block_v<T>)
+            return t.values[i];
+        else
+            return t;
+    }
+
+    template<typename F, typename... T>
+    inline constexpr auto block_transformed(F&& f, const T&... operands) noexcept {
+        static constexpr std::size_t n = block_size_of_v<T...>;
+        static_assert((... and (!is_value_block_v<T> or std::remove_cvref_t<T>::size == n)), "Block sizes do not match.");
+        using scalar = std::common_type_t<typename block_scalar<std::remove_cvref_t<T>>::type...>;
+        value_block<scalar, n> result;
+        for (std::size_t i = 0; i < n; ++i)
+            result.values[i] = static_cast<scalar>(f(block_entry(operands, i)...));
+        return result;
+    }
+
+    // return the block of values at the given points, padding it with the first value in the tail
+    template<std::size_t n, typename V>
+    inline constexpr auto block_of(const V& values, std::size_t begin, std::size_t count) noexcept {
+        using scalar = std::remove_cvref_t<std::ranges::range_value_t<V>>;
+        value_block<scalar, n> result;
+        const auto data = std::ranges::data(values) + begin;
+        std::ranges::copy_n(data, count, result.values.begin());
+        std::ranges::fill(result.values.begin() + count, result.values.end(), data[0]);
+        return result;
+    }
+
+    template<std::size_t n, typename V>
+    inline constexpr decltype(auto) batch_value_of(const V& values, std::size_t begin, std::size_t count) noexcept {
+        if constexpr (std::ranges::contiguous_range<V>)
+            return block_of<n>(values, begin, count);
+        else
+            return (values);
+    }
+
+    template<typename E>
+    struct batch_evaluation {
+        template<typename R, typename... V>
+        static constexpr void evaluate(std::span<R> out, const bindings<V...>& values) noexcept {
+            static constexpr std::size_t n = batch_block_size;
+            assert(([&] () {
+                const auto& value = values[typename V::symbol_type{}];
+                if constexpr (std::ranges::contiguous_range<std::remove_cvref_t<decltype(value)>>)
+                    return std::ranges::size(value) >= out.size();
+                return true;
+            } () and ...) && "Arrays of values must have at least as many entries as the output.");
+
+            for (std::size_t begin = 0; begin < out.size(); begin += n) {
+                const std::size_t count = std::min(n, out.size() - begin);
+                const auto block_values = bindings{value_binder{
+                    typename V::symbol_type{},
+                    batch_value_of<n>(values[typename V::symbol_type{}], begin, count)
+                }...};
+                const auto result = traits::value_of<E>::from(block_values);
+                for (std::size_t i = 0; i < count; ++i)
+                    out[begin + i] = static_cast<R>(block_entry(result, i));
+            }
+        }
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+namespace operators::traits {
+
+template<typename A, typename B> requires(xp::detail::are_block_operands_v<A, B>)
+struct addition_of<A, B> {
+    constexpr auto operator()(const A& a, const B& b) const noexcept {
+        return xp::detail::block_transformed(std::plus<void>{}, a, b);
+    }
+};
+
+template<typename A, typename B> requires(xp::detail::are_block_operands_v<A, B>)
+struct subtraction_of<A, B> {
+    constexpr auto operator()(const A& a, const B& b) const noexcept {
+        return xp::detail::block_transformed(std::minus<void>{}, a, b);
+    }
+};
+
+template<typename A, typename B> requires(xp::detail::are_block_operands_v<A, B>)
+struct multiplication_of<A, B> {
+    constexpr auto operator()(const A& a, const B& b) const noexcept {
+        return xp::detail::block_transformed(std::multiplies<void>{}, a, b);
+    }
+};
+
+template<typename A, typename B> requires(xp::detail::are_block_operands_v<A, B>)
+struct division_of<A, B> {
+    constexpr auto operator()(const A& a, const B& b) const noexcept {
+        return xp::detail::block_transformed(std::divides<void>{}, a, b);
+    }
+};
+
+template<typename A, typename B> requires(xp::detail::are_block_operands_v<A, B>)
+struct power_of<A, B> {
+    constexpr auto operator()(const A& a, const B& b) const noexcept {
+        return xp::detail::block_transformed(operators::pow{}, a, b);
+    }
+};
+
+template<typename A> requires(xp::detail::are_block_operands_v<A>)
+struct log_of<A> {
+    constexpr auto operator()(const A& a) const noexcept {
+        return xp::detail::block_transformed(operators::log{}, a);
+    }
+};
+
+}  // namespace operators::traits
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -69,12 +69,13 @@ struct bindings : private indexed_tuple<B...> {
     struct binder_type_for<T> : std::type_identity<void> {};
     template<typename T, typename B0, typename... Bs>
     struct binder_type_for<T, B0, Bs...> {
-        static constexpr bool is_same_symbol = std::is_same_v<symbol_type_of<B0>, T>;
+        static constexpr bool is_same_symbol = traits::is_equal_node_v<symbol_type_of<B0>, T>;
         using type = std::conditional_t<is_same_symbol, B0, typename binder_type_for<T, Bs...>::type>;
     };
 
+    // use node equality such that values bound to e.g. `a + b` are also found for `b + a`
     template<typename T>
-    static constexpr bool is_bound = is_any_of_v<std::remove_cvref_t<T>, symbol_type_of<B>...>;
+    static constexpr bool is_bound = std::disjunction_v<traits::is_equal_node<std::remove_cvref_t<T>, symbol_type_of<B>>...>;
 
     template<typename T> requires(sizeof...(B) > 0 and is_bound<T>)
     using binder_type = binder_type_for<std::remove_cvref_t<T>, B...>::type;
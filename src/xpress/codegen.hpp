@@ -0,0 +1,224 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Generation of straight-line C/C++ kernels that evaluate expressions and their derivatives.
+ */
+#pragma once
+
+#include <span>
+#include <array>
+#include <string>
+#include <format>
+#include <sstream>
+#include <ostream>
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "values.hpp"
+#include "bindings.hpp"
+#include "expressions.hpp"
+#include "evaluation.hpp"
+#include "operators.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! Languages for which kernels can be generated
+enum class language {
+    c,   //!< C99 (requires `math.h` for `pow` and `log`)
+    cpp  //!< C++ (requires `cmath` for `std::pow` and `std::log`)
+};
+
+//! Options for the generation of kernels
+struct kernel_options {
+    std::string name = "kernel";         //!< name of the generated function
+    std::string scalar_type = "double";  //!< type of the input values, the temporaries and the outputs
+    std::string temporary_prefix = "t";  //!< prefix of the names of temporaries (must not clash with input names)
+    language lang = language::cpp;
+};
+
+
+namespace traits {
+
+/*!
+ * \brief Trait to write the code for an operator applied to the given operands, which are
+ *        names of inputs or temporaries, or literals. Specialize this for custom operators.
+ */
+template<typename op>
+struct code_of;
+
+template<>
+struct code_of<operators::add> {
+    static void to(std::ostream& out, std::span<const std::string> operands, const language&) {
+        for (std::size_t i = 0; i < operands.size(); ++i)
+            out << (i > 0 ? " + " : "") << operands[i];
+    }
+};
+
+template<>
+struct code_of<operators::subtract> {
+    static void to(std::ostream& out, std::span<const std::string> operands, const language&) {
+        out << operands[0] << " - " << operands[1];
+    }
+};
+
+template<>
+struct code_of<operators::multiply> {
+    static void to(std::ostream& out, std::span<const std::string> operands, const language&) {
+        for (std::size_t i = 0; i < operands.size(); ++i)
+            out << (i > 0 ? "*" : "") << operands[i];
+    }
+};
+
+template<>
+struct code_of<operators::divide> {
+    static void to(std::ostream& out, std::span<const std::string> operands, const language&) {
+        out << operands[0] << "/" << operands[1];
+    }
+};
+
+template<>
+struct code_of<operators::pow> {
+    static void to(std::ostream& out, std::span<const std::string> operands, const language& lang) {
+        out << (lang == language::cpp ? "std::pow(" : "pow(") << operands[0] << ", " << operands[1] << ")";
+    }
+};
+
+template<>
+struct code_of<operators::log> {
+    static void to(std::ostream& out, std::span<const std::string> operands, const language& lang) {
+        out << (lang == language::cpp ? "std::log(" : "log(") << operands[0] << ")";
+    }
+};
+
+}  // namespace traits
+
+
+#ifndef DOXYGEN
+namespace detail::codegen {
+
+    template<typename T>
+    struct is_value_node : std::false_type {};
+    template<auto v>
+    struct is_value_node<value<v>> : std::true_type {};
+
+    // write constants as floating-point literals, such that no integer arithmetic occurs in the kernel
+    template<auto v>
+    inline std::string literal_of(const value<v>&) {
+        std::string result = std::format("{}", v);
+        if (result.find_first_of(".eEin") == std::string::npos)
+            result += ".0";
+        return v < 0 ? "(" + result + ")" : result;
+    }
+
+    // name of an input, literal, or name of the temporary that holds the value of the given node
+    template<typename T, typename nodes, typename... V>
+    inline std::string reference_to(const T&, const bindings<V...>& names, const kernel_options& opts) {
+        if constexpr (bindings<V...>::template has_bindings_for<T>) {
+            std::ostringstream s;
+            s << names[T{}];
+            return std::move(s).str();
+        } else if constexpr (is_value_node<T>::value) {
+            return literal_of(T{});
+        } else {
+            static_assert(
+                xp::detail::index_of_equal_node<T, nodes>::value < nodes::size,
+                "Leaves of kernel expressions must be constants, or symbols that are bound to names."
+            );
+            return opts.temporary_prefix + std::to_string(xp::detail::index_of_equal_node<T, nodes>::value);
+        }
+    }
+
+    template<typename nodes, typename op, typename... Ts, typename... V>
+    inline void write_statement(std::ostream& out,
+                                const operation<op, Ts...>&,
+                                const bindings<V...>& names,
+                                const kernel_options& opts) {
+        static_assert(
+            is_complete_v<traits::code_of<op>>,
+            "Code generation is not supported for this operator. Please specialize traits::code_of."
+        );
+        const std::array<std::string, sizeof...(Ts)> operands{reference_to<Ts, nodes>(Ts{}, names, opts)...};
+        traits::code_of<op>::to(out, operands, opts.lang);
+    }
+
+    template<typename... E, typename... V>
+    inline void write_kernel(std::ostream& out,
+                             const type_list<E...>&,
+                             const bindings<V...>& names,
+                             const kernel_options& opts) {
+        using nodes = traits::evaluation_nodes_of_t<bindings<V...>, E...>;
+        const bool is_cpp = opts.lang == language::cpp;
+
+        out << "void " << opts.name << "(";
+        (..., (out << "const " << opts.scalar_type << " " << names[typename V::symbol_type{}] << ", "));
+        out << opts.scalar_type << (is_cpp ? "* out) noexcept {\n" : "* restrict out) {\n");
+
+        [&] <typename... N> (const type_list<N...>&) {
+            std::size_t i = 0;
+            (..., [&] () {
+                out << "    const " << opts.scalar_type << " " << opts.temporary_prefix << i++ << " = ";
+                write_statement<nodes>(out, N{}, names, opts);
+                out << ";\n";
+            } ());
+        } (nodes{});
+
+        std::size_t i = 0;
+        (..., (out << "    out[" << i++ << "] = " << reference_to<E, nodes>(E{}, names, opts) << ";\n"));
+        out << "}\n";
+    }
+
+}  // namespace detail::codegen
+#endif  // DOXYGEN
+
+/*!
+ * \brief Write a function with straight-line code that evaluates the given expression, taking the values
+ *        of the symbols bound in `names` as arguments (in the order of the bindings) and writing the result
+ *        to `out[0]`. Each unique sub-expression is evaluated once into a named temporary:
+ *        \code{.cpp}
+ *            write_kernel_to(std::cout, a*b + log(a*b), with(a = "a", b = "b"));
+ *            // void kernel(const double a, const double b, double* out) noexcept {
+ *            //     const double t0 = a*b;
+ *            //     const double t1 = std::log(t0);
+ *            //     const double t2 = t0 + t1;
+ *            //     out[0] = t2;
+ *            // }
+ *        \endcode
+ *        Compiling such kernels once avoids instantiating the expression templates in each translation unit.
+ * \note Symbols and sub-expressions bound to names become inputs of the kernel. Kernels can be generated
+ *       for scalar expressions composed of operators for which `traits::code_of` is specialized.
+ */
+template<expression E, typename... V>
+inline void write_kernel_to(std::ostream& out, const E&, const bindings<V...>& names, const kernel_options& opts = {}) {
+    detail::codegen::write_kernel(out, type_list<E>{}, names, opts);
+}
+
+/*!
+ * \brief Write a kernel (see above) that evaluates the given expression and its derivatives w.r.t. the given variables,
+ *        writing the value to `out[0]` and the derivatives to `out[1], out[2], ...`. Temporaries are shared between
+ *        the value and all derivatives (see `value_and_derivatives_of`).
+ */
+template<expression E, typename... X, typename... V>
+inline void write_kernel_to(std::ostream& out,
+                            const E&,
+                            const type_list<X...>&,
+                            const bindings<V...>& names,
+                            const kernel_options& opts = {}) {
+    detail::codegen::write_kernel(
+        out,
+        type_list<E, std::remove_cvref_t<decltype(xp::derivative_of(E{}, type_list<X>{}))>...>{},
+        names,
+        opts
+    );
+}
+
+//! \} group Expressions
+
+}  // namespace xp
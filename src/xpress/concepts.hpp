@@ -9,7 +9,7 @@
 
 #include <type_traits>
 #include <concepts>
-#include <ostream>
+#include <iosfwd>
 
 #include "bindings.hpp"
 #include "traits.hpp"
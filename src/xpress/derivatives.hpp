@@ -45,6 +45,10 @@ namespace detail {
     template<typename E, typename V>
     struct is_derivative<derivative<E, V>> : std::true_type {};
 
+    // defined in evaluation.hpp
+    template<typename... D, typename... V>
+    inline constexpr auto derivative_values_of(const type_list<D...>&, const bindings<V...>& values) noexcept;
+
 }  // namespace detail
 #endif  // DOXYGEN
 
@@ -73,10 +77,14 @@ struct derivatives : private indexed<typename D::variable...> {
         return at(bindings{std::forward<V>(values)...});
     }
 
-    //! Evaluate the derivatives at the given value bindings
+    /*!
+     * \brief Evaluate the derivatives at the given value bindings. All derivative expressions are evaluated
+     *        jointly, such that the sub-expressions they share (e.g. the primal ones) are evaluated only once.
+     */
     template<typename... V>
+        requires(evaluatable_with<typename D::expression, V...> and ...)
     constexpr auto at(const bindings<V...>& values) const noexcept {
-        return bindings{_binder_for(D{}, values)...};
+        return detail::derivative_values_of(type_list<D...>{}, values);
     }
 
     //! Iterate over all derivative expressions
@@ -87,13 +95,6 @@ struct derivatives : private indexed<typename D::variable...> {
         >, "visitor must have the signature visitor(const auto& variable, const auto& expression)");
         (..., visitor(typename D::variable{}, D{}.get()));
     }
-
- private:
-    template<typename E, typename V, typename... Vs>
-        requires(evaluatable_with<E, Vs...>)
-    constexpr auto _binder_for(const derivative<E, V>&, const bindings<Vs...>& values) const noexcept {
-        return value_binder{V{}, traits::value_of<E>::from(values)};
-    }
 };
 
 template<typename... D>
@@ -42,6 +42,10 @@ template<tensorial Arg>
 struct is_bindable<dtype::real, Arg> : is_bindable<dtype::real, scalar_type_t<Arg>> {};
 template<tensorial Arg>
 struct is_bindable<dtype::integral, Arg> : is_bindable<dtype::integral, scalar_type_t<Arg>> {};
+template<typename Arg> requires(is_runtime_sized_v<Arg>)
+struct is_bindable<dtype::real, Arg> : is_bindable<dtype::real, scalar_type_t<std::remove_cvref_t<Arg>>> {};
+template<typename Arg> requires(is_runtime_sized_v<Arg>)
+struct is_bindable<dtype::integral, Arg> : is_bindable<dtype::integral, scalar_type_t<std::remove_cvref_t<Arg>>> {};
 
 #ifndef DOXYGEN
 namespace detail {
@@ -0,0 +1,305 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Forward-mode evaluation of derivatives with dual numbers.
+ */
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+#include "math.hpp"
+#include "utils.hpp"
+#include "dtype.hpp"
+#include "traits.hpp"
+#include "type_traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "evaluation.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! Tag to select forward-mode evaluation of derivatives with dual numbers
+struct forward_dual_t {};
+inline constexpr forward_dual_t forward_dual{};
+
+/*!
+ * \brief A dual number, i.e. a value together with its derivatives (tangents) in n directions. Arithmetic on duals
+ *        propagates the tangents of all directions at once (in loops that compilers can vectorize), such that evaluating
+ *        an expression with duals bound to its symbols yields its value and its directional derivatives in one pass.
+ *        \code{.cpp}
+ *            var a;
+ *            var b;
+ *            const auto result = value_of(a*b, at(a = dual<double>{2.0, {1.0}}, b = 3.0));  // {6.0, {3.0}}
+ *        \endcode
+ */
+template<typename T, std::size_t n = 1>
+struct dual {
+    using value_type = T;
+    static constexpr std::size_t directions = n;
+
+    T value{};
+    std::array<T, n> tangents{};
+
+    //! Return a dual with the given value, seeded with the unit tangent of the i-th direction
+    template<std::size_t i> requires(i < n)
+    static constexpr dual seeded(T v) noexcept {
+        dual result{v};
+        result.tangents[i] = T{1};
+        return result;
+    }
+
+    friend constexpr bool operator==(const dual&, const dual&) = default;
+
+    friend constexpr dual operator-(const dual& a) noexcept {
+        return _transformed(-a.value, a, [] (const T& t) constexpr { return -t; });
+    }
+
+    friend constexpr dual operator+(const dual& a, const dual& b) noexcept {
+        return _transformed(a.value + b.value, a, b, [] (const T& ta, const T& tb) constexpr { return ta + tb; });
+    }
+
+    friend constexpr dual operator-(const dual& a, const dual& b) noexcept {
+        return _transformed(a.value - b.value, a, b, [] (const T& ta, const T& tb) constexpr { return ta - tb; });
+    }
+
+    friend constexpr dual operator*(const dual& a, const dual& b) noexcept {
+        return _transformed(a.value*b.value, a, b, [&] (const T& ta, const T& tb) constexpr {
+            return ta*b.value + a.value*tb;
+        });
+    }
+
+    friend constexpr dual operator/(const dual& a, const dual& b) noexcept {
+        const T quotient = a.value/b.value;
+        return _transformed(quotient, a, b, [&] (const T& ta, const T& tb) constexpr {
+            return (ta - quotient*tb)/b.value;
+        });
+    }
+
+    // arithmetic with (constant) scalars, which have vanishing tangents
+
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator+(const dual& a, const S& s) noexcept { return _shifted(a, a.value + static_cast<T>(s)); }
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator+(const S& s, const dual& a) noexcept { return _shifted(a, static_cast<T>(s) + a.value); }
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator-(const dual& a, const S& s) noexcept { return _shifted(a, a.value - static_cast<T>(s)); }
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator-(const S& s, const dual& a) noexcept { return static_cast<T>(s) + (-a); }
+
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator*(const dual& a, const S& s) noexcept {
+        const T factor = static_cast<T>(s);
+        return _transformed(a.value*factor, a, [&] (const T& t) constexpr { return t*factor; });
+    }
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator*(const S& s, const dual& a) noexcept { return a*s; }
+
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator/(const dual& a, const S& s) noexcept {
+        const T divisor = static_cast<T>(s);
+        return _transformed(a.value/divisor, a, [&] (const T& t) constexpr { return t/divisor; });
+    }
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual operator/(const S& s, const dual& a) noexcept {
+        const T quotient = static_cast<T>(s)/a.value;
+        return _transformed(quotient, a, [&] (const T& t) constexpr { return -quotient*t/a.value; });
+    }
+
+    // elementary functions (found via argument-dependent lookup by the default operators, see e.g. `math::log`)
+
+    friend constexpr dual log(const dual& a) noexcept {
+        return _transformed(math::log(a.value), a, [&] (const T& t) constexpr { return t/a.value; });
+    }
+
+    friend constexpr dual sqrt(const dual& a) noexcept {
+        const T root = math::sqrt(a.value);
+        return _transformed(root, a, [&] (const T& t) constexpr { return t/(T{2}*root); });
+    }
+
+    // the partial derivatives of pow are only evaluated for operands with non-zero tangents, since
+    // e.g. the one w.r.t. the exponent is not finite for non-positive bases (while its tangent may be zero)
+    friend constexpr dual pow(const dual& a, const dual& b) noexcept {
+        const T power = math::pow(a.value, b.value);
+        const T d_base = _has_tangents(a) ? math::pow_base_derivative(a.value, b.value) : T{0};
+        const T d_exponent = _has_tangents(b) ? power*math::log(a.value) : T{0};
+        return _transformed(power, a, b, [&] (const T& ta, const T& tb) constexpr {
+            return (ta == T{0} ? T{0} : d_base*ta) + (tb == T{0} ? T{0} : d_exponent*tb);
+        });
+    }
+
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual pow(const dual& a, const S& s) noexcept {
+        const T exponent = static_cast<T>(s);
+        const T d_base = math::pow_base_derivative(a.value, exponent);
+        return _transformed(static_cast<T>(math::pow(a.value, exponent)), a, [&] (const T& t) constexpr {
+            return t == T{0} ? T{0} : d_base*t;
+        });
+    }
+
+    template<typename S> requires(std::is_arithmetic_v<S>)
+    friend constexpr dual pow(const S& s, const dual& b) noexcept {
+        const T base = static_cast<T>(s);
+        const T power = math::pow(base, b.value);
+        const T d_exponent = _has_tangents(b) ? power*math::log(base) : T{0};
+        return _transformed(power, b, [&] (const T& t) constexpr { return t == T{0} ? T{0} : d_exponent*t; });
+    }
+
+ private:
+    template<typename F>
+    static constexpr dual _transformed(T v, const dual& a, F&& f) noexcept {
+        dual result{v};
+        for (std::size_t i = 0; i < n; ++i)
+            result.tangents[i] = f(a.tangents[i]);
+        return result;
+    }
+
+    template<typename F>
+    static constexpr dual _transformed(T v, const dual& a, const dual& b, F&& f) noexcept {
+        dual result{v};
+        for (std::size_t i = 0; i < n; ++i)
+            result.tangents[i] = f(a.tangents[i], b.tangents[i]);
+        return result;
+    }
+
+    static constexpr dual _shifted(const dual& a, T v) noexcept {
+        return dual{v, a.tangents};
+    }
+
+    static constexpr bool _has_tangents(const dual& a) noexcept {
+        return std::ranges::any_of(a.tangents, [] (const T& t) constexpr { return t != T{0}; });
+    }
+};
+
+template<typename T, std::size_t n>
+struct is_scalar<dual<T, n>> : std::true_type {};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct is_dual : std::false_type {};
+    template<typename T, std::size_t n>
+    struct is_dual<dual<T, n>> : std::true_type {};
+    template<typename T>
+    inline constexpr bool is_dual_v = is_dual<std::remove_cvref_t<T>>::value;
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename Arg> requires(detail::is_dual_v<Arg>)
+struct is_bindable<dtype::real, Arg> : is_bindable<dtype::real, typename std::remove_cvref_t<Arg>::value_type> {};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename B>
+    struct is_unbound_in {
+        template<typename T>
+        struct predicate : std::bool_constant<!B::template has_bindings_for<T>> {};
+    };
+
+    // value of the given node to be seeded with the tangent of one direction
+    template<typename X, typename... V>
+    inline constexpr decltype(auto) seed_value_of(const X&, const bindings<V...>& values) noexcept {
+        if constexpr (bindings<V...>::template has_bindings_for<X>)
+            return values[X{}];
+        else
+            return xp::value_of(X{}, values);
+    }
+
+    template<typename X, typename... V>
+    using seed_value_t = std::remove_cvref_t<decltype(seed_value_of(X{}, std::declval<const bindings<V...>&>()))>;
+
+    // bind duals seeded with the directions of the variables X, and leave the other values as they are
+    template<typename D, typename... X, typename... V>
+    inline constexpr auto seeded_bindings_of(const type_list<X...>& vars, const bindings<V...>& values) noexcept {
+        const auto binder_for = [&] <typename S> (const S&) constexpr {
+            constexpr std::size_t i = index_of_equal_node<S, type_list<X...>>::value;
+            if constexpr (i < sizeof...(X))
+                return value_binder{S{}, D::template seeded<i>(static_cast<typename D::value_type>(values[S{}]))};
+            else
+                return value_binder{S{}, values[S{}]};
+        };
+        return [&] <typename... U> (const type_list<U...>&) constexpr {
+            return bindings{
+                binder_for(typename V::symbol_type{})...,
+                value_binder{U{}, D::template seeded<index_of_equal_node<U, type_list<X...>>::value>(
+                    static_cast<typename D::value_type>(xp::value_of(U{}, values))
+                )}...
+            };
+        } (filtered_list_t<is_unbound_in<bindings<V...>>::template predicate, type_list<X...>>{});
+    }
+
+    template<typename D, typename R, typename... X>
+    inline constexpr auto tangents_of(const R& result, const type_list<X...>&) noexcept {
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
+            if constexpr (is_dual_v<R>)
+                return bindings{value_binder{X{}, result.tangents[i]}...};
+            else  // the expression does not depend on the variables
+                return bindings{value_binder{X{}, typename D::value_type{0}}...};
+        } (std::index_sequence_for<X...>{});
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Evaluate the given scalar expression and its derivatives w.r.t. the given variables in forward mode. Duals
+ *        seeded with one direction per variable are bound to the variables, and the original expression is evaluated
+ *        once (computing each unique node only once), propagating the derivatives in all directions along. No derivative
+ *        expressions are instantiated, which keeps compile times low for large expressions with few variables.
+ *        Returns a pair of the value and the bindings of the derivative values to the variables.
+ * \note Values bound to sub-expressions are treated as constants, and sub-expressions may be used as variables.
+ */
+template<expression E, typename... X, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_and_derivatives_of(const E&, const type_list<X...>& vars, const bindings<V...>& values, const forward_dual_t&) noexcept {
+    using scalar = std::common_type_t<detail::seed_value_t<X, V...>...>;
+    static_assert(is_scalar_v<scalar>, "Forward-mode differentiation is only supported w.r.t. scalars.");
+    using dual_type = dual<scalar, sizeof...(X)>;
+
+    const auto result = xp::value_of(E{}, detail::seeded_bindings_of<dual_type>(vars, values), cse);
+    using result_type = std::remove_cvref_t<decltype(result)>;
+    static_assert(is_scalar_v<result_type>, "Forward-mode differentiation is only supported for scalar expressions.");
+    if constexpr (detail::is_dual_v<result_type>)
+        return std::pair{result.value, detail::tangents_of<dual_type>(result, vars)};
+    else
+        return std::pair{result, detail::tangents_of<dual_type>(result, vars)};
+}
+
+//! Evaluate the given scalar expression and its gradient in forward mode (see `value_and_derivatives_of`)
+template<expression E, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_and_gradient_of(const E& expr, const bindings<V...>& values, const forward_dual_t& mode) noexcept {
+    return value_and_derivatives_of(expr, traits::variables_of_t<E>{}, values, mode);
+}
+
+//! Return the derivatives of the given scalar expression w.r.t the given variables, computed in forward mode with dual numbers
+template<expression E, typename... X, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto derivatives_of(const E& expr, const type_list<X...>& vars, const bindings<V...>& values, const forward_dual_t& mode) noexcept {
+    return value_and_derivatives_of(expr, vars, values, mode).second;
+}
+
+//! Return the gradient of the given scalar expression evaluated at the given values in forward mode
+template<expression E, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto gradient_of(const E& expr, const bindings<V...>& values, const forward_dual_t& mode) noexcept {
+    return derivatives_of(expr, traits::variables_of_t<E>{}, values, mode);
+}
+
+//! \} group Expressions
+
+}  // namespace xp
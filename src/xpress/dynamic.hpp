@@ -0,0 +1,249 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup LinearAlgebra
+ * \brief Tensors with extents known only at runtime, and the operators acting on them.
+ */
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <memory_resource>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifndef XP_NO_IOSTREAM
+#include <ostream>
+#endif
+
+#include "type_traits.hpp"
+#include "operators.hpp"
+
+
+namespace xp {
+
+namespace linalg {
+
+//! \addtogroup LinearAlgebra
+//! \{
+
+/*!
+ * \brief Tensor of a fixed rank, but with extents given at runtime, which stores its values contiguously (row-major).
+ *        This allows binding e.g. the values at all nodes of a mesh to a symbol and evaluating expressions over them.
+ *        The values are allocated from the given memory resource (the default resource if none is given), and the
+ *        results of operators are allocated from the resource of their first operand. Thus, passing an arena such
+ *        as `std::pmr::unsynchronized_pool_resource` lets repeated evaluations reuse the memory of previous ones
+ *        instead of going to the global heap.
+ */
+template<typename T, std::size_t rank = 1>
+    requires(is_scalar_v<T> and rank > 0)
+class dynamic_tensor {
+ public:
+    using value_type = T;
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using extents_type = std::array<std::size_t, rank>;
+
+    explicit dynamic_tensor(const extents_type& extents, T value = T{0}, allocator_type allocator = {})
+    : _extents{extents}
+    , _values(_count_of(extents), value, allocator)
+    {}
+
+    //! Construct from the given values (for rank 1), e.g. a `std::vector` of nodal values
+    template<std::ranges::input_range R>
+        requires(rank == 1
+                 and !std::same_as<std::remove_cvref_t<R>, dynamic_tensor>
+                 and std::convertible_to<std::ranges::range_value_t<R>, T>)
+    explicit dynamic_tensor(const R& values, allocator_type allocator = {})
+    : _values(std::ranges::begin(values), std::ranges::end(values), allocator) {
+        _extents[0] = _values.size();
+    }
+
+    const extents_type& extents() const noexcept { return _extents; }
+    std::size_t extent(std::size_t dim) const noexcept { return _extents[dim]; }
+    std::size_t size() const noexcept { return _values.size(); }
+    allocator_type get_allocator() const noexcept { return _values.get_allocator(); }
+
+    T* data() noexcept { return _values.data(); }
+    const T* data() const noexcept { return _values.data(); }
+
+    auto begin() noexcept { return _values.begin(); }
+    auto begin() const noexcept { return _values.begin(); }
+    auto end() noexcept { return _values.end(); }
+    auto end() const noexcept { return _values.end(); }
+
+    template<typename S, std::convertible_to<std::size_t>... I> requires(sizeof...(I) == rank)
+    decltype(auto) operator[](this S&& self, const I&... indices) noexcept {
+        return std::forward<S>(self)._values[self._flat_index(static_cast<std::size_t>(indices)...)];
+    }
+
+    template<typename _T>
+    bool operator==(const dynamic_tensor<_T, rank>& other) const noexcept {
+        return _extents == other.extents() and std::ranges::equal(_values, other);
+    }
+
+#ifndef XP_NO_IOSTREAM
+    friend std::ostream& operator<<(std::ostream& s, const dynamic_tensor& t) {
+        s << "[";
+        for (std::size_t i = 0; i < t.size(); ++i)
+            s << (i > 0 ? ", " : "") << t._values[i];
+        s << "]";
+        return s;
+    }
+#endif
+
+ private:
+    static constexpr std::size_t _count_of(const extents_type& extents) noexcept {
+        std::size_t result = 1;
+        for (std::size_t e : extents)
+            result *= e;
+        return result;
+    }
+
+    template<typename... I>
+    std::size_t _flat_index(const I&... indices) const noexcept {
+        std::size_t result = 0;
+        std::size_t dim = 0;
+        (..., (assert(indices < _extents[dim]), result = result*_extents[dim++] + indices));
+        return result;
+    }
+
+    extents_type _extents{};
+    std::pmr::vector<T> _values;
+};
+
+template<std::ranges::input_range R>
+dynamic_tensor(const R&) -> dynamic_tensor<std::remove_cvref_t<std::ranges::range_value_t<R>>, 1>;
+template<std::ranges::input_range R>
+dynamic_tensor(const R&, std::pmr::polymorphic_allocator<std::ranges::range_value_t<R>>)
+    -> dynamic_tensor<std::remove_cvref_t<std::ranges::range_value_t<R>>, 1>;
+
+//! Trait to detect linalg::dynamic_tensor types
+template<typename T>
+struct is_dynamic_tensor : std::false_type {};
+template<typename T, std::size_t rank>
+struct is_dynamic_tensor<dynamic_tensor<T, rank>> : std::true_type {};
+template<typename T>
+inline constexpr bool is_dynamic_tensor_v = is_dynamic_tensor<std::remove_cvref_t<T>>::value;
+
+/*!
+ * \brief Apply the given function element-wise to the values of dynamic tensors with equal extents.
+ *        The result is allocated from the memory resource of the first tensor.
+ */
+template<typename F, typename T, std::size_t rank, typename... Ts>
+    requires(std::conjunction_v<is_dynamic_tensor<Ts>...>)
+inline auto transformed(F&& f, const dynamic_tensor<T, rank>& t, const Ts&... ts) {
+    assert((... and (ts.extents() == t.extents())) && "Tensor extents do not match.");
+    using R = std::remove_cvref_t<std::invoke_result_t<F&, const T&, const scalar_type_t<Ts>&...>>;
+    dynamic_tensor<R, rank> result{t.extents(), R{0}, t.get_allocator()};
+    R* out = result.data();
+    const T* in = t.data();
+    [&] (const auto*... ins) {
+        for (std::size_t i = 0; i < t.size(); ++i)
+            out[i] = f(in[i], ins[i]...);
+    } (ts.data()...);
+    return result;
+}
+
+//! Return the scalar product of two dynamic tensors with equal extents (see the overload for dense tensors)
+template<typename T1, typename T2, std::size_t rank>
+inline auto dot(const dynamic_tensor<T1, rank>& a, const dynamic_tensor<T2, rank>& b) noexcept {
+    assert(a.extents() == b.extents() && "Tensor extents do not match.");
+    using R = std::common_type_t<T1, T2>;
+    constexpr std::size_t lanes = 4;
+    const std::size_t count = a.size();
+    const T1* x = a.data();
+    const T2* y = b.data();
+
+    std::array<R, lanes> partial_sums{};
+    std::size_t i = 0;
+    for (; i + lanes <= count; i += lanes)
+        for (std::size_t l = 0; l < lanes; ++l)
+            partial_sums[l] += x[i + l]*y[i + l];
+    R result{0};
+    for (; i < count; ++i)
+        result += x[i]*y[i];
+    for (std::size_t l = 0; l < lanes; ++l)
+        result += partial_sums[l];
+    return result;
+}
+
+//! \} group LinearAlgebra
+
+}  // namespace linalg
+
+template<typename T, std::size_t rank>
+struct scalar_type<linalg::dynamic_tensor<T, rank>> : std::type_identity<T> {};
+
+template<typename T, std::size_t rank>
+struct is_runtime_sized<linalg::dynamic_tensor<T, rank>> : std::true_type {};
+
+
+namespace operators::traits {
+
+template<typename T1, typename T2, std::size_t rank>
+struct addition_of<linalg::dynamic_tensor<T1, rank>, linalg::dynamic_tensor<T2, rank>> {
+    auto operator()(const linalg::dynamic_tensor<T1, rank>& a, const linalg::dynamic_tensor<T2, rank>& b) const {
+        using scalar = std::common_type_t<T1, T2>;
+        return linalg::transformed([] (const T1& x, const T2& y) { return static_cast<scalar>(x + y); }, a, b);
+    }
+};
+
+template<typename T1, typename T2, std::size_t rank>
+struct subtraction_of<linalg::dynamic_tensor<T1, rank>, linalg::dynamic_tensor<T2, rank>> {
+    auto operator()(const linalg::dynamic_tensor<T1, rank>& a, const linalg::dynamic_tensor<T2, rank>& b) const {
+        using scalar = std::common_type_t<T1, T2>;
+        return linalg::transformed([] (const T1& x, const T2& y) { return static_cast<scalar>(x - y); }, a, b);
+    }
+};
+
+template<typename T, std::size_t rank, typename S> requires(is_scalar_v<S>)
+struct multiplication_of<linalg::dynamic_tensor<T, rank>, S> {
+    auto operator()(const linalg::dynamic_tensor<T, rank>& t, const S& s) const {
+        return linalg::transformed([&] (const T& x) { return static_cast<T>(x*s); }, t);
+    }
+};
+
+template<typename S, typename T, std::size_t rank> requires(is_scalar_v<S>)
+struct multiplication_of<S, linalg::dynamic_tensor<T, rank>> {
+    auto operator()(const S& s, const linalg::dynamic_tensor<T, rank>& t) const {
+        return multiplication_of<linalg::dynamic_tensor<T, rank>, S>{}(t, s);
+    }
+};
+
+//! Products of dynamic tensors are scalar products (as for tensors with compile-time shapes)
+template<typename T1, typename T2, std::size_t rank>
+struct multiplication_of<linalg::dynamic_tensor<T1, rank>, linalg::dynamic_tensor<T2, rank>> {
+    auto operator()(const linalg::dynamic_tensor<T1, rank>& a, const linalg::dynamic_tensor<T2, rank>& b) const noexcept {
+        return linalg::dot(a, b);
+    }
+};
+
+template<typename T, std::size_t rank, typename S> requires(is_scalar_v<S>)
+struct division_of<linalg::dynamic_tensor<T, rank>, S> {
+    auto operator()(const linalg::dynamic_tensor<T, rank>& t, const S& s) const {
+        return linalg::transformed([&] (const T& x) { return static_cast<T>(x/s); }, t);
+    }
+};
+
+template<typename T, std::size_t rank, typename E> requires(is_scalar_v<E>)
+struct power_of<linalg::dynamic_tensor<T, rank>, E> {
+    auto operator()(const linalg::dynamic_tensor<T, rank>& t, const E& e) const {
+        return linalg::transformed([&] (const T& x) { return static_cast<T>(operators::pow{}(x, e)); }, t);
+    }
+};
+
+template<typename T, std::size_t rank>
+struct log_of<linalg::dynamic_tensor<T, rank>> {
+    auto operator()(const linalg::dynamic_tensor<T, rank>& t) const {
+        return linalg::transformed([] (const T& x) { return static_cast<T>(operators::log{}(x)); }, t);
+    }
+};
+
+}  // namespace operators::traits
+
+}  // namespace xp
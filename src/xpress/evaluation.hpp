@@ -0,0 +1,197 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Evaluation of expressions on the graph of their unique nodes.
+ */
+#pragma once
+
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "operators/common.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! Tag to select evaluation with common-subexpression elimination
+struct cse_t {};
+inline constexpr cse_t cse{};
+
+
+namespace traits {
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T, typename list>
+    struct contains_equal_node;
+    template<typename T, typename... Ts>
+    struct contains_equal_node<T, type_list<Ts...>> : std::disjunction<traits::is_equal_node<T, Ts>...> {};
+
+    template<typename B, typename visited, typename children>
+    struct visit_nodes;
+
+    template<typename B, typename visited, typename T, bool is_terminal>
+    struct visit_node_impl : std::type_identity<visited> {};
+    template<typename B, typename visited, typename T>
+    struct visit_node_impl<B, visited, T, false> {
+        using type = concatenated_t<typename visit_nodes<B, visited, children_of_t<T>>::type, type_list<T>>;
+    };
+
+    template<typename B, typename visited, typename T>
+    struct visit_node : visit_node_impl<B, visited, T,
+        children_of_t<T>::size == 0
+        or B::template has_bindings_for<T>
+        or contains_equal_node<T, visited>::value
+    > {};
+
+    template<typename B, typename visited>
+    struct visit_nodes<B, visited, type_list<>> : std::type_identity<visited> {};
+    template<typename B, typename visited, typename T, typename... Ts>
+    struct visit_nodes<B, visited, type_list<T, Ts...>>
+    : visit_nodes<B, typename visit_node<B, visited, T>::type, type_list<Ts...>> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Trait to get the unique composite nodes of the given expressions in evaluation order,
+ *        that is, such that all child nodes precede their parents. Nodes for which the bindings
+ *        of type B provide a value are omitted together with their subtrees.
+ */
+template<typename B, typename... E>
+struct evaluation_nodes_of : detail::visit_nodes<B, type_list<>, type_list<E...>> {};
+template<typename B, typename... E>
+using evaluation_nodes_of_t = typename evaluation_nodes_of<B, E...>::type;
+
+}  // namespace traits
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // index of the first node in the list that is equal to T (the size of the list if there is none)
+    template<typename T, typename list, std::size_t i = 0>
+    struct index_of_equal_node;
+    template<typename T, std::size_t i>
+    struct index_of_equal_node<T, type_list<>, i> : std::integral_constant<std::size_t, i> {};
+    template<typename T, typename N0, typename... N, std::size_t i>
+    struct index_of_equal_node<T, type_list<N0, N...>, i>
+    : std::conditional_t<
+        traits::is_equal_node_v<T, N0>,
+        std::integral_constant<std::size_t, i>,
+        index_of_equal_node<T, type_list<N...>, i+1>
+    > {};
+
+    template<typename N, typename B>
+    using node_value_t = std::remove_cvref_t<decltype(traits::value_of<N>::from(std::declval<const B&>()))>;
+
+    // evaluate a node from bindings that contain the values of its children
+    template<typename N, typename... V>
+    inline constexpr decltype(auto) value_from_children(const N&, const bindings<V...>& values) noexcept {
+        return traits::value_of<N>::from(values);
+    }
+
+    // operations themselves look up bindings for them, so we have to bypass this here
+    template<typename op, typename... Ts, typename... V>
+    inline constexpr auto value_from_children(const operation<op, Ts...>&, const bindings<V...>& values) noexcept {
+        return traits::value_from_operands<operation<op, Ts...>>::from(xp::value_of(Ts{}, values)...);
+    }
+
+    // value of a node from bindings that potentially contain its value already
+    template<typename N, typename... V>
+    inline constexpr auto cached_value_of(const N&, const bindings<V...>& values) noexcept {
+        if constexpr (bindings<V...>::template has_bindings_for<N>)
+            return values[N{}];
+        else
+            return traits::value_of<N>::from(values);
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Evaluate the given nodes (e.g. obtained from `traits::evaluation_nodes_of_t`) once and invoke
+ *        the visitor with bindings that contain the given values plus the values of all nodes.
+ * \note The node values are stored in a local scratch tuple that is laid out at compile-time, and the
+ *       bindings passed to the visitor refer to it. Thus, they must not be used beyond the visitor call.
+ */
+template<typename... N, typename... V, typename visitor>
+inline constexpr decltype(auto) with_values_of(const type_list<N...>&, const bindings<V...>& values, visitor&& v) noexcept {
+    std::tuple<detail::node_value_t<N, bindings<V...>>...> scratch{};
+    return [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr -> decltype(auto) {
+        const auto node_values = bindings{
+            value_binder{typename V::symbol_type{}, values[typename V::symbol_type{}]}...,
+            value_binder{N{}, std::as_const(std::get<i>(scratch))}...
+        };
+        (..., (std::get<i>(scratch) = detail::value_from_children(N{}, node_values)));
+        return std::forward<visitor>(v)(node_values);
+    } (std::index_sequence_for<N...>{});
+}
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // evaluate the expressions of the given derivatives jointly, computing the nodes they share only once
+    template<typename... D, typename... V>
+    inline constexpr auto derivative_values_of(const type_list<D...>&, const bindings<V...>& values) noexcept {
+        using nodes = traits::evaluation_nodes_of_t<bindings<V...>, typename D::expression...>;
+        return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+            return bindings{value_binder{typename D::variable{}, cached_value_of(typename D::expression{}, node_values)}...};
+        });
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! Evaluate the given expression from the given value bindings, computing each unique node only once
+template<expression E, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_of(const E&, const bindings<V...>& values, const cse_t&) noexcept {
+    using nodes = traits::evaluation_nodes_of_t<bindings<V...>, E>;
+    return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+        return detail::cached_value_of(E{}, node_values);
+    });
+}
+
+/*!
+ * \brief Evaluate the given expression and its derivatives w.r.t. the given variables in one pass.
+ *        The nodes of the expression and of all derivative expressions are evaluated only once, such that
+ *        the derivatives reuse the values of the primal sub-expressions. Returns a pair of the value and
+ *        the bindings of the derivative values to the variables (as returned by `derivatives_of`).
+ */
+template<expression E, typename... X, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_and_derivatives_of(const E&, const type_list<X...>&, const bindings<V...>& values) noexcept {
+    using nodes = traits::evaluation_nodes_of_t<
+        bindings<V...>, E, std::remove_cvref_t<decltype(xp::derivative_of(E{}, type_list<X>{}))>...
+    >;
+    return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+        return std::pair{
+            detail::cached_value_of(E{}, node_values),
+            bindings{value_binder{X{}, detail::cached_value_of(xp::derivative_of(E{}, type_list<X>{}), node_values)}...}
+        };
+    });
+}
+
+//! Evaluate the given expression and its gradient in one pass (see `value_and_derivatives_of`)
+template<expression E, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_and_gradient_of(const E& expr, const bindings<V...>& values) noexcept {
+    return value_and_derivatives_of(expr, traits::variables_of_t<E>{}, values);
+}
+
+//! \} group Expressions
+
+}  // namespace xp
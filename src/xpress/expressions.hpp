@@ -7,8 +7,9 @@
  */
 #pragma once
 
+#include <span>
 #include <utility>
-#include <ostream>
+#include <iosfwd>
 #include <concepts>
 #include <type_traits>
 
@@ -38,9 +39,15 @@ struct bound_expression {
         return traits::value_of<E>::from(_bindings);
     }
 
+    //! Write this expression with the bound values to the given output (see `write_to`)
+    template<typename O>
+    constexpr void write_to(O& out) const noexcept {
+        traits::stream<E>::to(out, _bindings);
+    }
+
     //! Insert this expression into the given output stream
     friend constexpr std::ostream& operator<<(std::ostream& s, const bound_expression& e) noexcept {
-        traits::stream<E>::to(s, e._bindings);
+        e.write_to(s);
         return s;
     }
 
@@ -86,6 +93,10 @@ namespace detail {
             return traits::derivative_of<E>::wrt(type_list<V>{});
     }
 
+    // evaluation at many points, which is implemented in batch.hpp
+    template<typename E>
+    struct batch_evaluation;
+
 }  // namespace detail
 #endif  // DOXYGEN
 
@@ -119,6 +130,18 @@ struct evaluator {
     constexpr decltype(auto) at(const bindings<V...>& values) const noexcept {
         return traits::value_of<E>::from(values);
     }
+
+    /*!
+     * \brief Evaluate the expression at all points of the given output array, with (contiguous) arrays of values
+     *        bound to the symbols that vary between the points, and scalars bound to those that don't (broadcast).
+     *        The points are evaluated in blocks of `batch_block_size`, for which each node of the expression is
+     *        evaluated with a single loop over the block. Requires including `xpress/batch.hpp`.
+     */
+    template<typename R, binder... V>
+    constexpr void batch(std::span<R> out, V&&... values) const noexcept {
+        static_assert(is_complete_v<detail::batch_evaluation<E>>, "Batch evaluation requires including xpress/batch.hpp.");
+        detail::batch_evaluation<E>::evaluate(out, bindings{std::forward<V>(values)...});
+    }
 };
 
 //! Exposes an interface for the differentiation of an expression
@@ -182,10 +205,14 @@ inline constexpr auto gradient_of(const E& expr, const bindings<B...>& vals) noe
     return gradient_of(expr).at(vals);
 }
 
-//! Write the given expression to the given stream with the given value bindings
-template<expression E, typename... V>
+/*!
+ * \brief Write the given expression to the given stream with the given value bindings.
+ *        Besides std::ostream, the stream traits accept any output supporting `operator<<`,
+ *        which is used to write expressions directly into the output of `std::format`.
+ */
+template<typename O, expression E, typename... V>
     requires(streamable_with<E, V...>)
-inline constexpr void write_to(std::ostream& out, const E&, const bindings<V...>& values) noexcept {
+inline constexpr void write_to(O& out, const E&, const bindings<V...>& values) noexcept {
     traits::stream<E>::to(out, values);
 }
 
@@ -199,28 +226,6 @@ inline constexpr auto wrt(const V&...) {
 
 }  // namespace xp
 
-
-#include <format>
-#include <sstream>
-
-template<typename E, typename... V>
-struct std::formatter<xp::bound_expression<E, V...>> {
-
-    // todo: precision formatter?
-    template<typename parse_ctx>
-    constexpr parse_ctx::iterator parse(parse_ctx& ctx) {
-        auto it = ctx.begin();
-        if (it == ctx.end())
-            return it;
-        if (*it != '}')
-            throw std::format_error("xp::bound_expression does not support format args.");
-        return it;
-    }
-
-    template<typename fmt_ctx>
-    fmt_ctx::iterator format(const xp::bound_expression<E, V...>& e, fmt_ctx& ctx) const {
-        std::ostringstream out;
-        out << e;
-        return std::ranges::copy(std::move(out).str(), ctx.out()).out;
-    }
-};
+#ifndef XP_NO_IOSTREAM
+#include "format.hpp"
+#endif
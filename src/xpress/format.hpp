@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Support for formatting expressions with bound values via `std::format`.
+ *        This is included by `expressions.hpp` unless `XP_NO_IOSTREAM` is defined, which allows to
+ *        use the evaluation headers without depending on iostreams (e.g. in device code).
+ */
+#pragma once
+
+#include <format>
+#include <sstream>
+#include <concepts>
+#include <string_view>
+
+#include "expressions.hpp"
+
+#ifndef DOXYGEN
+namespace xp::detail {
+
+    // Output that writes into a format context, formatting floating-point values with the given formatter
+    // (i.e. with the user's format spec), and other values with their default format. Values that are not
+    // formattable, but streamable, are written via a (temporary) string stream.
+    template<typename fmt_ctx, typename F>
+    class format_context_writer {
+     public:
+        constexpr format_context_writer(fmt_ctx& ctx, const F& value_formatter) noexcept
+        : _ctx{ctx}
+        , _value_formatter{value_formatter}
+        {}
+
+        template<typename T>
+        format_context_writer& operator<<(const T& value) {
+            if constexpr (std::convertible_to<const T&, std::string_view>)
+                _ctx.advance_to(std::ranges::copy(std::string_view{value}, _ctx.out()).out);
+            else if constexpr (std::same_as<T, char>)
+                _ctx.advance_to(std::ranges::copy(std::string_view{&value, 1}, _ctx.out()).out);
+            else if constexpr (std::floating_point<T>)
+                _ctx.advance_to(_value_formatter.format(static_cast<double>(value), _ctx));
+            else if constexpr (std::formattable<T, char>)
+                _ctx.advance_to(std::format_to(_ctx.out(), "{}", value));
+            else {
+                std::ostringstream s;
+                s << value;
+                _ctx.advance_to(std::ranges::copy(std::move(s).str(), _ctx.out()).out);
+            }
+            return *this;
+        }
+
+     private:
+        fmt_ctx& _ctx;
+        const F& _value_formatter;
+    };
+
+}  // namespace xp::detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Formatter for expressions with bound values, which writes directly into the output of the format context.
+ *        The format spec (e.g. `{:.3f}`) applies to all floating-point values in the expression.
+ */
+template<typename E, typename... V>
+struct std::formatter<xp::bound_expression<E, V...>> {
+    template<typename parse_ctx>
+    constexpr parse_ctx::iterator parse(parse_ctx& ctx) {
+        return _value_formatter.parse(ctx);
+    }
+
+    template<typename fmt_ctx>
+    fmt_ctx::iterator format(const xp::bound_expression<E, V...>& e, fmt_ctx& ctx) const {
+        xp::detail::format_context_writer writer{ctx, _value_formatter};
+        e.write_to(writer);
+        return ctx.out();
+    }
+
+ private:
+    std::formatter<double> _value_formatter;
+};
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Second derivatives of expressions, exploiting the symmetry of the Hessian.
+ */
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "evaluation.hpp"
+#include "linalg.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // row and column of the k-th entry in the (row-wise) upper triangle of an n x n matrix
+    template<std::size_t n>
+    inline constexpr auto upper_triangle = [] () {
+        std::array<std::pair<std::size_t, std::size_t>, n*(n+1)/2> result{};
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = i; j < n; ++j)
+                result[k++] = {i, j};
+        return result;
+    } ();
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Contains the expressions of the second derivatives of an expression E w.r.t. the variables X.
+ *        Only the n*(n+1)/2 entries on and above the diagonal are formed, where the entry (i, j) with i <= j
+ *        is the derivative w.r.t. the j-th variable of the first derivative w.r.t. the i-th variable.
+ *        Thus, the n first-derivative trees are shared among all entries, and the entry (j, i) is the
+ *        same expression as the entry (i, j).
+ */
+template<typename E, typename... X> requires(sizeof...(X) > 0)
+struct hessian {
+ private:
+    template<std::size_t i>
+    using variable_t = typename decltype(detail::type_lists::type_at<i>(
+        std::declval<const detail::type_lists::indexed_types<std::index_sequence_for<X...>, X...>&>()
+    ))::type;
+
+    static constexpr auto upper = detail::upper_triangle<sizeof...(X)>;
+
+ public:
+    //! Number of variables (i.e. rows and columns)
+    static constexpr std::size_t size = sizeof...(X);
+    //! Number of distinct entries
+    static constexpr std::size_t stored_size = upper.size();
+
+    //! Expression of the first derivative w.r.t. the i-th variable
+    template<std::size_t i>
+    using first_derivative_t = std::remove_cvref_t<decltype(xp::derivative_of(E{}, type_list<variable_t<i>>{}))>;
+
+    //! Expression of the second derivative w.r.t. the i-th and j-th variables
+    template<std::size_t i, std::size_t j>
+    using entry_t = std::remove_cvref_t<decltype(xp::derivative_of(
+        first_derivative_t<std::min(i, j)>{}, type_list<variable_t<std::max(i, j)>>{}
+    ))>;
+
+    //! Expression of the k-th distinct entry (in the row-wise order of the upper triangle)
+    template<std::size_t k>
+    using stored_entry_t = entry_t<upper[k].first, upper[k].second>;
+
+    constexpr hessian() = default;
+    constexpr hessian(const E&, const type_list<X...>&) noexcept {}
+
+    //! Return the expression of the second derivative w.r.t. the given variables
+    template<typename A, typename B>
+        requires(is_any_of_v<A, X...> and is_any_of_v<B, X...>)
+    constexpr auto wrt(const A&, const B&) const noexcept {
+        return entry_t<
+            detail::index_of_equal_node<A, type_list<X...>>::value,
+            detail::index_of_equal_node<B, type_list<X...>>::value
+        >{};
+    }
+
+    //! Evaluate the Hessian at the given values
+    template<binder... V>
+    constexpr auto at(V&&... values) const noexcept {
+        return at(bindings{std::forward<V>(values)...});
+    }
+
+    /*!
+     * \brief Evaluate the Hessian at the given value bindings. The nodes of all entries are evaluated once
+     *        (see `with_values_of`), and the result is a `linalg::symmetric_tensor` of the common value type.
+     */
+    template<typename... V>
+    constexpr auto at(const bindings<V...>& values) const noexcept {
+        return [&] <std::size_t... k> (const std::index_sequence<k...>&) constexpr {
+            using nodes = traits::evaluation_nodes_of_t<bindings<V...>, stored_entry_t<k>...>;
+            return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+                return symmetric_of(detail::cached_value_of(stored_entry_t<k>{}, node_values)...);
+            });
+        } (std::make_index_sequence<stored_size>{});
+    }
+
+    //! Return a symmetric tensor from the given values of the distinct entries (for internal use)
+    template<typename... T> requires(sizeof...(T) == stored_size)
+    static constexpr auto symmetric_of(const T&... values) noexcept {
+        using R = std::common_type_t<T...>;
+        return linalg::symmetric_tensor<R, size>{md_shape<size, size>{}, static_cast<R>(values)...};
+    }
+};
+
+template<typename E, typename... X>
+hessian(const E&, const type_list<X...>&) -> hessian<E, X...>;
+
+//! Return the Hessian of the given expression w.r.t. the given variables
+template<expression E, typename... X>
+inline constexpr auto hessian_of(const E& expr, const type_list<X...>& vars) noexcept {
+    return hessian{expr, vars};
+}
+
+//! Return the Hessian of the given expression w.r.t. the given variables, evaluated at the given values
+template<expression E, typename... X, typename... V>
+inline constexpr auto hessian_of(const E& expr, const type_list<X...>& vars, const bindings<V...>& values) noexcept {
+    return hessian{expr, vars}.at(values);
+}
+
+//! Return the Hessian of the given expression w.r.t. all of its variables
+template<expression E>
+inline constexpr auto hessian_of(const E& expr) noexcept {
+    return hessian_of(expr, traits::variables_of_t<E>{});
+}
+
+/*!
+ * \brief Evaluate the given expression, its derivatives and its Hessian w.r.t. the given variables in one pass,
+ *        evaluating each node of all these expressions only once. Returns a tuple of the value, the bindings of
+ *        the derivative values to the variables (as `value_and_derivatives_of`), and the Hessian (as `hessian_of`).
+ */
+template<expression E, typename... X, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_gradient_and_hessian_of(const E&, const type_list<X...>&, const bindings<V...>& values) noexcept {
+    using H = hessian<E, X...>;
+    return [&] <std::size_t... i, std::size_t... k> (const std::index_sequence<i...>&, const std::index_sequence<k...>&) constexpr {
+        using nodes = traits::evaluation_nodes_of_t<
+            bindings<V...>, E, typename H::template first_derivative_t<i>..., typename H::template stored_entry_t<k>...
+        >;
+        return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+            return std::tuple{
+                detail::cached_value_of(E{}, node_values),
+                bindings{value_binder{X{}, detail::cached_value_of(typename H::template first_derivative_t<i>{}, node_values)}...},
+                H::symmetric_of(detail::cached_value_of(typename H::template stored_entry_t<k>{}, node_values)...)
+            };
+        });
+    } (std::index_sequence_for<X...>{}, std::make_index_sequence<H::stored_size>{});
+}
+
+//! \} group Expressions
+
+}  // namespace xp
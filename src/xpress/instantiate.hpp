@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Evaluators with fixed signatures, whose expressions are instantiated in a single translation unit.
+ */
+#pragma once
+
+#include <utility>
+#include <type_traits>
+
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+template<typename F>
+class compiled_evaluator;
+
+/*!
+ * \brief Evaluator with the fixed signature `R(A...)`, which calls a plain function pointer. This allows to declare
+ *        evaluators of heavy expressions in headers without exposing (and thus instantiating) the expressions in every
+ *        translation unit (see `XP_DECLARE_EVALUATOR` and `XP_DEFINE_EVALUATOR`).
+ */
+template<typename R, typename... A>
+class compiled_evaluator<R(A...)> {
+ public:
+    using function_pointer = R(*)(A...) noexcept;
+
+    constexpr explicit compiled_evaluator(function_pointer f) noexcept
+    : _function{f}
+    {}
+
+    //! Evaluate the expression at the given values (in the order of the symbols given on definition)
+    R operator()(A... args) const noexcept {
+        return _function(std::forward<A>(args)...);
+    }
+
+    //! Return the underlying function pointer
+    constexpr function_pointer get() const noexcept {
+        return _function;
+    }
+
+ private:
+    function_pointer _function;
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename F>
+    struct compiled_function;
+    template<typename R, typename... A>
+    struct compiled_function<compiled_evaluator<R(A...)>> {
+        template<expression E, typename... S>
+        static constexpr auto from(const E&, const S&...) noexcept {
+            static_assert(sizeof...(A) == sizeof...(S), "The number of symbols does not match the number of arguments.");
+            static_assert(
+                evaluatable_with<E, value_binder<S, const std::remove_cvref_t<A>&>...>,
+                "The expression cannot be evaluated with the given symbols and argument types."
+            );
+            return compiled_evaluator<R(A...)>{+[] (A... args) noexcept -> R {
+                return static_cast<R>(traits::value_of<E>::from(bindings{value_binder{S{}, std::as_const(args)}...}));
+            }};
+        }
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! \} group Expressions
+
+}  // namespace xp
+
+/*!
+ * \ingroup Expressions
+ * \brief Declare an evaluator with the given name and signature, e.g. in a header, without instantiating its expression:
+ *        \code{.cpp}
+ *            XP_DECLARE_EVALUATOR(my_model, double(double, double));
+ *        \endcode
+ *        The evaluator has to be defined in exactly one translation unit with `XP_DEFINE_EVALUATOR`.
+ */
+#define XP_DECLARE_EVALUATOR(name, signature) \
+    extern const ::xp::compiled_evaluator<signature> name
+
+/*!
+ * \ingroup Expressions
+ * \brief Define a previously declared evaluator (see `XP_DECLARE_EVALUATOR`) from an expression and the symbols to which the
+ *        arguments are bound (in the order of the arguments). The symbols have to be declared at namespace scope:
+ *        \code{.cpp}
+ *            static constexpr xp::var a;
+ *            static constexpr xp::var b;
+ *            XP_DEFINE_EVALUATOR(my_model, a*log(b) + a*b, a, b);
+ *        \endcode
+ *        The evaluator is constant-initialized, such that it can safely be used during static initialization.
+ */
+#define XP_DEFINE_EVALUATOR(name, expr, ...) \
+    constinit const std::remove_const_t<decltype(name)> name \
+        = ::xp::detail::compiled_function<std::remove_const_t<decltype(name)>>::from(expr, __VA_ARGS__)
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Compile-time sparsity patterns of the Jacobians of vector expressions, and their sparse assembly.
+ */
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "evaluation.hpp"
+#include "linalg.hpp"
+#include "tensor.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // row-major positions of the (potentially) non-zero entries of an m x n Jacobian with the given rows
+    template<std::size_t m, std::size_t n, std::array<std::array<bool, n>, m> rows>
+    struct jacobian_entries {
+        static constexpr std::size_t count = [] () {
+            std::size_t result = 0;
+            for (const auto& row : rows)
+                for (bool nonzero : row)
+                    result += nonzero ? 1 : 0;
+            return result;
+        } ();
+
+        static constexpr std::array<std::pair<std::size_t, std::size_t>, count> positions = [] () {
+            std::array<std::pair<std::size_t, std::size_t>, count> result{};
+            for (std::size_t i = 0, k = 0; i < m; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    if (rows[i][j])
+                        result[k++] = {i, j};
+            return result;
+        } ();
+    };
+
+    template<typename entries, typename = std::make_index_sequence<entries::count>>
+    struct pattern_of_entries;
+    template<typename entries, std::size_t... k>
+    struct pattern_of_entries<entries, std::index_sequence<k...>>
+    : std::type_identity<linalg::sparsity_pattern<md_index<entries::positions[k].first, entries::positions[k].second>...>> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+namespace traits {
+
+/*!
+ * \brief Trait to get the compile-time sparsity pattern (a `linalg::sparsity_pattern`) of the Jacobian of a vector
+ *        expression w.r.t. the variables X. The entry (i, j) is (potentially) non-zero if the j-th variable (which may also be
+ *        a `let` symbol or a sub-expression) is equal to one of the nodes of the i-th component. All other entries are
+ *        zero by construction, since `derivative_of` collapses their expressions to `val<0>`.
+ */
+template<typename E, typename X>
+struct jacobian_pattern_of;
+
+template<std::size_t m, typename... E, typename... X>
+struct jacobian_pattern_of<tensor_expression<md_shape<m>, E...>, type_list<X...>> {
+ private:
+    static constexpr std::size_t n = sizeof...(X);
+
+    template<typename C>
+    static constexpr std::array<bool, n> row_of{detail::contains_equal_node<X, unique_nodes_of_t<C>>::value...};
+
+ public:
+    using type = typename xp::detail::pattern_of_entries<
+        xp::detail::jacobian_entries<m, n, std::array<std::array<bool, n>, m>{row_of<E>...}>
+    >::type;
+};
+
+template<typename E, typename X>
+using jacobian_pattern_of_t = typename jacobian_pattern_of<std::remove_cvref_t<E>, X>::type;
+
+}  // namespace traits
+
+//! Sparse tensor type that stores only the (potentially) non-zero entries of the Jacobian of E w.r.t. the variables X
+template<typename T, typename E, typename... X>
+using sparse_jacobian_t = linalg::sparse_tensor<
+    T,
+    md_shape<shape_of_t<std::remove_cvref_t<E>>{}.first(), sizeof...(X)>,
+    traits::jacobian_pattern_of_t<E, type_list<X...>>
+>;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // assemble the sparse Jacobian from the bindings of the derivative vectors to the variables (as `derivatives_of`)
+    template<typename T, typename E, typename... X, typename D>
+    inline constexpr auto assemble_sparse_jacobian(const type_list<X...>&, const D& derivatives) noexcept {
+        sparse_jacobian_t<T, E, X...> result{T{0}};
+        [&] <std::size_t... i, std::size_t... j> (const linalg::sparsity_pattern<md_index<i, j>...>&) constexpr {
+            std::size_t k = 0;
+            (..., [&] <typename V> (const V&) constexpr {
+                using G = std::remove_cvref_t<decltype(derivatives[V{}])>;
+                result.stored_values()[k++] = static_cast<T>(access<G>::at(md_index<i>{}, derivatives[V{}]));
+            } (std::tuple_element_t<j, std::tuple<X...>>{}));
+        } (traits::jacobian_pattern_of_t<E, type_list<X...>>{});
+        return result;
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Evaluate the given vector expression and its Jacobian w.r.t. the given variables in one pass (see
+ *        `value_and_derivatives_of`). The Jacobian is returned as `sparse_jacobian_t`, storing only the entries
+ *        that are not zero by construction (see `traits::jacobian_pattern_of`).
+ */
+template<expression E, typename... X, typename... V>
+    requires(sizeof...(X) > 0 and evaluatable_with<E, V...>)
+inline constexpr auto value_and_sparse_jacobian_of(const E& expr, const type_list<X...>& vars, const bindings<V...>& values) noexcept {
+    const auto [value, derivatives] = value_and_derivatives_of(expr, vars, values);
+    using scalar = std::common_type_t<scalar_type_t<std::remove_cvref_t<decltype(derivatives[X{}])>>...>;
+    return std::pair{value, detail::assemble_sparse_jacobian<scalar, E>(vars, derivatives)};
+}
+
+//! Evaluate the Jacobian of the given vector expression w.r.t. the given variables as sparse tensor (see `value_and_sparse_jacobian_of`)
+template<expression E, typename... X, typename... V>
+    requires(sizeof...(X) > 0 and evaluatable_with<E, V...>)
+inline constexpr auto sparse_jacobian_of(const E& expr, const type_list<X...>& vars, const bindings<V...>& values) noexcept {
+    return value_and_sparse_jacobian_of(expr, vars, values).second;
+}
+
+//! \} group Expressions
+
+}  // namespace xp
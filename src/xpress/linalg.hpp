@@ -12,6 +12,13 @@
 #include <algorithm>
 #include <array>
 #include <tuple>
+#include <utility>
+#include <optional>
+#include <functional>
+#include <span>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
 
 #include "utils.hpp"
 #include "traits.hpp"
@@ -23,25 +30,73 @@ namespace xp::linalg {
 //! \addtogroup LinearAlgebra
 //! \{
 
-template<typename T, typename shape>
+//! Storage policy for tensors that stores the values in a plain array (the default)
+struct packed_storage {};
+
+//! Alignment (in bytes) that suffices for the widest SIMD registers on common platforms
+inline constexpr std::size_t simd_alignment = 64;
+
+/*!
+ * \brief Storage policy for tensors that aligns the values to the given number of bytes, such that element-wise
+ *        kernels can use aligned vector loads. Only the entries of the tensor are stored (and iterated over), but
+ *        as for any over-aligned type, the object size (`sizeof`) is a multiple of the alignment, such that the
+ *        values of consecutive tensors in arrays remain aligned.
+ */
+template<std::size_t alignment = simd_alignment>
+struct aligned_storage {
+    static_assert(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two.");
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T, std::size_t count, typename policy>
+    struct tensor_storage;
+
+    template<typename T, std::size_t count>
+    struct tensor_storage<T, count, packed_storage> {
+        static constexpr std::size_t alignment = alignof(T);
+        std::array<T, count> values;
+    };
+
+    template<typename T, std::size_t count, std::size_t a>
+    struct tensor_storage<T, count, aligned_storage<a>> {
+        static constexpr std::size_t alignment = std::max(a, alignof(T));
+        alignas(alignment) std::array<T, count> values;
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename T, typename shape, typename storage = packed_storage>
 struct tensor {
  public:
+    //! Alignment (in bytes) of the stored values
+    static constexpr std::size_t alignment = detail::tensor_storage<T, shape::count, storage>::alignment;
+    using storage_policy = storage;
+
     constexpr tensor() = default;
-    constexpr tensor(T value) noexcept { std::ranges::fill(_values, value); }
+    constexpr tensor(T value) noexcept { std::ranges::fill(_storage.values, value); }
 
     template<std::convertible_to<T>... _T> requires(sizeof...(_T) == shape::count)
     constexpr tensor(const shape&, _T&&... values) noexcept
-    : _values{static_cast<T>(std::forward<_T>(values))...}
+    : _storage{{static_cast<T>(std::forward<_T>(values))...}}
     {}
 
     constexpr tensor(const shape&, std::array<T, shape::count>&& values) noexcept
-    : _values{std::move(values)}
+    : _storage{std::move(values)}
     {}
 
+    //! Construct from a tensor with the same shape but a different storage policy
+    template<typename other_storage> requires(!std::is_same_v<storage, other_storage>)
+    constexpr tensor(const tensor<T, shape, other_storage>& other) noexcept {
+        std::ranges::copy(other.as_array(), _storage.values.begin());
+    }
+
     template<typename S, std::size_t... i>
     constexpr decltype(auto) operator[](this S&& self, const md_index<i...>&) noexcept {
         static_assert(md_index<i...>::as_flat_index_in(shape{}) < shape::count);
-        return self._values[md_index<i...>::as_flat_index_in(shape{})];
+        return self._storage.values[md_index<i...>::as_flat_index_in(shape{})];
     }
 
     template<typename S, std::size_t i> requires(shape::dimensions == 1)
@@ -51,7 +106,7 @@ struct tensor {
 
     template<typename S> requires(shape::dimensions == 1)
     constexpr decltype(auto) operator[](this S&& self, const std::size_t idx) noexcept {
-        return self._values[idx];
+        return self._storage.values[idx];
     }
 
     template<typename S, std::integral... is> requires(shape::dimensions > 1 and sizeof...(is) == shape::dimensions)
@@ -68,18 +123,25 @@ struct tensor {
             else
                 return accumulated + std::get<i0>(index_tuple);
         };
-        return self._values[flat_index(ic<0>, shape{}, 0)];
+        return self._storage.values[flat_index(ic<0>, shape{}, 0)];
     }
 
+    //! Return a pointer to the values, stored contiguously in row-major order
+    constexpr T* data() noexcept { return _storage.values.data(); }
+    constexpr const T* data() const noexcept { return _storage.values.data(); }
+
+    //! Return the array of values, stored in row-major order
+    constexpr const std::array<T, shape::count>& as_array() const noexcept { return _storage.values; }
+
     template<typename V> requires(is_scalar_v<V>)
     constexpr auto operator*(const V& value) const noexcept {
-        auto scaled = _values;
-        std::ranges::for_each(scaled, [&] (auto& v) { v *= value; });
-        return linalg::tensor{shape{}, std::move(scaled)};
+        auto scaled = *this;
+        std::ranges::for_each(scaled._storage.values, [&] (auto& v) { v *= value; });
+        return scaled;
     }
 
-    template<typename T2, typename shape2>
-    constexpr bool operator==(const tensor<T2, shape2>& other) const noexcept {
+    template<typename T2, typename shape2, typename storage2>
+    constexpr bool operator==(const tensor<T2, shape2, storage2>& other) const noexcept {
         if constexpr (shape2{} != shape{}) {
             return false;
         } else {
@@ -100,7 +162,7 @@ struct tensor {
     }
 
  private:
-    std::array<T, shape::count> _values;
+    detail::tensor_storage<T, shape::count, storage> _storage;
 };
 
 template<std::size_t... s, typename T, std::size_t size>
@@ -115,8 +177,467 @@ template<std::size_t... s, typename... Ts>
     requires(sizeof...(Ts) > 0 and !std::conjunction_v<is_scalar<std::remove_cvref_t<Ts>>...>)
 tensor(const md_shape<s...>&, Ts&&...) -> tensor<std::remove_cvref_t<first_t<type_list<Ts...>>>, md_shape<s...>>;
 
+//! Alias for tensors with aligned storage
+template<typename T, typename shape, std::size_t alignment = simd_alignment>
+using aligned_tensor = tensor<T, shape, aligned_storage<alignment>>;
+
+//! Trait to detect (dense) linalg::tensor types
+template<typename T>
+struct is_tensor : std::false_type {};
+template<typename T, typename shape, typename storage>
+struct is_tensor<tensor<T, shape, storage>> : std::true_type {};
+template<typename T>
+inline constexpr bool is_tensor_v = is_tensor<std::remove_cvref_t<T>>::value;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // uses the builtin instead of std::assume_aligned, since <memory> pulls in <ostream> on some standard libraries
+    template<std::size_t alignment, typename T>
+    inline constexpr T* assume_aligned(T* ptr) noexcept {
+        if (std::is_constant_evaluated())
+            return ptr;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T*>(__builtin_assume_aligned(ptr, alignment));
+#else
+        return ptr;
+#endif
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Apply the given function element-wise to the values of dense tensors of equal shape. In contrast to
+ *        iterating over the compile-time indices of the shape, this runs a single loop over the contiguous
+ *        (and depending on the storage policy, aligned) values, which compilers can vectorize.
+ *        The result has the storage policy of the first tensor.
+ */
+template<typename F, typename T, typename shape, typename storage, typename... Ts>
+    requires(std::conjunction_v<is_tensor<Ts>...>)
+inline constexpr auto transformed(F&& f, const tensor<T, shape, storage>& t, const Ts&... ts) noexcept {
+    static_assert(std::conjunction_v<std::is_same<shape_of_t<Ts>, shape>...>, "Tensor shapes do not match.");
+    using R = std::remove_cvref_t<std::invoke_result_t<F&, const T&, const scalar_type_t<Ts>&...>>;
+    using result_t = tensor<R, shape, storage>;
+
+    result_t result;
+    R* out = detail::assume_aligned<result_t::alignment>(result.data());
+    const T* in = detail::assume_aligned<tensor<T, shape, storage>::alignment>(t.data());
+    [&] (const auto*... ins) constexpr {
+        for (std::size_t i = 0; i < shape::count; ++i)
+            out[i] = f(in[i], ins[i]...);
+    } (detail::assume_aligned<Ts::alignment>(ts.data())...);
+    return result;
+}
+
+/*!
+ * \brief Return the scalar product of two dense tensors of equal shape with a contiguous loop.
+ *        Uses independent partial sums, which allows for vectorization without reassociating a single sum.
+ */
+template<typename T1, typename T2, typename shape, typename storage1, typename storage2>
+inline constexpr auto dot(const tensor<T1, shape, storage1>& a, const tensor<T2, shape, storage2>& b) noexcept {
+    using R = std::common_type_t<T1, T2>;
+    constexpr std::size_t lanes = 4;
+    const T1* x = detail::assume_aligned<tensor<T1, shape, storage1>::alignment>(a.data());
+    const T2* y = detail::assume_aligned<tensor<T2, shape, storage2>::alignment>(b.data());
+
+    std::array<R, lanes> partial_sums{};
+    std::size_t i = 0;
+    for (; i + lanes <= shape::count; i += lanes)
+        for (std::size_t l = 0; l < lanes; ++l)
+            partial_sums[l] += x[i + l]*y[i + l];
+    R result{0};
+    for (; i < shape::count; ++i)
+        result += x[i]*y[i];
+    for (std::size_t l = 0; l < lanes; ++l)
+        result += partial_sums[l];
+    return result;
+}
+
+
+//! Trait to expose if the entry at the given index of a tensor type is zero by construction
+template<typename T, typename index>
+struct is_structural_zero : std::false_type {};
+template<typename T, typename index>
+inline constexpr bool is_structural_zero_v = is_structural_zero<std::remove_cvref_t<T>, index>::value;
+
+//! Trait to expose if a tensor type stores a subset of its entries, from which all others follow
+template<typename T>
+struct is_structured : std::false_type {};
+template<typename T>
+inline constexpr bool is_structured_v = is_structured<std::remove_cvref_t<T>>::value;
+
+//! Trait to expose if two structured tensor types have the same structure (possibly with different scalars)
+template<typename T1, typename T2>
+struct have_same_structure : std::false_type {};
+template<typename T1, typename T2> requires(is_structured_v<T1> and is_structured_v<T2>)
+struct have_same_structure<T1, T2>
+: std::is_same<typename T1::template rebind<scalar_type_t<T2>>, T2> {};
+template<typename T1, typename T2>
+inline constexpr bool have_same_structure_v = have_same_structure<std::remove_cvref_t<T1>, std::remove_cvref_t<T2>>::value;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // base class for structured tensors that implements storage and element-wise operations on the stored values
+    template<typename Impl, typename T, std::size_t stored_count>
+    class structured_tensor_base {
+     public:
+        static constexpr std::size_t stored_size = stored_count;
+
+        constexpr structured_tensor_base() = default;
+        constexpr structured_tensor_base(T value) noexcept { std::ranges::fill(_values, value); }
+        constexpr structured_tensor_base(std::array<T, stored_count>&& values) noexcept : _values{std::move(values)} {}
+
+        //! Return the stored values
+        constexpr const std::array<T, stored_count>& stored_values() const noexcept { return _values; }
+        constexpr std::array<T, stored_count>& stored_values() noexcept { return _values; }
+
+        constexpr bool operator==(const structured_tensor_base& other) const noexcept {
+            return _values == other._values;
+        }
+
+     protected:
+        std::array<T, stored_count> _values;
+    };
+
+    template<typename T, typename... I>
+    struct index_in_pattern;
+    template<std::size_t... i, typename... I>
+    struct index_in_pattern<md_index<i...>, I...> {
+        static constexpr std::size_t value = [] () {
+            std::size_t pos = 0;
+            (void) (... or (std::is_same_v<md_index<i...>, I> ? true : (++pos, false)));
+            return pos;
+        } ();
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Symmetric square matrix that stores only the n*(n+1)/2 entries on and above the diagonal
+ *        (row-wise). Writing an entry also sets its symmetric counterpart.
+ */
+template<typename T, std::size_t n>
+class symmetric_tensor : public detail::structured_tensor_base<symmetric_tensor<T, n>, T, n*(n+1)/2> {
+    using base = detail::structured_tensor_base<symmetric_tensor<T, n>, T, n*(n+1)/2>;
+
+ public:
+    template<typename R>
+    using rebind = symmetric_tensor<R, n>;
+
+    using base::base;
+    constexpr symmetric_tensor() = default;
+
+    //! Construct from the upper triangle, given row-wise
+    template<std::convertible_to<T>... _T> requires(sizeof...(_T) == base::stored_size)
+    constexpr symmetric_tensor(const md_shape<n, n>&, _T&&... values) noexcept
+    : base{std::array<T, base::stored_size>{static_cast<T>(std::forward<_T>(values))...}}
+    {}
+
+    //! Return the position of the entry at the given row and column in the stored values
+    static constexpr std::size_t stored_index(std::size_t i, std::size_t j) noexcept {
+        const std::size_t r = std::min(i, j);
+        const std::size_t c = std::max(i, j);
+        return r*n - (r*(r - 1))/2 + (c - r);
+    }
+
+    template<typename S, std::size_t i, std::size_t j>
+    constexpr decltype(auto) operator[](this S&& self, const md_index<i, j>&) noexcept {
+        static_assert(i < n && j < n, "Index out of bounds.");
+        return std::forward<S>(self)._values[stored_index(i, j)];
+    }
+
+    template<typename S>
+    constexpr decltype(auto) operator[](this S&& self, std::size_t i, std::size_t j) noexcept {
+        return std::forward<S>(self)._values[stored_index(i, j)];
+    }
+};
+
+template<std::size_t n, typename... _T>
+symmetric_tensor(const md_shape<n, n>&, _T&&...) -> symmetric_tensor<std::common_type_t<std::remove_cvref_t<_T>...>, n>;
+
+//! Diagonal square matrix that stores only its n diagonal entries
+template<typename T, std::size_t n>
+class diagonal_tensor : public detail::structured_tensor_base<diagonal_tensor<T, n>, T, n> {
+    using base = detail::structured_tensor_base<diagonal_tensor<T, n>, T, n>;
+
+ public:
+    template<typename R>
+    using rebind = diagonal_tensor<R, n>;
+
+    using base::base;
+    constexpr diagonal_tensor() = default;
+
+    //! Construct from the diagonal entries
+    template<std::convertible_to<T>... _T> requires(sizeof...(_T) == n)
+    constexpr diagonal_tensor(const md_shape<n, n>&, _T&&... values) noexcept
+    : base{std::array<T, n>{static_cast<T>(std::forward<_T>(values))...}}
+    {}
+
+    //! Return the i-th diagonal entry
+    template<typename S>
+    constexpr decltype(auto) diagonal(this S&& self, std::size_t i) noexcept {
+        return std::forward<S>(self)._values[i];
+    }
+
+    template<typename S, std::size_t i, std::size_t j>
+    constexpr decltype(auto) operator[](this S&& self, const md_index<i, j>&) noexcept {
+        static_assert(i < n && j < n, "Index out of bounds.");
+        if constexpr (i == j)
+            return std::forward<S>(self)._values[i];
+        else
+            return T{0};
+    }
+
+    constexpr T operator[](std::size_t i, std::size_t j) const noexcept {
+        return i == j ? this->_values[i] : T{0};
+    }
+};
+
+template<std::size_t n, typename... _T>
+diagonal_tensor(const md_shape<n, n>&, _T&&...) -> diagonal_tensor<std::common_type_t<std::remove_cvref_t<_T>...>, n>;
+
+//! Compile-time list of the indices of the (potentially) non-zero entries of a sparse tensor
+template<typename... I>
+struct sparsity_pattern {
+    static constexpr std::size_t size = sizeof...(I);
+};
+
+//! Return a sparsity pattern for the given indices
+template<std::size_t... i, typename... I>
+inline constexpr auto pattern(const md_index<i...>&, const I&...) noexcept {
+    return sparsity_pattern<md_index<i...>, I...>{};
+}
+
+//! Tensor of the given shape that stores only the entries at the given indices, all others being zero
+template<typename T, typename shape, typename pattern>
+class sparse_tensor;
+
+template<typename T, std::size_t... s, typename... I>
+class sparse_tensor<T, md_shape<s...>, sparsity_pattern<I...>>
+: public detail::structured_tensor_base<sparse_tensor<T, md_shape<s...>, sparsity_pattern<I...>>, T, sizeof...(I)> {
+    using base = detail::structured_tensor_base<sparse_tensor<T, md_shape<s...>, sparsity_pattern<I...>>, T, sizeof...(I)>;
+    static_assert((... and I{}.is_contained_in(md_shape<s...>{})), "Sparsity pattern contains indices outside of the shape.");
+
+ public:
+    template<typename R>
+    using rebind = sparse_tensor<R, md_shape<s...>, sparsity_pattern<I...>>;
+    using pattern_type = sparsity_pattern<I...>;
+
+    using base::base;
+    constexpr sparse_tensor() = default;
+
+    //! Construct from the values of the non-zero entries, in the order of the sparsity pattern
+    template<std::convertible_to<T>... _T> requires(sizeof...(_T) == sizeof...(I))
+    constexpr sparse_tensor(const md_shape<s...>&, const sparsity_pattern<I...>&, _T&&... values) noexcept
+    : base{std::array<T, sizeof...(I)>{static_cast<T>(std::forward<_T>(values))...}}
+    {}
+
+    //! Return true if the entry at the given index is stored (i.e. potentially non-zero)
+    template<std::size_t... i>
+    static constexpr bool is_stored(const md_index<i...>&) noexcept {
+        return detail::index_in_pattern<md_index<i...>, I...>::value < sizeof...(I);
+    }
+
+    template<typename S, std::size_t... i>
+    constexpr decltype(auto) operator[](this S&& self, const md_index<i...>&) noexcept {
+        static_assert(md_index<i...>{}.is_contained_in(md_shape<s...>{}), "Index out of bounds.");
+        if constexpr (is_stored(md_index<i...>{}))
+            return std::forward<S>(self)._values[detail::index_in_pattern<md_index<i...>, I...>::value];
+        else
+            return T{0};
+    }
+};
+
+template<std::size_t... s, typename... I, typename... _T>
+sparse_tensor(const md_shape<s...>&, const sparsity_pattern<I...>&, _T&&...)
+    -> sparse_tensor<std::common_type_t<std::remove_cvref_t<_T>...>, md_shape<s...>, sparsity_pattern<I...>>;
+
+template<typename T, std::size_t n>
+struct is_structured<symmetric_tensor<T, n>> : std::true_type {};
+template<typename T, std::size_t n>
+struct is_structured<diagonal_tensor<T, n>> : std::true_type {};
+template<typename T, typename shape, typename pattern>
+struct is_structured<sparse_tensor<T, shape, pattern>> : std::true_type {};
+
+template<typename T, std::size_t n, std::size_t i, std::size_t j>
+struct is_structural_zero<diagonal_tensor<T, n>, md_index<i, j>> : std::bool_constant<i != j> {};
+template<typename T, typename shape, typename pattern, std::size_t... i>
+struct is_structural_zero<sparse_tensor<T, shape, pattern>, md_index<i...>>
+: std::bool_constant<!sparse_tensor<T, shape, pattern>::is_stored(md_index<i...>{})> {};
 
-//! Compute the matrix product of two tensors
+//! Trait to expose if an element-wise function can be applied to the stored values of a structured tensor only
+template<typename T>
+struct has_structural_zeros : std::true_type {};
+template<typename T, std::size_t n>
+struct has_structural_zeros<symmetric_tensor<T, n>> : std::false_type {};
+
+//! Apply the given function to the stored values of structured tensors with the same structure
+template<typename F, typename T, typename... Ts>
+    requires(is_structured_v<T> and (... and have_same_structure_v<T, Ts>))
+inline constexpr auto transformed_structured(F&& f, const T& t, const Ts&... ts) noexcept {
+    using R = std::remove_cvref_t<std::invoke_result_t<F&, const scalar_type_t<T>&, const scalar_type_t<Ts>&...>>;
+    typename T::template rebind<R> result;
+    for (std::size_t i = 0; i < T::stored_size; ++i)
+        result.stored_values()[i] = f(t.stored_values()[i], ts.stored_values()[i]...);
+    return result;
+}
+
+/*!
+ * \brief Read-only view on a matrix that exposes it transposed, e.g. to compute `A^T*B` with `mat_mul`
+ *        without explicitly forming the transpose. The view refers to the given matrix, which must outlive it.
+ */
+template<typename T>
+class transposed_view {
+ public:
+    constexpr transposed_view() = default;
+    constexpr explicit transposed_view(const T& matrix) noexcept
+    : _matrix{&matrix}
+    {}
+
+    //! Return the underlying (not transposed) matrix
+    constexpr const T& matrix() const noexcept {
+        return *_matrix;
+    }
+
+ private:
+    const T* _matrix = nullptr;
+};
+
+//! Return a transposed view on the given matrix
+template<tensorial T>
+    requires(shape_of_t<T>::dimensions == 2)
+inline constexpr auto transposed(const T& matrix) noexcept {
+    return transposed_view<T>{matrix};
+}
+
+//! Matrix products with more multiply-adds than this are computed with a loop-based (instead of an unrolled) kernel
+inline constexpr std::size_t mat_mul_unrolling_limit = 64;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct is_diagonal : std::false_type {};
+    template<typename T, std::size_t n>
+    struct is_diagonal<diagonal_tensor<T, n>> : std::true_type {};
+    template<typename T>
+    inline constexpr bool is_diagonal_v = is_diagonal<std::remove_cvref_t<T>>::value;
+
+    template<typename T>
+    struct is_sparse : std::false_type {};
+    template<typename T, typename shape, typename pattern>
+    struct is_sparse<sparse_tensor<T, shape, pattern>> : std::true_type {};
+    template<typename T>
+    inline constexpr bool is_sparse_v = is_sparse<std::remove_cvref_t<T>>::value;
+
+    // (structurally) triangular matrices, whose determinant is the product of the diagonal
+    template<typename T>
+    struct is_triangular : is_diagonal<T> {};
+    template<typename T, std::size_t n, std::size_t... r, std::size_t... c>
+    struct is_triangular<sparse_tensor<T, md_shape<n, n>, sparsity_pattern<md_index<r, c>...>>>
+    : std::bool_constant<(... and (r <= c)) or (... and (r >= c))> {};
+    template<typename T>
+    inline constexpr bool is_triangular_v = is_triangular<std::remove_cvref_t<T>>::value;
+
+    // invoke the visitor with the index and value of each stored entry of the given sparse tensor
+    template<typename T, typename shape, typename... I, typename V>
+    inline constexpr void visit_stored_entries_of(const sparse_tensor<T, shape, sparsity_pattern<I...>>& t, V&& visitor) noexcept {
+        [&] <std::size_t... pos> (const std::index_sequence<pos...>&) constexpr {
+            (..., visitor(I{}, t.stored_values()[pos]));
+        } (std::index_sequence_for<I...>{});
+    }
+
+    // return the given tensor as a dense linalg::tensor with the given scalar type (copies only if necessary)
+    template<typename S, tensorial T>
+    inline constexpr decltype(auto) as_dense(const T& t) noexcept {
+        if constexpr (is_tensor_v<T> and std::is_same_v<scalar_type_t<T>, S>)
+            return (t);
+        else {
+            linalg::tensor<S, shape_of_t<T>> result{S{0}};
+            visit_indices_in(shape_of_t<T>{}, [&] <std::size_t... i> (const md_index<i...>& idx) constexpr {
+                result[idx] = static_cast<S>(access<T>::at(idx, t));
+            });
+            return result;
+        }
+    }
+
+    // c += a*b with row-major (m x k) and (k x p) matrices, blocked for cache reuse and such that
+    // the innermost loop runs over contiguous memory of b and c (which compilers can vectorize)
+    template<std::size_t m, std::size_t k, std::size_t p, typename T>
+    inline constexpr void mat_mul_kernel(const T* a, const T* b, T* c) noexcept {
+        constexpr std::size_t block_size = 64;
+        constexpr std::size_t row_block_size = 4;  // rows of c updated at once, reusing each loaded row of b
+        for (std::size_t kk = 0; kk < k; kk += block_size) {
+            const std::size_t k_end = std::min(kk + block_size, k);
+            for (std::size_t jj = 0; jj < p; jj += block_size) {
+                const std::size_t j_end = std::min(jj + block_size, p);
+                std::size_t i = 0;
+                for (; i + row_block_size <= m; i += row_block_size) {
+                    T* c0 = c + i*p; T* c1 = c0 + p; T* c2 = c1 + p; T* c3 = c2 + p;
+                    for (std::size_t l = kk; l < k_end; ++l) {
+                        const T a0 = a[i*k + l];
+                        const T a1 = a[(i + 1)*k + l];
+                        const T a2 = a[(i + 2)*k + l];
+                        const T a3 = a[(i + 3)*k + l];
+                        const T* b_row = b + l*p;
+                        for (std::size_t j = jj; j < j_end; ++j) {
+                            const T b_lj = b_row[j];
+                            c0[j] += a0*b_lj;
+                            c1[j] += a1*b_lj;
+                            c2[j] += a2*b_lj;
+                            c3[j] += a3*b_lj;
+                        }
+                    }
+                }
+                for (; i < m; ++i) {
+                    T* c_row = c + i*p;
+                    for (std::size_t l = kk; l < k_end; ++l) {
+                        const T a_il = a[i*k + l];
+                        const T* b_row = b + l*p;
+                        for (std::size_t j = jj; j < j_end; ++j)
+                            c_row[j] += a_il*b_row[j];
+                    }
+                }
+            }
+        }
+    }
+
+    // y += a*x with a row-major (m x k) matrix, using independent accumulators for blocks of rows
+    template<std::size_t m, std::size_t k, typename T>
+    inline constexpr void mat_vec_kernel(const T* a, const T* x, T* y) noexcept {
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const T* a0 = a + i*k; const T* a1 = a0 + k; const T* a2 = a1 + k; const T* a3 = a2 + k;
+            T y0{0}, y1{0}, y2{0}, y3{0};
+            for (std::size_t l = 0; l < k; ++l) {
+                const T x_l = x[l];
+                y0 += a0[l]*x_l;
+                y1 += a1[l]*x_l;
+                y2 += a2[l]*x_l;
+                y3 += a3[l]*x_l;
+            }
+            y[i] += y0; y[i + 1] += y1; y[i + 2] += y2; y[i + 3] += y3;
+        }
+        for (; i < m; ++i) {
+            const T* a_row = a + i*k;
+            T y_i{0};
+            for (std::size_t l = 0; l < k; ++l)
+                y_i += a_row[l]*x[l];
+            y[i] += y_i;
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Compute the matrix product of two tensors. Small products are fully unrolled at compile-time, while
+ *        matrix-matrix and matrix-vector products with more than `mat_mul_unrolling_limit` multiply-adds
+ *        are computed with loop-based, cache-blocked kernels. Use `transposed` for transposed operands.
+ */
 template<tensorial T1, tensorial T2>
 inline constexpr auto mat_mul(const T1& t1, const T2& t2) noexcept {
     using shape1 = shape_of_t<T1>;
@@ -132,38 +653,575 @@ inline constexpr auto mat_mul(const T1& t1, const T2& t2) noexcept {
     // todo: deduce return tensor type somehow?
     using scalar = std::common_type_t<scalar_type_t<T1>, scalar_type_t<T2>>;
     linalg::tensor<scalar, decltype(new_shape)> result{scalar{0}};
-    visit_indices_in(new_shape, [&] <std::size_t... i> (const md_index<i...>& idx) constexpr {
-        visit_indices_in(shape<shape1{}.last()>, [&] <std::size_t j> (const md_index<j>&) constexpr {
-            const auto t1_idx = md_index{values<i...>::template take<shape1::dimensions-1>() + values<j>{}};
-            const auto t2_idx = md_index{values<j>{} + values<i...>::template drop<shape1::dimensions-1>()};
-            result[idx] += access<T1>::at(t1_idx, t1)*access<T2>::at(t2_idx, t2);
+
+    static constexpr std::size_t m = shape1{}.first();
+    static constexpr std::size_t k = shape1{}.last();
+    static constexpr std::size_t p = shape2::dimensions == 2 ? shape2{}.last() : 1;
+    static constexpr bool use_kernel = shape1::dimensions == 2
+        and shape2::dimensions <= 2
+        and m*k*p > mat_mul_unrolling_limit;
+
+    if constexpr (use_kernel and detail::is_diagonal_v<T1>) {
+        // scale the rows of the second operand
+        const auto& b = detail::as_dense<scalar>(t2);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < p; ++j)
+                result.data()[i*p + j] = t1.diagonal(i)*b.data()[i*p + j];
+    } else if constexpr (use_kernel and detail::is_diagonal_v<T2>) {
+        // scale the columns of the first operand
+        const auto& a = detail::as_dense<scalar>(t1);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t j = 0; j < p; ++j)
+                result.data()[i*p + j] = a.data()[i*k + j]*t2.diagonal(j);
+    } else if constexpr (use_kernel and detail::is_sparse_v<T1>) {
+        // accumulate the rows of the second operand that correspond to the non-zero entries
+        const auto& b = detail::as_dense<scalar>(t2);
+        detail::visit_stored_entries_of(t1, [&] <std::size_t r, std::size_t c> (const md_index<r, c>&, const auto& value) {
+            for (std::size_t j = 0; j < p; ++j)
+                result.data()[r*p + j] += value*b.data()[c*p + j];
+        });
+    } else if constexpr (use_kernel and detail::is_sparse_v<T2>) {
+        // accumulate the columns of the first operand that correspond to the non-zero entries
+        const auto& a = detail::as_dense<scalar>(t1);
+        detail::visit_stored_entries_of(t2, [&] <std::size_t r, std::size_t... c> (const md_index<r, c...>&, const auto& value) {
+            const std::size_t col = (std::size_t{0} + ... + c);
+            for (std::size_t i = 0; i < m; ++i)
+                result.data()[i*p + col] += a.data()[i*k + r]*value;
+        });
+    } else if constexpr (use_kernel) {
+        const auto& a = detail::as_dense<scalar>(t1);
+        const auto& b = detail::as_dense<scalar>(t2);
+        if constexpr (shape2::dimensions == 2)
+            detail::mat_mul_kernel<m, k, p>(a.data(), b.data(), result.data());
+        else
+            detail::mat_vec_kernel<m, k>(a.data(), b.data(), result.data());
+    } else {
+        visit_indices_in(new_shape, [&] <std::size_t... i> (const md_index<i...>& idx) constexpr {
+            visit_indices_in(shape<shape1{}.last()>, [&] <std::size_t j> (const md_index<j>&) constexpr {
+                const auto t1_idx = md_index{values<i...>::template take<shape1::dimensions-1>() + values<j>{}};
+                const auto t2_idx = md_index{values<j>{} + values<i...>::template drop<shape1::dimensions-1>()};
+                // skip the terms with structural zeros at compile-time
+                if constexpr (!is_structural_zero_v<T1, std::remove_cvref_t<decltype(t1_idx)>>
+                              and !is_structural_zero_v<T2, std::remove_cvref_t<decltype(t2_idx)>>)
+                    result[idx] += access<T1>::at(t1_idx, t1)*access<T2>::at(t2_idx, t2);
+            });
         });
-    });
+    }
     return result;
 }
 
-//! Return the determinant of the given tensor
+//! Compute the product of a matrix and a vector (see `mat_mul`)
+template<tensorial M, tensorial V>
+    requires(shape_of_t<M>::dimensions == 2 and shape_of_t<V>::dimensions == 1)
+inline constexpr auto mat_vec(const M& matrix, const V& vector) noexcept {
+    return mat_mul(matrix, vector);
+}
+
+/*!
+ * \brief LU factorization with partial pivoting of a square matrix, i.e. `P*A = L*U`.
+ *        The factors are computed in-place on the stored copy of the matrix (with the implicit
+ *        unit diagonal of L omitted), and linear systems are solved with forward/backward
+ *        substitution, without ever forming the inverse of the matrix.
+ */
+template<typename T, std::size_t n>
+class lu_factorization {
+ public:
+    using matrix_type = tensor<T, md_shape<n, n>>;
+    using vector_type = tensor<T, md_shape<n>>;
+
+    constexpr explicit lu_factorization(matrix_type matrix) noexcept
+    : _lu{std::move(matrix)} {
+        for (std::size_t i = 0; i < n; ++i)
+            _pivots[i] = i;
+        _factorize();
+    }
+
+    //! Return true if a zero pivot was encountered, i.e. if the matrix is singular
+    constexpr bool is_singular() const noexcept {
+        return _singular;
+    }
+
+    //! Return the determinant of the factorized matrix, i.e. the signed product of the diagonal of U
+    constexpr T determinant() const noexcept {
+        if (_singular)
+            return T{0};
+        T result = _permutation_sign;
+        for (std::size_t i = 0; i < n; ++i)
+            result *= _lu[i, i];
+        return result;
+    }
+
+    //! Solve the system `A*x = rhs` in-place, i.e. overwrite the given right-hand side with the solution
+    constexpr void solve_in_place(vector_type& rhs) const noexcept {
+        vector_type permuted{T{0}};
+        for (std::size_t i = 0; i < n; ++i)
+            permuted[i] = rhs[_pivots[i]];
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < i; ++j)
+                permuted[i] -= _lu[i, j]*permuted[j];
+        for (std::size_t i = n; i-- > 0;) {
+            for (std::size_t j = i + 1; j < n; ++j)
+                permuted[i] -= _lu[i, j]*permuted[j];
+            permuted[i] /= _lu[i, i];
+        }
+        rhs = std::move(permuted);
+    }
+
+    //! Return the solution of the system `A*x = rhs`
+    constexpr vector_type solve(vector_type rhs) const noexcept {
+        solve_in_place(rhs);
+        return rhs;
+    }
+
+ private:
+    static constexpr T _abs(const T& value) noexcept {
+        return value < T{0} ? -value : value;
+    }
+
+    constexpr void _factorize() noexcept {
+        for (std::size_t k = 0; k < n; ++k) {
+            std::size_t pivot_row = k;
+            for (std::size_t i = k + 1; i < n; ++i)
+                if (_abs(_lu[i, k]) > _abs(_lu[pivot_row, k]))
+                    pivot_row = i;
+
+            if (_lu[pivot_row, k] == T{0}) {
+                _singular = true;
+                return;
+            }
+
+            if (pivot_row != k) {
+                _permutation_sign = -_permutation_sign;
+                std::swap(_pivots[k], _pivots[pivot_row]);
+                for (std::size_t j = 0; j < n; ++j)
+                    std::swap(_lu[k, j], _lu[pivot_row, j]);
+            }
+
+            for (std::size_t i = k + 1; i < n; ++i) {
+                _lu[i, k] /= _lu[k, k];
+                for (std::size_t j = k + 1; j < n; ++j)
+                    _lu[i, j] -= _lu[i, k]*_lu[k, j];
+            }
+        }
+    }
+
+    matrix_type _lu;
+    std::array<std::size_t, n> _pivots{};
+    T _permutation_sign{1};
+    bool _singular = false;
+};
+
+template<typename T, std::size_t n, typename storage>
+lu_factorization(tensor<T, md_shape<n, n>, storage>) -> lu_factorization<T, n>;
+
+//! Solve the linear system `A*x = b` via LU factorization (returns an empty optional if A is singular)
+template<typename T, std::size_t n>
+inline constexpr std::optional<tensor<T, md_shape<n>>> solve(tensor<T, md_shape<n, n>> A, tensor<T, md_shape<n>> b) noexcept {
+    const lu_factorization lu{std::move(A)};
+    if (lu.is_singular())
+        return {};
+    return lu.solve(std::move(b));
+}
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // Decomposition of a sparse n x n matrix into independent diagonal blocks (up to permutations of rows and columns),
+    // i.e. into the connected components of the graph in which each stored entry connects its row with its column.
+    // The blocks are ordered by their first row, and the rows and columns within each block are in ascending order.
+    template<std::size_t n, typename pattern>
+    struct diagonal_blocks;
+    template<std::size_t n, std::size_t... r, std::size_t... c>
+    struct diagonal_blocks<n, sparsity_pattern<md_index<r, c>...>> {
+     private:
+        // the representative of each row (0, ..., n-1) and column (n, ..., 2n-1), which is a row for non-empty blocks
+        static constexpr std::array<std::size_t, 2*n> _roots = [] () {
+            std::array<std::size_t, 2*n> parent{};
+            for (std::size_t i = 0; i < 2*n; ++i)
+                parent[i] = i;
+            const auto find = [&] (std::size_t i) constexpr {
+                while (parent[i] != i)
+                    i = parent[i];
+                return i;
+            };
+            const auto merge = [&] (std::size_t a, std::size_t b) constexpr {
+                a = find(a);
+                b = find(b);
+                parent[std::max(a, b)] = std::min(a, b);
+            };
+            (..., merge(r, n + c));
+
+            std::array<std::size_t, 2*n> result{};
+            for (std::size_t i = 0; i < 2*n; ++i)
+                result[i] = find(i);
+            return result;
+        } ();
+
+        static constexpr std::size_t _component_count = [] () {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < 2*n; ++i)
+                count += _roots[i] == i ? 1 : 0;
+            return count;
+        } ();
+
+     public:
+        //! true if a block has more rows than columns (or vice versa), such that the matrix is singular for any values
+        static constexpr bool is_structurally_singular = [] () {
+            for (std::size_t i = 0; i < 2*n; ++i) {
+                if (_roots[i] != i)
+                    continue;
+                int balance = 0;
+                for (std::size_t j = 0; j < n; ++j)
+                    balance += (_roots[j] == i ? 1 : 0) - (_roots[n + j] == i ? 1 : 0);
+                if (balance != 0)
+                    return true;
+            }
+            return false;
+        } ();
+
+        static constexpr std::size_t count = is_structurally_singular ? 0 : _component_count;
+
+        static constexpr std::array<std::size_t, count> sizes = [] () {
+            std::array<std::size_t, count> result{};
+            for (std::size_t i = 0, b = 0; i < n and b < count; ++i) {
+                if (_roots[i] != i)
+                    continue;
+                for (std::size_t j = 0; j < n; ++j)
+                    result[b] += _roots[j] == i ? 1 : 0;
+                ++b;
+            }
+            return result;
+        } ();
+
+     private:
+        // block index and position within the block of each row (offset = 0) or column (offset = n)
+        static constexpr auto _positions = [] (std::size_t offset) {
+            std::array<std::size_t, n> block{};
+            std::array<std::size_t, n> local{};
+            for (std::size_t i = 0, b = 0; i < n; ++i) {
+                if (_roots[i] != i)
+                    continue;
+                for (std::size_t j = 0, k = 0; j < n; ++j)
+                    if (_roots[offset + j] == i) {
+                        block[j] = b;
+                        local[j] = k++;
+                    }
+                ++b;
+            }
+            return std::pair{block, local};
+        };
+
+     public:
+        static constexpr auto row_positions = _positions(0);
+        static constexpr auto column_positions = _positions(n);
+
+        // sign of the permutation that sorts the rows and columns by blocks
+        static constexpr int permutation_sign = [] () {
+            const auto ordered = [] (const auto& positions, std::size_t i, std::size_t j) {
+                const auto& [block, local] = positions;
+                return block[i] < block[j] or (block[i] == block[j] and local[i] < local[j]);
+            };
+            int sign = 1;
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = i + 1; j < n; ++j)
+                    sign *= (ordered(row_positions, i, j) == ordered(column_positions, i, j)) ? 1 : -1;
+            return sign;
+        } ();
+    };
+
+    template<typename T, typename blocks, typename = std::make_index_sequence<blocks::count>>
+    struct block_factorizations;
+    template<typename T, typename blocks, std::size_t... b>
+    struct block_factorizations<T, blocks, std::index_sequence<b...>>
+    : std::type_identity<std::tuple<lu_factorization<T, blocks::sizes[b]>...>> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief LU factorization of a sparse square matrix, which is decomposed at compile-time into the independent diagonal
+ *        blocks its sparsity pattern exhibits up to permutations of rows and columns. Each block is factorized separately
+ *        with `lu_factorization`, such that a matrix with k blocks of size n/k is factorized in O(n^3/k^2).
+ *        Matrices whose pattern contains a block with more rows than columns are reported as singular.
+ */
+template<typename T, std::size_t n, typename pattern>
+class block_lu_factorization {
+    using blocks = detail::diagonal_blocks<n, pattern>;
+
+ public:
+    using matrix_type = sparse_tensor<T, md_shape<n, n>, pattern>;
+    using vector_type = tensor<T, md_shape<n>>;
+
+    constexpr explicit block_lu_factorization(const matrix_type& matrix) noexcept
+    : _blocks{_factorize(matrix, std::make_index_sequence<blocks::count>{})}
+    {}
+
+    //! Return the number of independent diagonal blocks
+    static constexpr std::size_t block_count() noexcept {
+        return blocks::count;
+    }
+
+    //! Return true if the matrix is structurally singular, or if a zero pivot was encountered in one of the blocks
+    constexpr bool is_singular() const noexcept {
+        if constexpr (blocks::is_structurally_singular)
+            return true;
+        else
+            return std::apply([] (const auto&... lu) constexpr { return (false or ... or lu.is_singular()); }, _blocks);
+    }
+
+    //! Return the determinant of the factorized matrix, i.e. the signed product of the determinants of the blocks
+    constexpr T determinant() const noexcept {
+        if (is_singular())
+            return T{0};
+        return std::apply([] (const auto&... lu) constexpr {
+            return (static_cast<T>(blocks::permutation_sign) * ... * lu.determinant());
+        }, _blocks);
+    }
+
+    //! Solve the system `A*x = rhs` in-place, i.e. overwrite the given right-hand side with the solution
+    constexpr void solve_in_place(vector_type& rhs) const noexcept {
+        vector_type solution{T{0}};
+        [&] <std::size_t... b> (const std::index_sequence<b...>&) constexpr {
+            (..., _solve_block<b>(rhs, solution));
+        } (std::make_index_sequence<blocks::count>{});
+        rhs = std::move(solution);
+    }
+
+    //! Return the solution of the system `A*x = rhs`
+    constexpr vector_type solve(vector_type rhs) const noexcept {
+        solve_in_place(rhs);
+        return rhs;
+    }
+
+ private:
+    template<std::size_t... b>
+    static constexpr auto _factorize(const matrix_type& matrix, const std::index_sequence<b...>&) noexcept {
+        std::tuple dense{tensor<T, md_shape<blocks::sizes[b], blocks::sizes[b]>>{T{0}}...};
+        if constexpr (!blocks::is_structurally_singular)
+            detail::visit_stored_entries_of(matrix, [&] <std::size_t i, std::size_t j> (const md_index<i, j>&, const T& value) {
+                constexpr std::size_t block = blocks::row_positions.first[i];
+                static_assert(block == blocks::column_positions.first[j]);
+                std::get<block>(dense)[blocks::row_positions.second[i], blocks::column_positions.second[j]] = value;
+            });
+        return typename detail::block_factorizations<T, blocks>::type{lu_factorization{std::move(std::get<b>(dense))}...};
+    }
+
+    template<std::size_t b>
+    constexpr void _solve_block(const vector_type& rhs, vector_type& solution) const noexcept {
+        constexpr std::size_t size = blocks::sizes[b];
+        tensor<T, md_shape<size>> local{T{0}};
+        for (std::size_t i = 0; i < n; ++i)
+            if (blocks::row_positions.first[i] == b)
+                local[blocks::row_positions.second[i]] = rhs[i];
+        std::get<b>(_blocks).solve_in_place(local);
+        for (std::size_t j = 0; j < n; ++j)
+            if (blocks::column_positions.first[j] == b)
+                solution[j] = local[blocks::column_positions.second[j]];
+    }
+
+    typename detail::block_factorizations<T, blocks>::type _blocks;
+};
+
+template<typename T, std::size_t n, typename pattern>
+block_lu_factorization(const sparse_tensor<T, md_shape<n, n>, pattern>&) -> block_lu_factorization<T, n, pattern>;
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // scalar type in which to carry out factorizations (which involve divisions)
+    template<typename T>
+    using factorization_scalar_t = std::conditional_t<std::is_integral_v<scalar_type_t<T>>, double, scalar_type_t<T>>;
+
+    template<tensorial T>
+    inline constexpr auto as_square_matrix(const T& t) noexcept {
+        using scalar = factorization_scalar_t<T>;
+        static constexpr std::size_t n = shape_of_t<T>{}.first();
+        tensor<scalar, md_shape<n, n>> result{scalar{0}};
+        visit_indices_in(shape_of_t<T>{}, [&] <std::size_t... i> (const md_index<i...>& idx) constexpr {
+            result[idx] = static_cast<scalar>(access<T>::at(idx, t));
+        });
+        return result;
+    }
+
+    // fraction-free (Bareiss) elimination, which yields the exact determinant of matrices with integral entries
+    template<typename R, tensorial T>
+    inline constexpr R bareiss_determinant_of(const T& t) noexcept {
+        static constexpr std::size_t n = shape_of_t<T>{}.first();
+        tensor<R, md_shape<n, n>> m{R{0}};
+        visit_indices_in(shape_of_t<T>{}, [&] <std::size_t... i> (const md_index<i...>& idx) constexpr {
+            m[idx] = static_cast<R>(access<T>::at(idx, t));
+        });
+
+        R sign{1};
+        R previous_pivot{1};
+        for (std::size_t k = 0; k < n; ++k) {
+            if (m[k, k] == R{0}) {
+                std::size_t pivot_row = k + 1;
+                while (pivot_row < n && m[pivot_row, k] == R{0})
+                    ++pivot_row;
+                if (pivot_row == n)
+                    return R{0};
+                for (std::size_t j = 0; j < n; ++j)
+                    std::swap(m[k, j], m[pivot_row, j]);
+                sign = -sign;
+            }
+            for (std::size_t i = k + 1; i < n; ++i)
+                for (std::size_t j = k + 1; j < n; ++j)
+                    m[i, j] = (m[i, j]*m[k, k] - m[i, k]*m[k, j])/previous_pivot;
+            previous_pivot = m[k, k];
+        }
+        return sign*m[n - 1, n - 1];
+    }
+
+    template<typename T, std::size_t n>
+    inline constexpr auto minor_of(const tensor<T, md_shape<n, n>>& matrix, std::size_t row, std::size_t col) noexcept {
+        tensor<T, md_shape<n-1, n-1>> result{T{0}};
+        for (std::size_t i = 0, k = 0; i < n; ++i) {
+            if (i == row)
+                continue;
+            for (std::size_t j = 0, l = 0; j < n; ++j)
+                if (j != col)
+                    result[k, l++] = matrix[i, j];
+            ++k;
+        }
+        return result;
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return the determinant of the given tensor. For 2x2 and 3x3 matrices, this uses the closed-form
+ *        expressions, while larger matrices are factorized with `lu_factorization` in O(n^3), or, for integral
+ *        entries, with fraction-free elimination. Thus, the type of the result does not depend on the size.
+ */
 template<tensorial T>
     requires(shape_of_t<T>{}.dimensions == 2)
 inline constexpr auto determinant_of(const T& tensor) noexcept {
     static constexpr auto rows = shape_of_t<T>{}.at(ic<0>);
     static constexpr auto cols = shape_of_t<T>{}.at(ic<1>);
     static_assert(rows == cols, "Determinant can only be computed for square matrices.");
-    static_assert(rows == 2 || rows == 3, "Determinant is only implemented for 2x2 & 3x3 matrices.");
 
     const auto _get = [&] <std::size_t... i> (const md_index<i...>& idx) constexpr noexcept {
         return access<T>::at(idx, tensor);
     };
 
-    if constexpr (rows == 2)
+    if constexpr (detail::is_triangular_v<T>)
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
+            return (... * _get(md_index<i, i>{}));
+        } (std::make_index_sequence<rows>{});
+    else if constexpr (rows == 1)
+        return _get(at<0, 0>());
+    else if constexpr (rows == 2)
         return _get(at<0, 0>())*_get(at<1, 1>()) - _get(at<1, 0>())*_get(at<0, 1>());
-    else
+    else if constexpr (rows == 3)
         return _get(at<0, 0>())*_get(at<1, 1>())*_get(at<2, 2>())
             + _get(at<0, 1>())*_get(at<1, 2>())*_get(at<2, 0>())
             + _get(at<0, 2>())*_get(at<1, 0>())*_get(at<2, 1>())
             - _get(at<0, 2>())*_get(at<1, 1>())*_get(at<2, 0>())
             - _get(at<0, 1>())*_get(at<1, 0>())*_get(at<2, 2>())
             - _get(at<0, 0>())*_get(at<1, 2>())*_get(at<2, 1>());
+    else if constexpr (std::is_integral_v<scalar_type_t<T>>)
+        return detail::bareiss_determinant_of<decltype(_get(at<0, 0>())*_get(at<0, 0>()))>(tensor);
+    else
+        return lu_factorization{detail::as_square_matrix(tensor)}.determinant();
+}
+
+//! Determinant (of type D) and cofactor matrix of a square matrix (see `determinant_and_cofactors_of`)
+template<typename T, std::size_t n, typename D = T>
+struct determinant_and_cofactors {
+    D determinant;
+    tensor<T, md_shape<n, n>> cofactors;
+};
+
+/*!
+ * \brief Return the determinant and the cofactor matrix `cof(A) = det(A)*A^-T` of the given square matrix, where the
+ *        latter is the derivative of the determinant (Jacobi's formula). Both are obtained from a single LU factorization.
+ *        For singular matrices, the cofactors are computed from the determinants of the minors instead. For integral
+ *        entries, the determinant is computed exactly (and of the same type) as with `determinant_of`.
+ */
+template<tensorial T>
+    requires(shape_of_t<T>{}.dimensions == 2)
+inline constexpr auto determinant_and_cofactors_of(const T& tensor) noexcept {
+    static constexpr std::size_t n = shape_of_t<T>{}.first();
+    static_assert(shape_of_t<T>{}.is_square, "Cofactors can only be computed for square matrices.");
+
+    using scalar = detail::factorization_scalar_t<T>;
+    using determinant_type = decltype(determinant_of(tensor));
+    const auto matrix = detail::as_square_matrix(tensor);
+    determinant_and_cofactors<scalar, n, determinant_type> result{
+        determinant_type{0}, linalg::tensor<scalar, md_shape<n, n>>{scalar{0}}
+    };
+    if constexpr (n == 1) {
+        result.determinant = access<T>::at(md_index<0, 0>{}, tensor);
+        result.cofactors[0, 0] = scalar{1};
+    } else {
+        const lu_factorization lu{matrix};
+        if (!lu.is_singular()) {
+            const scalar determinant = lu.determinant();
+            for (std::size_t j = 0; j < n; ++j) {
+                linalg::tensor<scalar, md_shape<n>> unit{scalar{0}};
+                unit[j] = scalar{1};
+                lu.solve_in_place(unit);  // j-th column of the inverse
+                for (std::size_t i = 0; i < n; ++i)
+                    result.cofactors[j, i] = determinant*unit[i];
+            }
+            if constexpr (std::is_integral_v<determinant_type>)
+                result.determinant = determinant_of(tensor);
+            else
+                result.determinant = determinant;
+        } else {
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    result.cofactors[i, j] = ((i + j)%2 == 0 ? scalar{1} : scalar{-1})
+                        *determinant_of(detail::minor_of(matrix, i, j));
+        }
+    }
+    return result;
+}
+
+//! Return the cofactor matrix `cof(A) = det(A)*A^-T` of the given square matrix (see `determinant_and_cofactors_of`)
+template<tensorial T>
+    requires(shape_of_t<T>{}.dimensions == 2)
+inline constexpr auto cofactors_of(const T& tensor) noexcept {
+    return determinant_and_cofactors_of(tensor).cofactors;
+}
+
+/*!
+ * \brief Return the derivatives of the cofactors of the given square matrix A w.r.t. its entries, i.e. the second
+ *        derivatives of its determinant. The entry `[i, j]` is the matrix of derivatives of `cof(A)[i, j]` w.r.t. `A`,
+ *        whose entry `[k, l]` is the signed determinant of A without the rows i, k and the columns j, l.
+ */
+template<tensorial T>
+    requires(shape_of_t<T>{}.dimensions == 2)
+inline constexpr auto cofactor_derivatives_of(const T& tensor) noexcept {
+    static constexpr std::size_t n = shape_of_t<T>{}.first();
+    static_assert(shape_of_t<T>{}.is_square, "Cofactors can only be computed for square matrices.");
+
+    using scalar = detail::factorization_scalar_t<T>;
+    using matrix_type = linalg::tensor<scalar, md_shape<n, n>>;
+    linalg::tensor<matrix_type, md_shape<n, n>> result{matrix_type{scalar{0}}};
+    if constexpr (n > 1) {
+        const auto matrix = detail::as_square_matrix(tensor);
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j) {
+                const auto minor = detail::minor_of(matrix, i, j);
+                for (std::size_t k = 0; k < n; ++k)
+                    for (std::size_t l = 0; l < n; ++l) {
+                        if (k == i || l == j)
+                            continue;
+                        // position of the entry (k, l) in the minor of (i, j)
+                        const std::size_t mk = k > i ? k - 1 : k;
+                        const std::size_t ml = l > j ? l - 1 : l;
+                        const scalar sign = (i + j + mk + ml)%2 == 0 ? scalar{1} : scalar{-1};
+                        if constexpr (n == 2)
+                            result[i, j][k, l] = sign;
+                        else
+                            result[i, j][k, l] = sign*determinant_of(detail::minor_of(minor, mk, ml));
+                    }
+            }
+    }
+    return result;
 }
 
 //! \} group LinearAlgebra
@@ -172,8 +1230,21 @@ inline constexpr auto determinant_of(const T& tensor) noexcept {
 
 namespace xp {
 
-template<typename T, typename shape>  // TODO: constrain on scalar T
-struct scalar_type<linalg::tensor<T, shape>> : std::type_identity<T> {};
+template<typename T, typename shape, typename storage>  // TODO: constrain on scalar T
+struct scalar_type<linalg::tensor<T, shape, storage>> : std::type_identity<T> {};
+template<typename T>
+struct scalar_type<linalg::transposed_view<T>> : scalar_type<T> {};
+template<typename T, std::size_t n>
+struct scalar_type<linalg::symmetric_tensor<T, n>> : std::type_identity<T> {};
+template<typename T, std::size_t n>
+struct scalar_type<linalg::diagonal_tensor<T, n>> : std::type_identity<T> {};
+template<typename T, typename shape, typename pattern>
+struct scalar_type<linalg::sparse_tensor<T, shape, pattern>> : std::type_identity<T> {};
+#ifdef __cpp_lib_mdspan
+template<typename T, typename I, std::size_t... e, typename layout, typename accessor>
+    requires(sizeof...(e) > 0 and (... and (e != std::dynamic_extent)))
+struct scalar_type<std::mdspan<T, std::extents<I, e...>, layout, accessor>> : std::type_identity<std::remove_cv_t<T>> {};
+#endif
 
 #ifndef DOXYGEN
 namespace detail {
@@ -187,6 +1258,8 @@ namespace detail {
     struct size_of;
     template<typename T, std::size_t s>
     struct size_of<std::array<T, s>> : std::integral_constant<std::size_t, s> {};
+    template<typename T, std::size_t s> requires(s != std::dynamic_extent)
+    struct size_of<std::span<T, s>> : std::integral_constant<std::size_t, s> {};
     template<detail::has_static_size T>
     struct size_of<T> : std::integral_constant<std::size_t, T::size> {};
     template<typename T> requires(is_complete_v<size_of<T>>)
@@ -206,20 +1279,48 @@ template<typename T>
 struct shape_of;
 template<typename T> requires(is_indexable_v<T> and is_complete_v<detail::size_of<T>>)
 struct shape_of<T> : detail::shape_of_indexable<T> {};
-template<typename T, typename shape>
-struct shape_of<linalg::tensor<T, shape>> : std::type_identity<shape> {};
+template<typename T, typename shape, typename storage>
+struct shape_of<linalg::tensor<T, shape, storage>> : std::type_identity<shape> {};
+template<typename T>
+struct shape_of<linalg::transposed_view<T>>
+: std::type_identity<md_shape<shape_of<T>::type::last(), shape_of<T>::type::first()>> {};
+template<typename T, std::size_t n>
+struct shape_of<linalg::symmetric_tensor<T, n>> : std::type_identity<md_shape<n, n>> {};
+template<typename T, std::size_t n>
+struct shape_of<linalg::diagonal_tensor<T, n>> : std::type_identity<md_shape<n, n>> {};
+template<typename T, typename shape, typename pattern>
+struct shape_of<linalg::sparse_tensor<T, shape, pattern>> : std::type_identity<shape> {};
+#ifdef __cpp_lib_mdspan
+template<typename T, typename I, std::size_t... e, typename layout, typename accessor>
+    requires(sizeof...(e) > 0 and (... and (e != std::dynamic_extent)))
+struct shape_of<std::mdspan<T, std::extents<I, e...>, layout, accessor>> : std::type_identity<md_shape<e...>> {};
+#endif
 template<typename T>
 using shape_of_t = typename shape_of<T>::type;
 
 template<typename T>
 struct access;
-template<typename T, typename shape>
-struct access<linalg::tensor<T, shape>> {
-    template<same_remove_cvref_t_as<linalg::tensor<T, shape>> _T, std::size_t... i>
+template<typename T, typename shape, typename storage>
+struct access<linalg::tensor<T, shape, storage>> {
+    template<same_remove_cvref_t_as<linalg::tensor<T, shape, storage>> _T, std::size_t... i>
     static constexpr decltype(auto) at(const md_index<i...>& idx, _T&& tensor) noexcept {
         return tensor[idx];
     }
 };
+template<typename T>
+struct access<linalg::transposed_view<T>> {
+    template<same_remove_cvref_t_as<linalg::transposed_view<T>> _T, std::size_t i, std::size_t j>
+    static constexpr decltype(auto) at(const md_index<i, j>&, _T&& view) noexcept {
+        return access<T>::at(md_index<j, i>{}, view.matrix());
+    }
+};
+template<typename T> requires(linalg::is_structured_v<T>)
+struct access<T> {
+    template<same_remove_cvref_t_as<T> _T, std::size_t... i>
+    static constexpr decltype(auto) at(const md_index<i...>& idx, _T&& tensor) noexcept {
+        return std::forward<_T>(tensor)[idx];
+    }
+};
 template<typename T> requires(is_indexable_v<T> and is_complete_v<shape_of<T>>)
 struct access<T> {
     template<same_remove_cvref_t_as<T> _T, std::size_t... i> requires(sizeof...(i) == shape_of_t<T>::dimensions)
@@ -236,5 +1337,17 @@ struct access<T> {
             return _at<is...>(t[i]);
     }
 };
+#ifdef __cpp_lib_mdspan
+//! Access into views with static extents, e.g. on externally owned memory (for any layout)
+template<typename T, typename I, std::size_t... e, typename layout, typename accessor>
+    requires(sizeof...(e) > 0 and (... and (e != std::dynamic_extent)))
+struct access<std::mdspan<T, std::extents<I, e...>, layout, accessor>> {
+    template<same_remove_cvref_t_as<std::mdspan<T, std::extents<I, e...>, layout, accessor>> _T, std::size_t... i>
+        requires(sizeof...(i) == sizeof...(e))
+    static constexpr decltype(auto) at(const md_index<i...>&, _T&& view) noexcept {
+        return view[static_cast<I>(i)...];
+    }
+};
+#endif
 
 }  // namespace xp
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Operators
+ * \brief Pluggable backends for the mathematical functions used by the default operators.
+ */
+#pragma once
+
+#include <cmath>
+#include <math.h>
+#include <type_traits>
+
+/*!
+ * \ingroup Operators
+ * \brief Annotation for functions that are callable from host and device code (e.g. in CUDA or HIP kernels).
+ *        Note that `constexpr` functions, i.e. the evaluation machinery of xpress, are implicitly callable on
+ *        devices with clang (and with nvcc if `--expt-relaxed-constexpr` is passed).
+ */
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define XP_HOST_DEVICE __host__ __device__
+#else
+#define XP_HOST_DEVICE
+#endif
+
+
+namespace xp::math {
+
+//! \addtogroup Operators
+//! \{
+
+//! Math backend using the functions of the C++ standard library
+struct std_backend {
+    template<typename T>
+    static XP_HOST_DEVICE constexpr auto log(const T& t) noexcept {
+        return std::log(t);
+    }
+
+    template<typename T>
+    static XP_HOST_DEVICE constexpr auto sqrt(const T& t) noexcept {
+        return std::sqrt(t);
+    }
+
+    template<typename A, typename B>
+    static XP_HOST_DEVICE constexpr auto pow(const A& a, const B& b) noexcept {
+        return std::pow(a, b);
+    }
+};
+
+//! Math backend using the C functions of `math.h`, which CUDA and HIP provide for both host and device code
+struct c_backend {
+    template<typename T>
+    static XP_HOST_DEVICE constexpr auto log(const T& t) noexcept {
+        if constexpr (std::is_same_v<T, float>)
+            return ::logf(t);
+        else if constexpr (std::is_same_v<T, long double>)
+            return ::logl(t);
+        else
+            return ::log(static_cast<double>(t));
+    }
+
+    template<typename T>
+    static XP_HOST_DEVICE constexpr auto sqrt(const T& t) noexcept {
+        if constexpr (std::is_same_v<T, float>)
+            return ::sqrtf(t);
+        else if constexpr (std::is_same_v<T, long double>)
+            return ::sqrtl(t);
+        else
+            return ::sqrt(static_cast<double>(t));
+    }
+
+    template<typename A, typename B>
+    static XP_HOST_DEVICE constexpr auto pow(const A& a, const B& b) noexcept {
+        using T = std::common_type_t<A, B>;
+        if constexpr (std::is_same_v<T, float>)
+            return ::powf(a, b);
+        else if constexpr (std::is_same_v<T, long double>)
+            return ::powl(a, b);
+        else
+            return ::pow(static_cast<double>(a), static_cast<double>(b));
+    }
+};
+
+/*!
+ * \brief The backend used for arithmetic types: by default, the C functions in device compilations (CUDA/HIP), and
+ *        the standard library otherwise. Define `XP_MATH_BACKEND` before including xpress to select another one, which
+ *        has to expose static `log`, `sqrt` and `pow` functions like `std_backend` does.
+ */
+#ifndef XP_MATH_BACKEND
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define XP_MATH_BACKEND ::xp::math::c_backend
+#else
+#define XP_MATH_BACKEND ::xp::math::std_backend
+#endif
+#endif
+
+//! Natural logarithm with the selected backend for arithmetic types, and overloads found via ADL for others (e.g. SIMD packs)
+template<typename T>
+inline XP_HOST_DEVICE constexpr auto log(const T& t) noexcept {
+    if constexpr (std::is_arithmetic_v<T>)
+        return XP_MATH_BACKEND::log(t);
+    else {
+        using std::log;
+        return log(t);
+    }
+}
+
+//! Square root with the selected backend for arithmetic types, and overloads found via ADL for others (e.g. SIMD packs)
+template<typename T>
+inline XP_HOST_DEVICE constexpr auto sqrt(const T& t) noexcept {
+    if constexpr (std::is_arithmetic_v<T>)
+        return XP_MATH_BACKEND::sqrt(t);
+    else {
+        using std::sqrt;
+        return sqrt(t);
+    }
+}
+
+//! Power with the selected backend for arithmetic types, and overloads found via ADL for others (e.g. SIMD packs)
+template<typename A, typename B>
+inline XP_HOST_DEVICE constexpr auto pow(const A& a, const B& b) noexcept {
+    if constexpr (std::is_arithmetic_v<A> and std::is_arithmetic_v<B>)
+        return XP_MATH_BACKEND::pow(a, b);
+    else {
+        using std::pow;
+        return pow(a, b);
+    }
+}
+
+//! Derivative of `pow(base, exponent)` w.r.t. the base, which is zero for a zero exponent (also at a zero base)
+template<typename T>
+inline XP_HOST_DEVICE constexpr T pow_base_derivative(const T& base, const T& exponent) noexcept {
+    if (exponent == T{0})
+        return T{0};
+    return exponent*static_cast<T>(math::pow(base, exponent - T{1}));
+}
+
+//! \} group Operators
+
+}  // namespace xp::math
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Stateful evaluation of expressions that only recomputes the nodes affected by changed values.
+ */
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "evaluation.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename B, typename nodes>
+    struct node_values_of;
+    template<typename B, typename... N>
+    struct node_values_of<B, type_list<N...>> : std::type_identity<std::tuple<node_value_t<N, B>...>> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Evaluator that caches the values of all unique nodes of an expression E (see `traits::evaluation_nodes_of_t`)
+ *        for the values bound to the symbols (or sub-expressions) of the bindings B. When some of the bound values are
+ *        updated, only the nodes that depend on them are recomputed on the next evaluation. The dependencies of each
+ *        node on the bound symbols are determined at compile-time.
+ */
+template<typename E, typename B>
+class memoizing_evaluator;
+
+template<typename E, typename... V>
+class memoizing_evaluator<E, bindings<V...>> {
+    using values_type = bindings<value_binder<typename V::symbol_type, typename V::value_type>...>;
+    using nodes = traits::evaluation_nodes_of_t<values_type, E>;
+    static constexpr std::size_t symbol_count = sizeof...(V);
+
+    // flags for the symbols the given node depends on
+    template<typename N>
+    static constexpr std::array<bool, symbol_count> dependencies_of{
+        traits::detail::contains_equal_node<typename V::symbol_type, traits::unique_nodes_of_t<N>>::value...
+    };
+
+    // dependencies[i][s] is true if the i-th node depends on the value bound to the s-th symbol
+    static constexpr auto dependencies = [] <typename... N> (const type_list<N...>&) {
+        return std::array<std::array<bool, symbol_count>, sizeof...(N)>{dependencies_of<N>...};
+    } (nodes{});
+
+    using node_values_type = typename detail::node_values_of<values_type, nodes>::type;
+
+ public:
+    constexpr memoizing_evaluator(const E&, const bindings<V...>& values) noexcept
+    : _values{std::as_const(values)[typename V::symbol_type{}]...}
+    {
+        std::ranges::fill(_is_dirty, true);
+        _update_nodes();
+    }
+
+    //! Update the values bound to the given symbols (the nodes depending on them are recomputed on the next evaluation)
+    template<binder... Bs>
+    constexpr void update(Bs&&... binders) noexcept {
+        static_assert(
+            (... and values_type::template has_bindings_for<typename std::remove_cvref_t<Bs>::symbol_type>),
+            "Only values bound on construction can be updated."
+        );
+        (..., _update(typename std::remove_cvref_t<Bs>::symbol_type{}, std::forward<Bs>(binders).get()));
+    }
+
+    //! Return the value of the expression, recomputing the nodes that depend on updated values
+    constexpr decltype(auto) value() noexcept {
+        _update_nodes();
+        return detail::cached_value_of(E{}, _bindings());
+    }
+
+    //! Update the given values and return the value of the expression
+    template<binder... Bs>
+    constexpr decltype(auto) at(Bs&&... binders) noexcept {
+        update(std::forward<Bs>(binders)...);
+        return value();
+    }
+
+    //! Return the number of nodes that were recomputed in the last evaluation
+    constexpr std::size_t recomputed_node_count() const noexcept {
+        return _recomputed_count;
+    }
+
+    //! Return the number of (unique) nodes whose values are cached
+    static constexpr std::size_t node_count() noexcept {
+        return nodes::size;
+    }
+
+ private:
+    template<typename S, typename T>
+    constexpr void _update(const S&, T&& value) noexcept {
+        constexpr std::size_t s = detail::index_of_equal_node<S, type_list<typename V::symbol_type...>>::value;
+        std::get<s>(_values) = std::forward<T>(value);
+        _is_dirty[s] = true;
+    }
+
+    // bindings that refer to the current values of the symbols and the cached values of the nodes
+    constexpr auto _bindings() const noexcept {
+        return [&] <typename... N, std::size_t... s, std::size_t... i> (
+            const type_list<N...>&, const std::index_sequence<s...>&, const std::index_sequence<i...>&
+        ) {
+            return bindings{
+                value_binder{typename V::symbol_type{}, std::get<s>(_values)}...,
+                value_binder{N{}, std::get<i>(_node_values)}...
+            };
+        } (nodes{}, std::index_sequence_for<V...>{}, std::make_index_sequence<nodes::size>{});
+    }
+
+    constexpr void _update_nodes() noexcept {
+        _recomputed_count = 0;
+        [&] <typename... N, std::size_t... i> (const type_list<N...>&, const std::index_sequence<i...>&) {
+            (..., [&] () {
+                const bool is_dirty = [&] <std::size_t... s> (const std::index_sequence<s...>&) {
+                    return (false || ... || (dependencies[i][s] && _is_dirty[s]));
+                } (std::index_sequence_for<V...>{});
+                if (is_dirty) {
+                    std::get<i>(_node_values) = detail::value_from_children(N{}, _bindings());
+                    ++_recomputed_count;
+                }
+            } ());
+        } (nodes{}, std::make_index_sequence<nodes::size>{});
+        std::ranges::fill(_is_dirty, false);
+    }
+
+    std::tuple<typename V::value_type...> _values;
+    node_values_type _node_values{};
+    std::array<bool, symbol_count> _is_dirty{};
+    std::size_t _recomputed_count = 0;
+};
+
+template<typename E, typename... V>
+memoizing_evaluator(const E&, const bindings<V...>&) -> memoizing_evaluator<E, bindings<V...>>;
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -9,6 +9,7 @@
 
 #include "traits.hpp"
 #include "concepts.hpp"
+#include "evaluation.hpp"
 #include "operators/add.hpp"
 #include "operators/subtract.hpp"
 #include "operators/multiply.hpp"
@@ -35,11 +35,21 @@ struct addition_of<T1, T2> {
     constexpr auto operator()(_T1&& A, _T2&& B) const noexcept {
         using scalar = std::common_type_t<scalar_type_t<T1>, scalar_type_t<T2>>;
         using shape = shape_of_t<T1>;
-        linalg::tensor<scalar, shape> result{};
-        visit_indices_in(shape{}, [&] (const auto& idx) {
-            result[idx] = access<T1>::at(idx, A) + access<T2>::at(idx, B);
-        });
-        return result;
+        if constexpr (linalg::is_tensor_v<T1> and linalg::is_tensor_v<T2>) {
+            return linalg::transformed([] (const auto& a, const auto& b) constexpr {
+                return static_cast<scalar>(a + b);
+            }, A, B);
+        } else if constexpr (linalg::have_same_structure_v<T1, T2>) {
+            return linalg::transformed_structured([] (const auto& a, const auto& b) constexpr {
+                return static_cast<scalar>(a + b);
+            }, A, B);
+        } else {
+            linalg::tensor<scalar, shape> result{};
+            visit_indices_in(shape{}, [&] (const auto& idx) {
+                result[idx] = access<T1>::at(idx, A) + access<T2>::at(idx, B);
+            });
+            return result;
+        }
     }
 };
 
@@ -47,10 +57,53 @@ struct addition_of<T1, T2> {
 
 struct add : operator_base<traits::addition_of, std::plus<void>> {};
 
-namespace traits { template<> struct is_commutative<add> : std::true_type {}; }
+namespace traits {
+template<> struct is_commutative<add> : std::true_type {};
+template<> struct is_associative<add> : std::true_type {};
+template<bool... t> struct is_elementwise<add, t...> : std::bool_constant<(... and t)> {};
+}  // namespace traits
 
 }  // namespace operators
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct is_nonzero_term : std::bool_constant<!traits::is_zero_value_v<T>> {};
+
+    template<typename... Ts>
+    inline constexpr auto sum_of(const type_list<Ts...>&) noexcept {
+        if constexpr (sizeof...(Ts) == 0)
+            return val<0>;
+        else if constexpr (sizeof...(Ts) == 1)
+            return first_t<type_list<Ts...>>{};
+        else
+            return operation<operators::add, Ts...>{};
+    }
+
+    template<typename T>
+    struct is_nary_sum : std::false_type {};
+    template<typename T0, typename T1, typename T2, typename... Ts>
+    struct is_nary_sum<operation<operators::add, T0, T1, T2, Ts...>> : std::true_type {};
+
+    template<typename... Ts, typename B>
+    inline constexpr auto appended(const operation<operators::add, Ts...>&, const B&) noexcept {
+        return operation<operators::add, Ts..., B>{};
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return the (flat) sum of all given terms, omitting terms that are zero.
+ *        In contrast to chains of binary additions, e.g. `a + b + c + ...`, this yields a single n-ary addition,
+ *        which reduces the depth of the expression tree and, for scalar operands, is evaluated with a pairwise reduction.
+ */
+template<expression... Ts>
+inline constexpr auto sum(const Ts&...) noexcept {
+    return detail::sum_of(filtered_list_t<detail::is_nonzero_term, type_list<Ts...>>{});
+}
+
 template<expression A, expression B>
     requires( not requires(const A& a, const B& b) { { a.operator+(b) }; } )
 inline constexpr auto operator+(const A&, const B&) noexcept {
@@ -60,6 +113,8 @@ inline constexpr auto operator+(const A&, const B&) noexcept {
         return A{};
     else if constexpr (std::is_same_v<A, B>)
         return val<2>*A{};
+    else if constexpr (detail::is_nary_sum<A>::value)  // keep n-ary sums flat
+        return detail::appended(A{}, B{});
     else
         return operation<operators::add, A, B>{};
 }
@@ -74,13 +129,25 @@ struct derivative_of<operation<operators::add, T1, T2>> {
     }
 };
 
-template<typename T1, typename T2>
-struct stream<operation<operators::add, T1, T2>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
-        write_to(out, T1{}, values);
-        out << " + ";
-        write_to(out, T2{}, values);
+template<typename T0, typename T1, typename T2, typename... Ts>
+struct derivative_of<operation<operators::add, T0, T1, T2, Ts...>> {
+    template<typename V>
+    static constexpr auto wrt(const type_list<V>& var) noexcept {
+        return xp::sum(
+            xp::detail::differentiate<T0>(var),
+            xp::detail::differentiate<T1>(var),
+            xp::detail::differentiate<T2>(var),
+            xp::detail::differentiate<Ts>(var)...
+        );
+    }
+};
+
+template<typename T0, typename... Ts>
+struct stream<operation<operators::add, T0, Ts...>> {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
+        write_to(out, T0{}, values);
+        (..., (out << " + ", write_to(out, Ts{}, values)));
     }
 };
 
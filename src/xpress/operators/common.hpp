@@ -7,10 +7,13 @@
  */
 #pragma once
 
+#include <tuple>
+#include <utility>
 #include <type_traits>
 
 #include "../utils.hpp"
 #include "../traits.hpp"
+#include "../linalg.hpp"
 
 
 namespace xp {
@@ -25,11 +28,29 @@ namespace traits {
 template<typename op>
 struct is_commutative : std::false_type {};
 
+/*!
+ * \brief Trait to register an operator as associative (and commutative) for operands of any type, such that the
+ *        operands of n-ary operations may be permuted without changing the result (see `is_equal_node`).
+ */
+template<typename op>
+struct is_associative : std::false_type {};
+
+/*!
+ * \brief Trait to register an operator as acting element-wise on tensors, if applied to operands of which
+ *        those flagged with `true` are tensors (of equal shape), and the remaining ones scalars.
+ *        Trees of such operations on dense tensors are evaluated in a single fused loop.
+ */
+template<typename op, bool... is_tensor_operand>
+struct is_elementwise : std::false_type {};
+
 }  // namespace traits
 
 template<typename op>
 inline constexpr bool is_commutative_v = traits::is_commutative<op>::value;
 
+template<typename op>
+inline constexpr bool is_associative_v = traits::is_associative<op>::value;
+
 //! Base class that may be reused by operator implementations
 template<template<typename...> typename trait, typename default_operator>
 struct operator_base {
@@ -50,6 +71,45 @@ struct operator_base {
 
 }  // namespace operators
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<std::size_t begin, std::size_t end, typename op, typename V>
+    inline constexpr auto pairwise_reduced(const op& o, const V& values) noexcept {
+        if constexpr (end - begin == 1)
+            return std::get<begin>(values);
+        else {
+            constexpr std::size_t mid = begin + (end - begin)/2;
+            return o(pairwise_reduced<begin, mid>(o, values), pairwise_reduced<mid, end>(o, values));
+        }
+    }
+
+    template<typename op, typename V>
+    inline constexpr auto left_folded(const op&, V&& value) noexcept {
+        return std::forward<V>(value);
+    }
+
+    template<typename op, typename V0, typename V1, typename... V>
+    inline constexpr auto left_folded(const op& o, V0&& v0, V1&& v1, V&&... values) noexcept {
+        return left_folded(o, o(std::forward<V0>(v0), std::forward<V1>(v1)), std::forward<V>(values)...);
+    }
+
+    // apply an operator to the given operand values, where n-ary operations on scalars are reduced pairwise such
+    // that the intermediate results do not depend on each other (allowing for instruction-level parallelism).
+    // Operations on non-scalars (e.g. products of tensors, which are scalar products) are folded in operand order.
+    template<typename op, typename... V>
+    inline constexpr decltype(auto) apply_operator(const op& o, V&&... values) noexcept {
+        if constexpr (sizeof...(V) > 2 and (... and is_scalar_v<std::remove_cvref_t<V>>))
+            return pairwise_reduced<0, sizeof...(V)>(o, std::forward_as_tuple(std::forward<V>(values)...));
+        else if constexpr (sizeof...(V) > 2)
+            return left_folded(o, std::forward<V>(values)...);
+        else
+            return o(std::forward<V>(values)...);
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 //! Represents an expression resulting from an operator applied to the given terms
 template<typename op, expression... Ts>
 struct operation : bindable<traits::common_dtype_t<traits::dtype_of_t<Ts>...>>, negatable {
@@ -69,11 +129,177 @@ template<typename op, typename T1, typename T2>
     requires(operators::is_commutative_v<op>)
 struct is_equal_node<operation<op, T1, T2>, operation<op, T2, T1>> : std::true_type {};
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T, typename... Ts>
+    inline constexpr std::size_t equal_node_count_v = (std::size_t{0} + ... + std::size_t{is_equal_node_v<T, Ts>});
+
+    template<typename A, typename B>
+    struct is_permutation;
+    template<typename... A, typename... B>
+    struct is_permutation<type_list<A...>, type_list<B...>>
+    : std::bool_constant<(... and (equal_node_count_v<A, A...> == equal_node_count_v<A, B...>))> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! n-ary associative operations are equal if their operands are permutations of each other
+template<typename op, typename... T1, typename... T2>
+    requires(operators::is_associative_v<op> and sizeof...(T1) == sizeof...(T2) and sizeof...(T1) > 2)
+struct is_equal_node<operation<op, T1...>, operation<op, T2...>>
+: detail::is_permutation<type_list<T1...>, type_list<T2...>> {};
+
+template<typename op, typename... Ts>
+struct children_of<operation<op, Ts...>> : std::type_identity<type_list<Ts...>> {};
+
+template<typename op, typename... Ts>
+struct operator_of<operation<op, Ts...>> : std::type_identity<op> {};
+
 template<typename op, typename T, typename... Ts>
 struct nodes_of<operation<op, T, Ts...>> {
-    using type = merged_t<type_list<operation<op, T, Ts...>>, merged_nodes_of_t<T, Ts...>>;
+    using type = concatenated_t<type_list<operation<op, T, Ts...>>, nodes_of_t<T>, nodes_of_t<Ts>...>;
 };
 
+/*!
+ * \brief Trait to compute the value of an operation from the values of its operands. This can be specialized for
+ *        operations with compile-time constant operands, for which cheaper evaluations exist (see e.g. `pow`).
+ */
+template<typename T>
+struct value_from_operands;
+template<typename op, typename... Ts>
+struct value_from_operands<operation<op, Ts...>> {
+    template<typename... V>
+    static constexpr decltype(auto) from(V&&... values) noexcept {
+        return xp::detail::apply_operator(op{}, std::forward<V>(values)...);
+    }
+};
+
+}  // namespace traits
+
+
+#ifndef DOXYGEN
+namespace detail::fusion {
+
+    template<typename T, typename list, std::size_t i = 0>
+    struct index_of;
+    template<typename T, typename T0, typename... Ts, std::size_t i>
+    struct index_of<T, type_list<T0, Ts...>, i>
+    : std::conditional_t<std::is_same_v<T, T0>, std::integral_constant<std::size_t, i>, index_of<T, type_list<Ts...>, i+1>> {};
+
+    // shape of the first tensor among the given node infos (or void)
+    template<typename... I>
+    struct tensor_shape_of : std::type_identity<void> {};
+    template<typename I0, typename... I>
+    struct tensor_shape_of<I0, I...>
+    : std::conditional_t<I0::is_tensor, std::type_identity<typename I0::shape>, tensor_shape_of<I...>> {};
+
+    // common scalar type of the tensors among the given node infos (or void)
+    template<typename R, typename... I>
+    struct tensor_element_of : std::type_identity<R> {};
+    template<typename R, typename I0, typename... I>
+    struct tensor_element_of<R, I0, I...> : tensor_element_of<
+        std::conditional_t<!I0::is_tensor, R, typename std::conditional_t<
+            std::is_void_v<R>,
+            std::type_identity<typename I0::element_type>,
+            std::common_type<R, typename I0::element_type>
+        >::type>,
+        I...
+    > {};
+
+    template<typename N, typename B>
+    struct is_candidate : std::false_type {};
+    template<typename op, typename... Ts, typename B>
+        requires(sizeof...(Ts) > 0 and !B::template has_bindings_for<operation<op, Ts...>>)
+    struct is_candidate<operation<op, Ts...>, B> : std::true_type {};
+
+    template<typename N, typename B>
+    struct is_fusable;
+
+    // leaves of fused trees are evaluated as usual, and their values have to be dense tensors or scalars
+    template<typename N, typename B, bool = is_fusable<N, B>::value>
+    struct node_info {
+        using value_type = std::remove_cvref_t<decltype(xp::value_of(N{}, std::declval<const B&>()))>;
+        static constexpr bool is_fused = false;
+        static constexpr bool is_tensor = linalg::is_tensor_v<value_type>;
+        static constexpr bool is_scalar = is_scalar_v<value_type>;
+        using element_type = typename std::conditional_t<is_tensor, scalar_type<value_type>, std::type_identity<value_type>>::type;
+        using shape = typename std::conditional_t<is_tensor, shape_of<value_type>, std::type_identity<void>>::type;
+        using leaves = type_list<N>;
+    };
+
+    // element-wise operations on tensors and scalars that are fused into the evaluation loop of their root
+    template<typename op, typename... Ts, typename B>
+    struct node_info<operation<op, Ts...>, B, true> {
+        static constexpr bool is_fused = true;
+        static constexpr bool is_tensor = true;
+        static constexpr bool is_scalar = false;
+        using element_type = typename tensor_element_of<void, node_info<Ts, B>...>::type;
+        using shape = typename tensor_shape_of<node_info<Ts, B>...>::type;
+        using leaves = typename concatenated<typename node_info<Ts, B>::leaves...>::type;
+    };
+
+    template<typename N, typename B>
+    struct is_fusable : std::false_type {};
+    template<typename op, typename... Ts, typename B>
+        requires(is_candidate<operation<op, Ts...>, B>::value)
+    struct is_fusable<operation<op, Ts...>, B> {
+     private:
+        using shape = typename tensor_shape_of<node_info<Ts, B>...>::type;
+
+     public:
+        static constexpr bool value = (... or node_info<Ts, B>::is_tensor)
+            and (... and (node_info<Ts, B>::is_tensor or node_info<Ts, B>::is_scalar))
+            and (... and (!node_info<Ts, B>::is_tensor or std::is_same_v<typename node_info<Ts, B>::shape, shape>))
+            and operators::traits::is_elementwise<op, node_info<Ts, B>::is_tensor...>::value;
+    };
+
+    // fuse at the roots of element-wise trees that contain more than one operation
+    template<typename N, typename B>
+    struct is_root : std::false_type {};
+    template<typename op, typename... Ts, typename B>
+        requires(is_fusable<operation<op, Ts...>, B>::value)
+    struct is_root<operation<op, Ts...>, B> : std::bool_constant<(... or node_info<Ts, B>::is_fused)> {};
+
+    template<typename N, typename B, typename L, typename V>
+    inline constexpr auto element_of(std::size_t i, const V& leaf_values) noexcept {
+        using info = node_info<N, B>;
+        if constexpr (info::is_fused) {
+            return [&] <typename op, typename... Ts> (const operation<op, Ts...>&) constexpr {
+                return static_cast<typename info::element_type>(
+                    traits::value_from_operands<N>::from(element_of<Ts, B, L>(i, leaf_values)...)
+                );
+            } (N{});
+        } else {
+            const auto& value = std::get<index_of<N, L>::value>(leaf_values);
+            if constexpr (info::is_tensor)
+                return value.data()[i];
+            else
+                return value;
+        }
+    }
+
+    // evaluate a tree of element-wise operations in a single loop, writing each element of the result once
+    template<typename N, typename... V>
+    inline constexpr auto fused_value_of(const N&, const bindings<V...>& values) noexcept {
+        using B = bindings<V...>;
+        using info = node_info<N, B>;
+        return [&] <typename... L> (const type_list<L...>&) constexpr {
+            const std::tuple<decltype(xp::value_of(L{}, values))...> leaf_values{xp::value_of(L{}, values)...};
+            linalg::tensor<typename info::element_type, typename info::shape> result;
+            auto* out = result.data();
+            for (std::size_t i = 0; i < info::shape::count; ++i)
+                out[i] = element_of<N, B, type_list<L...>>(i, leaf_values);
+            return result;
+        } (unique_t<typename info::leaves>{});
+    }
+
+}  // namespace detail::fusion
+#endif  // DOXYGEN
+
+
+namespace traits {
+
 template<typename op, typename... Ts>
 struct value_of<operation<op, Ts...>> {
     template<typename... V>
@@ -81,8 +307,10 @@ struct value_of<operation<op, Ts...>> {
         using self = operation<op, Ts...>;
         if constexpr (bindings<V...>::template has_bindings_for<self>)
             return binders[self{}];
+        else if constexpr (xp::detail::fusion::is_root<self, bindings<V...>>::value)
+            return xp::detail::fusion::fused_value_of(self{}, binders);
         else
-            return op{}(xp::value_of(Ts{}, binders)...);
+            return value_from_operands<self>::from(xp::value_of(Ts{}, binders)...);
     }
 };
 
@@ -23,7 +23,29 @@ namespace xp {
 
 namespace operators {
 
-namespace traits { template<typename T> struct determinant_of; }
+namespace traits {
+template<typename T> struct determinant_of;
+template<typename T> struct cofactors_of;
+template<typename T> struct determinant_and_cofactors_of;
+template<typename T> struct cofactor_derivatives_of;
+
+//! Specialization to extract the determinant from a joint factorization (see `determinant_and_cofactors`)
+template<typename T, std::size_t n, typename D>
+struct determinant_of<linalg::determinant_and_cofactors<T, n, D>> {
+    constexpr D operator()(const linalg::determinant_and_cofactors<T, n, D>& d) const noexcept {
+        return d.determinant;
+    }
+};
+
+//! Specialization to extract the cofactors from a joint factorization (see `determinant_and_cofactors`)
+template<typename T, std::size_t n, typename D>
+struct cofactors_of<linalg::determinant_and_cofactors<T, n, D>> {
+    constexpr const auto& operator()(const linalg::determinant_and_cofactors<T, n, D>& d) const noexcept {
+        return d.cofactors;
+    }
+};
+
+}  // namespace traits
 
 struct default_determinant_operator {
     template<tensorial T>
@@ -32,33 +54,92 @@ struct default_determinant_operator {
     }
 };
 
+struct default_cofactors_operator {
+    template<tensorial T>
+    constexpr auto operator()(T&& t) const noexcept {
+        return linalg::cofactors_of(std::forward<T>(t));
+    }
+};
+
+struct default_determinant_and_cofactors_operator {
+    template<tensorial T>
+    constexpr auto operator()(T&& t) const noexcept {
+        return linalg::determinant_and_cofactors_of(std::forward<T>(t));
+    }
+};
+
+struct default_cofactor_derivatives_operator {
+    template<tensorial T>
+    constexpr auto operator()(T&& t) const noexcept {
+        return linalg::cofactor_derivatives_of(std::forward<T>(t));
+    }
+};
+
 struct determinant : operator_base<traits::determinant_of, default_determinant_operator> {};
+struct cofactors : operator_base<traits::cofactors_of, default_cofactors_operator> {};
+struct determinant_and_cofactors : operator_base<traits::determinant_and_cofactors_of, default_determinant_and_cofactors_operator> {};
+struct cofactor_derivatives : operator_base<traits::cofactor_derivatives_of, default_cofactor_derivatives_operator> {};
 
 }  // namespace operators
 
+#ifndef DOXYGEN
+namespace detail {
+
+    // matrices larger than 3x3 are factorized, and the determinant and its derivative share a single factorization
+    template<typename T>
+    inline constexpr bool is_factorized_for_determinant_v = shape_of_t<T>{}.first() > 3;
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return an expression for the determinant of the given matrix expression. For matrices larger than 3x3,
+ *        it is computed from an LU factorization that is shared with its derivative (see `cofactors`).
+ */
 template<tensorial_expression T>
 inline constexpr auto det(const T&) noexcept {
     static_assert(shape_of_t<T>{}.is_square, "Determinant can only be taken on square matrices.");
-    return operation<operators::determinant, T>{};
+    if constexpr (detail::is_factorized_for_determinant_v<T>)
+        return operation<operators::determinant, operation<operators::determinant_and_cofactors, T>>{};
+    else
+        return operation<operators::determinant, T>{};
+}
+
+/*!
+ * \brief Return an expression for the cofactor matrix `det(T)*T^-T` of the given matrix expression,
+ *        which is the derivative of its determinant. In contrast to `det`, its value is a tensor.
+ */
+template<tensorial_expression T>
+inline constexpr auto cofactors(const T&) noexcept {
+    static_assert(shape_of_t<T>{}.is_square, "Cofactors can only be taken on square matrices.");
+    if constexpr (detail::is_factorized_for_determinant_v<T>)
+        return operation<operators::cofactors, operation<operators::determinant_and_cofactors, T>>{};
+    else
+        return operation<operators::cofactors, T>{};
 }
 
 namespace traits {
 
+template<> struct operator_cost<operators::determinant> : std::integral_constant<std::size_t, 10> {};
+template<> struct operator_cost<operators::cofactors> : std::integral_constant<std::size_t, 20> {};
+template<> struct operator_cost<operators::determinant_and_cofactors> : std::integral_constant<std::size_t, 20> {};
+template<> struct operator_cost<operators::cofactor_derivatives> : std::integral_constant<std::size_t, 40> {};
+
 template<tensorial_expression T>
 struct derivative_of<operation<operators::determinant, T>> {
     static constexpr auto t_shape = shape_of_t<T>{};
     static_assert(t_shape.is_square, "Determinant derivative can only be computed for square matrices.");
-    static_assert(t_shape.first() == 2 || t_shape.first() == 3, "Determinant derivative is only implemented for 2d & 3d matrices.");
-    static_assert(t_shape.last() == 2 || t_shape.last(), "Determinant derivative is only implemented for 2d & 3d matrices.");
 
     template<typename V>
     static constexpr decltype(auto) wrt(const type_list<V>&) {
         if constexpr (std::is_same_v<V, T>) {
-            if constexpr (t_shape.first() == 2) {
+            if constexpr (t_shape.first() == 1) {
+                return tensor_expression{shape<1, 1>, val<1>};
+            } else if constexpr (t_shape.first() == 2) {
                 constexpr auto a = T{}[at<0, 0>()]; constexpr auto b = T{}[at<0, 1>()];
                 constexpr auto c = T{}[at<1, 0>()]; constexpr auto d = T{}[at<1, 1>()];
                 return tensor_expression{shape<2, 2>, d, -c, -b, a};
-            } else {
+            } else if constexpr (t_shape.first() == 3) {
                 constexpr auto a = T{}[at<0, 0>()]; constexpr auto b = T{}[at<0, 1>()]; constexpr auto c = T{}[at<0, 2>()];
                 constexpr auto d = T{}[at<1, 0>()]; constexpr auto e = T{}[at<1, 1>()]; constexpr auto f = T{}[at<1, 2>()];
                 constexpr auto g = T{}[at<2, 0>()]; constexpr auto h = T{}[at<2, 1>()]; constexpr auto i = T{}[at<2, 2>()];
@@ -67,6 +148,9 @@ struct derivative_of<operation<operators::determinant, T>> {
                     c*h - b*i, a*i - c*g, b*g - a*h,
                     b*f - c*e, c*d - a*f, a*e - b*d
                 };
+            } else {
+                // expanding the cofactors symbolically does not scale, so use Jacobi's formula on the values
+                return operation<operators::cofactors, T>{};
             }
         } else {
             return val<0>;
@@ -74,14 +158,73 @@ struct derivative_of<operation<operators::determinant, T>> {
     }
 };
 
-template<tensorial_expression T>
+template<expression T>
 struct stream<operation<operators::determinant, T>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
         out << "det("; write_to(out, T{}, values); out << ")";
     }
 };
 
+template<tensorial_expression T>
+struct derivative_of<operation<operators::determinant, operation<operators::determinant_and_cofactors, T>>> {
+    template<typename V>
+    static constexpr decltype(auto) wrt(const type_list<V>&) {
+        if constexpr (std::is_same_v<V, T>)
+            return operation<operators::cofactors, operation<operators::determinant_and_cofactors, T>>{};
+        else
+            return val<0>;
+    }
+};
+
+template<tensorial_expression T>
+struct derivative_of<operation<operators::cofactors, T>> {
+    template<typename V>
+    static constexpr decltype(auto) wrt(const type_list<V>&) {
+        if constexpr (std::is_same_v<V, T>)
+            return operation<operators::cofactor_derivatives, T>{};
+        else
+            return val<0>;
+    }
+};
+
+template<tensorial_expression T>
+struct derivative_of<operation<operators::cofactors, operation<operators::determinant_and_cofactors, T>>>
+: derivative_of<operation<operators::cofactors, T>> {};
+
+template<tensorial_expression T>
+struct derivative_of<operation<operators::cofactor_derivatives, T>> {
+    template<typename V>
+    static constexpr decltype(auto) wrt(const type_list<V>&) {
+        static_assert(!std::is_same_v<V, T>, "Third derivatives of determinants are not implemented.");
+        return val<0>;
+    }
+};
+
+template<tensorial_expression T>
+struct stream<operation<operators::determinant_and_cofactors, T>> {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
+        write_to(out, T{}, values);
+    }
+};
+
+template<expression T>
+struct stream<operation<operators::cofactors, T>> {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
+        out << "cof("; write_to(out, T{}, values); out << ")";
+    }
+};
+
+template<tensorial_expression T>
+struct stream<operation<operators::cofactor_derivatives, T>> {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
+        out << "dcof("; write_to(out, T{}, values); out << ")";
+    }
+};
+
 }  // namespace traits
 
 //! \} group Operators
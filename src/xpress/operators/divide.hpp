@@ -7,7 +7,9 @@
  */
 #pragma once
 
+#include <utility>
 #include <functional>
+#include <type_traits>
 
 #include "../values.hpp"
 #include "../expressions.hpp"
@@ -31,13 +33,31 @@ struct division_of;
 template<tensorial T, typename S> requires(is_scalar_v<S>)
 struct division_of<T, S> {
     template<same_remove_cvref_t_as<T> _T, same_remove_cvref_t_as<S> _S>
-    constexpr T operator()(_T&& tensor, _S&& scalar) const noexcept {
-        T result;
-        visit_indices_in(shape_of_t<T>{}, [&] (const auto& idx) {
-            scalar_type_t<T>& value_at_idx = access<T>::at(idx, result);
-            value_at_idx = access<T>::at(idx, tensor)/scalar;
-        });
-        return result;
+    constexpr auto operator()(_T&& tensor, _S&& scalar) const noexcept {
+        if constexpr (linalg::is_tensor_v<T>) {
+            return linalg::transformed([&] (const scalar_type_t<T>& v) constexpr {
+                return static_cast<scalar_type_t<T>>(v/scalar);
+            }, tensor);
+        } else if constexpr (linalg::is_structured_v<T>) {
+            // structural zeros remain zero
+            return linalg::transformed_structured([&] (const scalar_type_t<T>& v) constexpr {
+                return static_cast<scalar_type_t<T>>(v/scalar);
+            }, tensor);
+        } else if constexpr (std::is_default_constructible_v<T>) {
+            T result;
+            visit_indices_in(shape_of_t<T>{}, [&] (const auto& idx) {
+                scalar_type_t<T>& value_at_idx = access<T>::at(idx, result);
+                value_at_idx = access<T>::at(idx, tensor)/scalar;
+            });
+            return result;
+        } else {
+            // e.g. views on external memory, which cannot hold the result
+            linalg::tensor<scalar_type_t<T>, shape_of_t<T>> result{};
+            visit_indices_in(shape_of_t<T>{}, [&] (const auto& idx) {
+                result[idx] = access<T>::at(idx, tensor)/scalar;
+            });
+            return result;
+        }
     }
 };
 
@@ -45,6 +65,8 @@ struct division_of<T, S> {
 
 struct divide : operator_base<traits::division_of, std::divides<void>> {};
 
+namespace traits { template<> struct is_elementwise<divide, true, false> : std::true_type {}; }
+
 }  // namespace operators
 
 template<expression A, expression B>
@@ -63,6 +85,23 @@ inline constexpr auto operator/(const A&, const B&) noexcept {
 
 namespace traits {
 
+template<> struct operator_cost<operators::divide> : std::integral_constant<std::size_t, 4> {};
+
+//! Divisions of floating-point values by constants are evaluated as multiplications with the (precomputed) reciprocal
+template<typename T, auto c> requires(c != 0)
+struct value_from_operands<operation<operators::divide, T, value<c>>> {
+    template<typename A, typename C>
+    static constexpr auto from(A&& a, C&& divisor) noexcept {
+        using scalar = std::remove_cvref_t<A>;
+        if constexpr (std::is_floating_point_v<scalar>) {
+            constexpr scalar reciprocal = scalar{1}/static_cast<scalar>(c);
+            return a*reciprocal;
+        } else {
+            return xp::detail::apply_operator(operators::divide{}, std::forward<A>(a), std::forward<C>(divisor));
+        }
+    }
+};
+
 template<typename T1, typename T2>
 struct derivative_of<operation<operators::divide, T1, T2>> {
     template<typename V>
@@ -73,8 +112,8 @@ struct derivative_of<operation<operators::divide, T1, T2>> {
 
 template<typename T1, typename T2>
 struct stream<operation<operators::divide, T1, T2>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
         static constexpr bool has_subterms_1 = nodes_of_t<T1>::size > 1;
         if constexpr (has_subterms_1) out << "(";
         write_to(out, T1{}, values);
@@ -8,11 +8,15 @@
 #pragma once
 
 #include <cmath>
+#include <type_traits>
 
+#include "../math.hpp"
 #include "../values.hpp"
 #include "../expressions.hpp"
 #include "../linalg.hpp"
 #include "common.hpp"
+#include "multiply.hpp"
+#include "pow.hpp"
 
 
 namespace xp {
@@ -24,15 +28,18 @@ namespace operators {
 
 namespace traits { template<typename A> struct log_of; }
 
+//! Default implementation, which uses the selected math backend (see `math::log`), or overloads for e.g. SIMD pack types
 struct default_log_operator {
     template<typename A>
-    constexpr auto operator()(A&& a) const noexcept {
-        return std::log(std::forward<A>(a));
+    XP_HOST_DEVICE constexpr auto operator()(const A& a) const noexcept {
+        return math::log(a);
     }
 };
 
 struct log : operator_base<traits::log_of, default_log_operator> {};
 
+namespace traits { template<> struct is_elementwise<log, true> : std::true_type {}; }
+
 namespace traits {
 
 //! (Default) specialization for tensors
@@ -42,11 +49,21 @@ struct log_of<T> {
     constexpr auto operator()(_T&& t) const noexcept {
         using scalar = scalar_type_t<T>;
         using shape = shape_of_t<T>;
-        linalg::tensor<scalar, shape> result{};
-        visit_indices_in(shape{}, [&] (const auto& idx) {
-            result[idx] = operators::log{}(access<T>::at(idx, t));
-        });
-        return result;
+        if constexpr (linalg::is_tensor_v<T>) {
+            return linalg::transformed([] (const scalar& v) constexpr {
+                return static_cast<scalar>(operators::log{}(v));
+            }, t);
+        } else if constexpr (linalg::is_structured_v<T> and !linalg::has_structural_zeros<T>::value) {
+            return linalg::transformed_structured([] (const scalar& v) constexpr {
+                return static_cast<scalar>(operators::log{}(v));
+            }, t);
+        } else {
+            linalg::tensor<scalar, shape> result{};
+            visit_indices_in(shape{}, [&] (const auto& idx) {
+                result[idx] = operators::log{}(access<T>::at(idx, t));
+            });
+            return result;
+        }
     }
 };
 
@@ -54,17 +71,54 @@ struct log_of<T> {
 
 }  // namespace operators
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<auto v>
+    inline constexpr bool is_even_integer_v = [] () {
+        if constexpr (std::is_integral_v<decltype(v)>)
+            return v % 2 == 0;
+        else
+            return static_cast<decltype(v)>(static_cast<long long>(v)) == v and static_cast<long long>(v) % 2 == 0;
+    } ();
+
+    // powers whose logarithm can be rewritten as exponent*log(base), i.e. those that are not
+    // even powers, for which the base may be negative while the argument of the logarithm is positive
+    template<typename T>
+    struct is_log_reducible_power : std::false_type {};
+    template<typename B, typename E>
+    struct is_log_reducible_power<operation<operators::pow, B, E>> : std::true_type {};
+    template<typename B, auto v>
+    struct is_log_reducible_power<operation<operators::pow, B, value<v>>> : std::bool_constant<!is_even_integer_v<v>> {};
+
+    template<typename B, typename E>
+    inline constexpr auto log_of_power(const operation<operators::pow, B, E>&) noexcept {
+        return E{}*log(B{});
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return the logarithm of the given expression. Logarithms of powers are rewritten as `b*log(a)`, except
+ *        for constant even exponents (for which the base may be negative).
+ * \note For symbolic exponents, the rewrite assumes a positive base.
+ */
 template<expression A>
 inline constexpr auto log(const A&) noexcept {
     static_assert(!traits::is_zero_value_v<A>, "Logarithm of zero is not defined.");
     if constexpr (traits::is_unit_value_v<A>)
         return val<1>;
+    else if constexpr (detail::is_log_reducible_power<A>::value)
+        return detail::log_of_power(A{});
     else
         return operation<operators::log, A>{};
 }
 
 namespace traits {
 
+template<> struct operator_cost<operators::log> : std::integral_constant<std::size_t, 20> {};
+
 template<typename T>
 struct derivative_of<operation<operators::log, T>> {
     template<typename V>
@@ -75,8 +129,8 @@ struct derivative_of<operation<operators::log, T>> {
 
 template<typename T>
 struct stream<operation<operators::log, T>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
         out << "log(";
         write_to(out, T{}, values);
         out << ")";
@@ -42,6 +42,8 @@ inline constexpr auto mat_mul(const T1&, const T2&) noexcept {
 
 namespace traits {
 
+template<> struct operator_cost<operators::mat_mul> : std::integral_constant<std::size_t, 10> {};
+
 template<tensorial_expression T1, tensorial_expression T2>
 struct derivative_of<operation<operators::mat_mul, T1, T2>> {
     template<typename V>
@@ -7,12 +7,15 @@
  */
 #pragma once
 
+#include <tuple>
+#include <utility>
 #include <functional>
 
 #include "../values.hpp"
 #include "../expressions.hpp"
 #include "../linalg.hpp"
 #include "common.hpp"
+#include "add.hpp"
 
 
 namespace xp {
@@ -31,13 +34,31 @@ struct multiplication_of;
 template<tensorial T, typename S> requires(is_scalar_v<S>)
 struct multiplication_of<T, S> {
     template<same_remove_cvref_t_as<T> _T, same_remove_cvref_t_as<S> _S>
-    constexpr T operator()(_T&& tensor, _S&& scalar) const noexcept {
-        T result;
-        visit_indices_in(shape_of_t<T>{}, [&] (const auto& idx) {
-            scalar_type_t<T>& value_at_idx = access<T>::at(idx, result);
-            value_at_idx = access<T>::at(idx, tensor)*scalar;
-        });
-        return result;
+    constexpr auto operator()(_T&& tensor, _S&& scalar) const noexcept {
+        if constexpr (linalg::is_tensor_v<T>) {
+            return linalg::transformed([&] (const scalar_type_t<T>& v) constexpr {
+                return static_cast<scalar_type_t<T>>(v*scalar);
+            }, tensor);
+        } else if constexpr (linalg::is_structured_v<T>) {
+            // structural zeros remain zero
+            return linalg::transformed_structured([&] (const scalar_type_t<T>& v) constexpr {
+                return static_cast<scalar_type_t<T>>(v*scalar);
+            }, tensor);
+        } else if constexpr (std::is_default_constructible_v<T>) {
+            T result;
+            visit_indices_in(shape_of_t<T>{}, [&] (const auto& idx) {
+                scalar_type_t<T>& value_at_idx = access<T>::at(idx, result);
+                value_at_idx = access<T>::at(idx, tensor)*scalar;
+            });
+            return result;
+        } else {
+            // e.g. views on external memory, which cannot hold the result
+            linalg::tensor<scalar_type_t<T>, shape_of_t<T>> result{};
+            visit_indices_in(shape_of_t<T>{}, [&] (const auto& idx) {
+                result[idx] = access<T>::at(idx, tensor)*scalar;
+            });
+            return result;
+        }
     }
 };
 
@@ -45,7 +66,7 @@ struct multiplication_of<T, S> {
 template<typename S, tensorial T> requires(is_scalar_v<S>)
 struct multiplication_of<S, T> {
     template<same_remove_cvref_t_as<S> _S, same_remove_cvref_t_as<T> _T>
-    constexpr T operator()(_S&& scalar, _T&& tensor) const noexcept {
+    constexpr auto operator()(_S&& scalar, _T&& tensor) const noexcept {
         return multiplication_of<T, S>{}(std::forward<_T>(tensor), std::forward<_S>(scalar));
     }
 };
@@ -56,11 +77,15 @@ template<tensorial T1, tensorial T2>
 struct multiplication_of<T1, T2> {
     template<same_remove_cvref_t_as<T1> _T1, same_remove_cvref_t_as<T2> _T2>
     constexpr auto operator()(_T1&& A, _T2&& B) const noexcept {
-        scalar_type_t<T1> result{0};
-        visit_indices_in(shape_of_t<T1>{}, [&] (const auto& idx) {
-            result += access<T1>::at(idx, A)*access<T2>::at(idx, B);
-        });
-        return result;
+        if constexpr (linalg::is_tensor_v<T1> and linalg::is_tensor_v<T2>) {
+            return static_cast<scalar_type_t<T1>>(linalg::dot(A, B));
+        } else {
+            scalar_type_t<T1> result{0};
+            visit_indices_in(shape_of_t<T1>{}, [&] (const auto& idx) {
+                result += access<T1>::at(idx, A)*access<T2>::at(idx, B);
+            });
+            return result;
+        }
     }
 };
 
@@ -68,10 +93,56 @@ struct multiplication_of<T1, T2> {
 
 struct multiply : operator_base<traits::multiplication_of, std::multiplies<void>> {};
 
-namespace traits { template<> struct is_commutative<multiply> : std::true_type {}; }
+namespace traits {
+template<> struct is_commutative<multiply> : std::true_type {};
+// products of tensors with tensors are scalar products
+template<bool... t> struct is_elementwise<multiply, t...> : std::bool_constant<(std::size_t{0} + ... + std::size_t{t}) == 1> {};
+}  // namespace traits
 
 }  // namespace operators
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename T>
+    struct is_non_unit_factor : std::bool_constant<!traits::is_unit_value_v<T>> {};
+
+    template<typename... Ts>
+    inline constexpr auto product_of(const type_list<Ts...>&) noexcept {
+        if constexpr (sizeof...(Ts) == 0)
+            return val<1>;
+        else if constexpr (sizeof...(Ts) == 1)
+            return first_t<type_list<Ts...>>{};
+        else
+            return operation<operators::multiply, Ts...>{};
+    }
+
+    template<typename T>
+    struct is_nary_product : std::false_type {};
+    template<typename T0, typename T1, typename T2, typename... Ts>
+    struct is_nary_product<operation<operators::multiply, T0, T1, T2, Ts...>> : std::true_type {};
+
+    template<typename... Ts, typename B>
+    inline constexpr auto appended(const operation<operators::multiply, Ts...>&, const B&) noexcept {
+        return operation<operators::multiply, Ts..., B>{};
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return the (flat) product of all given factors, omitting unit factors (and yielding zero if any factor is zero).
+ *        In contrast to chains of binary multiplications, e.g. `a*b*c*...`, this yields a single n-ary multiplication,
+ *        which reduces the depth of the expression tree and, for scalar operands, is evaluated with a pairwise reduction.
+ */
+template<expression... Ts>
+inline constexpr auto product(const Ts&...) noexcept {
+    if constexpr ((... or traits::is_zero_value_v<Ts>))
+        return val<0>;
+    else
+        return detail::product_of(filtered_list_t<detail::is_non_unit_factor, type_list<Ts...>>{});
+}
+
 template<expression A, expression B>
     requires( not requires(const A& a, const B& b) { { a.operator*(b) }; } )
 inline constexpr auto operator*(const A&, const B&) noexcept {
@@ -81,6 +152,8 @@ inline constexpr auto operator*(const A&, const B&) noexcept {
         return B{};
     else if constexpr (traits::is_unit_value_v<B>)
         return A{};
+    else if constexpr (detail::is_nary_product<A>::value)  // keep n-ary products flat
+        return detail::appended(A{}, B{});
     else
         return operation<operators::multiply, A, B>{};
 }
@@ -95,21 +168,48 @@ struct derivative_of<operation<operators::multiply, T1, T2>> {
     }
 };
 
-template<typename T1, typename T2>
-struct stream<operation<operators::multiply, T1, T2>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
-        static constexpr bool has_subterms_1 = nodes_of_t<T1>::size > 1;
-        if constexpr (has_subterms_1) out << "(";
-        write_to(out, T1{}, values);
-        if constexpr (has_subterms_1) out << ")";
-
-        out << "*";
-
-        static constexpr bool has_subterms_2 = nodes_of_t<T2>::size > 1;
-        if constexpr (has_subterms_2) out << "(";
-        write_to(out, T2{}, values);
-        if constexpr (has_subterms_2) out << ")";
+template<typename T0, typename T1, typename T2, typename... Ts>
+struct derivative_of<operation<operators::multiply, T0, T1, T2, Ts...>> {
+    template<typename V>
+    static constexpr auto wrt(const type_list<V>& var) noexcept {
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
+            return xp::sum(_product_rule_term<i>(var)...);
+        } (std::index_sequence_for<T0, T1, T2, Ts...>{});
+    }
+
+ private:
+    template<std::size_t i, typename V>
+    static constexpr auto _product_rule_term(const type_list<V>& var) noexcept {
+        return [&] <std::size_t... j> (const std::index_sequence<j...>&) constexpr {
+            return xp::product(_factor<i, j>(var)...);
+        } (std::index_sequence_for<T0, T1, T2, Ts...>{});
+    }
+
+    template<std::size_t i, std::size_t j, typename V>
+    static constexpr auto _factor(const type_list<V>& var) noexcept {
+        using T = std::tuple_element_t<j, std::tuple<T0, T1, T2, Ts...>>;
+        if constexpr (i == j)
+            return xp::detail::differentiate<T>(var);
+        else
+            return T{};
+    }
+};
+
+template<typename T0, typename... Ts>
+struct stream<operation<operators::multiply, T0, Ts...>> {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
+        _write_factor(out, T0{}, values);
+        (..., (out << "*", _write_factor(out, Ts{}, values)));
+    }
+
+ private:
+    template<typename O, typename T, typename... V>
+    static constexpr void _write_factor(O& out, const T&, const bindings<V...>& values) noexcept {
+        static constexpr bool has_subterms = nodes_of_t<T>::size > 1;
+        if constexpr (has_subterms) out << "(";
+        write_to(out, T{}, values);
+        if constexpr (has_subterms) out << ")";
     }
 };
 
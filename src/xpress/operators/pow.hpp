@@ -8,11 +8,15 @@
 #pragma once
 
 #include <cmath>
+#include <utility>
+#include <type_traits>
 
+#include "../math.hpp"
 #include "../values.hpp"
 #include "../expressions.hpp"
 #include "../linalg.hpp"
 #include "common.hpp"
+#include "multiply.hpp"
 
 
 namespace xp {
@@ -24,15 +28,18 @@ namespace operators {
 
 namespace traits { template<typename A, typename B> struct power_of; }
 
+//! Default implementation, which uses the selected math backend (see `math::pow`), or overloads for e.g. SIMD pack types
 struct default_pow_operator {
     template<typename A, typename B>
-    constexpr auto operator()(A&& a, B&& b) const noexcept {
-        return std::pow(std::forward<A>(a), std::forward<B>(b));
+    XP_HOST_DEVICE constexpr auto operator()(const A& a, const B& b) const noexcept {
+        return math::pow(a, b);
     }
 };
 
 struct pow : operator_base<traits::power_of, default_pow_operator> {};
 
+namespace traits { template<> struct is_elementwise<pow, true, false> : std::true_type {}; }
+
 namespace traits {
 
 //! (Default) specialization for tensors
@@ -42,11 +49,21 @@ struct power_of<T, E> {
     constexpr auto operator()(_T&& t, _E&& e) const noexcept {
         using scalar = scalar_type_t<T>;
         using shape = shape_of_t<T>;
-        linalg::tensor<scalar, shape> result{};
-        visit_indices_in(shape{}, [&] (const auto& idx) {
-            result[idx] = operators::pow{}(access<T>::at(idx, t), e);
-        });
-        return result;
+        if constexpr (linalg::is_tensor_v<T>) {
+            return linalg::transformed([&] (const scalar& v) constexpr {
+                return static_cast<scalar>(operators::pow{}(v, e));
+            }, t);
+        } else if constexpr (linalg::is_structured_v<T> and !linalg::has_structural_zeros<T>::value) {
+            return linalg::transformed_structured([&] (const scalar& v) constexpr {
+                return static_cast<scalar>(operators::pow{}(v, e));
+            }, t);
+        } else {
+            linalg::tensor<scalar, shape> result{};
+            visit_indices_in(shape{}, [&] (const auto& idx) {
+                result[idx] = operators::pow{}(access<T>::at(idx, t), e);
+            });
+            return result;
+        }
     }
 };
 
@@ -65,8 +82,73 @@ inline constexpr auto pow(const A&, const B&) noexcept {
         return operation<operators::pow, A, B>{};
 }
 
+#ifndef DOXYGEN
+namespace detail {
+
+    // x^n for n >= 1 via exponentiation by squaring, unrolled at compile-time
+    template<auto n, typename T>
+    inline constexpr auto integer_power(const T& x) noexcept {
+        if constexpr (n == 1)
+            return x;
+        else if constexpr (n % 2 == 0) {
+            const auto half = integer_power<n/2>(x);
+            return operators::multiply{}(half, half);
+        } else {
+            return operators::multiply{}(x, integer_power<n-1>(x));
+        }
+    }
+
+    namespace pow_impl {
+
+        using std::sqrt;
+        template<typename T>
+        concept has_sqrt = requires(const T& t) { { sqrt(t) }; };
+
+        template<typename T>
+        inline XP_HOST_DEVICE constexpr auto sqrt_of(const T& t) noexcept {
+            return math::sqrt(t);
+        }
+
+    }  // namespace pow_impl
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 namespace traits {
 
+/*!
+ * \brief Powers with constant integer exponents are evaluated with multiplications (exponentiation by squaring).
+ * \note This applies to non-integral scalars (e.g. floating-point values, SIMD packs or blocks of values), since
+ *       for integers and tensors, `pow` and multiplication have different semantics.
+ */
+template<typename T, auto n> requires(std::is_integral_v<decltype(n)> and (n > 1 or n < -1))
+struct value_from_operands<operation<operators::pow, T, value<n>>> {
+    template<typename B, typename E>
+    static constexpr auto from(B&& base, E&& exponent) noexcept {
+        using scalar = std::remove_cvref_t<B>;
+        if constexpr (n > 0 and is_scalar_v<scalar> and !std::is_integral_v<scalar>)
+            return xp::detail::integer_power<n>(base);
+        else if constexpr (n < 0 and std::is_floating_point_v<scalar>)
+            return scalar{1}/xp::detail::integer_power<-n>(base);
+        else
+            return xp::detail::apply_operator(operators::pow{}, std::forward<B>(base), std::forward<E>(exponent));
+    }
+};
+
+//! Powers with the constant exponent 1/2 are evaluated as square roots (if available for the value type)
+template<typename T, auto v> requires(std::is_floating_point_v<decltype(v)> and v == decltype(v){0.5})
+struct value_from_operands<operation<operators::pow, T, value<v>>> {
+    template<typename B, typename E>
+    static constexpr auto from(B&& base, E&& exponent) noexcept {
+        if constexpr (xp::detail::pow_impl::has_sqrt<std::remove_cvref_t<B>> and is_scalar_v<std::remove_cvref_t<B>>)
+            return xp::detail::pow_impl::sqrt_of(base);
+        else
+            return xp::detail::apply_operator(operators::pow{}, std::forward<B>(base), std::forward<E>(exponent));
+    }
+};
+
+template<> struct operator_cost<operators::pow> : std::integral_constant<std::size_t, 20> {};
+
 template<typename T1, typename T2>
 struct derivative_of<operation<operators::pow, T1, T2>> {
     template<typename V>
@@ -78,8 +160,8 @@ struct derivative_of<operation<operators::pow, T1, T2>> {
 
 template<typename T1, typename T2>
 struct stream<operation<operators::pow, T1, T2>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
         write_to(out, T1{}, values);
         out << "^";
         static constexpr bool exponent_has_subterms = nodes_of_t<T2>::size > 1;
@@ -35,11 +35,21 @@ struct subtraction_of<T1, T2> {
     constexpr auto operator()(_T1&& A, _T2&& B) const noexcept {
         using scalar = std::common_type_t<scalar_type_t<T1>, scalar_type_t<T2>>;
         using shape = shape_of_t<T1>;
-        linalg::tensor<scalar, shape> result{};
-        visit_indices_in(shape{}, [&] (const auto& idx) {
-            result[idx] = access<T1>::at(idx, A) - access<T2>::at(idx, B);
-        });
-        return result;
+        if constexpr (linalg::is_tensor_v<T1> and linalg::is_tensor_v<T2>) {
+            return linalg::transformed([] (const auto& a, const auto& b) constexpr {
+                return static_cast<scalar>(a - b);
+            }, A, B);
+        } else if constexpr (linalg::have_same_structure_v<T1, T2>) {
+            return linalg::transformed_structured([] (const auto& a, const auto& b) constexpr {
+                return static_cast<scalar>(a - b);
+            }, A, B);
+        } else {
+            linalg::tensor<scalar, shape> result{};
+            visit_indices_in(shape{}, [&] (const auto& idx) {
+                result[idx] = access<T1>::at(idx, A) - access<T2>::at(idx, B);
+            });
+            return result;
+        }
     }
 };
 
@@ -47,6 +57,8 @@ struct subtraction_of<T1, T2> {
 
 struct subtract : operator_base<traits::subtraction_of, std::minus<void>> {};
 
+namespace traits { template<bool... t> struct is_elementwise<subtract, t...> : std::bool_constant<(... and t)> {}; }
+
 }  // namespace operators
 
 template<expression A, expression B>
@@ -74,8 +86,8 @@ struct derivative_of<operation<operators::subtract, T1, T2>> {
 
 template<typename T1, typename T2>
 struct stream<operation<operators::subtract, T1, T2>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) noexcept {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) noexcept {
         write_to(out, T1{}, values);
         out << " - ";
         write_to(out, T2{}, values);
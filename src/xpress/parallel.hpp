@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Evaluation of expressions at many points distributed over multiple cores.
+ */
+#pragma once
+
+#include <span>
+#include <ranges>
+#include <thread>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <type_traits>
+
+#include "concepts.hpp"
+#include "bindings.hpp"
+#include "expressions.hpp"
+#include "batch.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! Policy to evaluate with the given number of threads (the hardware concurrency by default)
+struct threads {
+    std::size_t count = std::max(std::thread::hardware_concurrency(), 1u);
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename P>
+    concept parallel_policy = std::is_same_v<std::remove_cvref_t<P>, threads>
+        or std::is_execution_policy_v<std::remove_cvref_t<P>>;
+
+    // Split [0, count) into contiguous chunks (with sizes that are multiples of the given granularity)
+    // and invoke f(begin, end) for each of them. Each thread processes a single chunk, such that the
+    // outputs written by a thread are contiguous in memory and no synchronization is needed.
+    template<parallel_policy P, typename F>
+    inline void for_each_chunk(P&& policy, std::size_t count, std::size_t granularity, F&& f) {
+        const std::size_t num_threads = [&] () -> std::size_t {
+            if constexpr (std::is_same_v<std::remove_cvref_t<P>, threads>)
+                return std::max(policy.count, std::size_t{1});
+            else
+                return std::max(std::thread::hardware_concurrency(), 1u);
+        } ();
+        const std::size_t num_units = (count + granularity - 1)/granularity;
+        const std::size_t num_chunks = std::max(std::min(num_threads, num_units), std::size_t{1});
+        const auto chunk = [&] (std::size_t i) {
+            const std::size_t begin = std::min(count, (i*num_units/num_chunks)*granularity);
+            const std::size_t end = std::min(count, ((i + 1)*num_units/num_chunks)*granularity);
+            if (begin < end)
+                f(begin, end);
+        };
+
+        if constexpr (std::is_same_v<std::remove_cvref_t<P>, threads>) {
+            std::vector<std::jthread> workers;
+            workers.reserve(num_chunks - 1);
+            for (std::size_t i = 1; i < num_chunks; ++i)
+                workers.emplace_back(chunk, i);
+            chunk(0);
+        } else {
+            std::vector<std::size_t> chunks(num_chunks);
+            std::iota(chunks.begin(), chunks.end(), std::size_t{0});
+            std::for_each(std::forward<P>(policy), chunks.begin(), chunks.end(), chunk);
+        }
+    }
+
+    template<typename V>
+    inline decltype(auto) chunk_of(const V& values, std::size_t begin, std::size_t end) noexcept {
+        if constexpr (std::ranges::contiguous_range<V>)
+            return std::span{std::ranges::data(values) + begin, end - begin};
+        else
+            return (values);
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Write `f(inputs[i])` into `outputs[i]` for all inputs, distributing contiguous chunks over multiple cores.
+ * \param policy Either `xp::threads{n}`, or a standard execution policy (e.g. `std::execution::par_unseq`).
+ * \param inputs Random-access range of inputs, e.g. bindings.
+ * \param outputs Random-access range with (at least) as many entries as there are inputs.
+ * \param f Callable that must be safe to be invoked concurrently, e.g. `[] (const auto& b) { return value_of(expr, b); }`.
+ */
+template<typename P, std::ranges::random_access_range I, std::ranges::random_access_range O, typename F>
+    requires(detail::parallel_policy<P>)
+inline void parallel_transform(P&& policy, const I& inputs, O&& outputs, F&& f) {
+    const std::size_t count = std::ranges::size(inputs);
+    assert(std::ranges::size(outputs) >= count && "Output range is too small.");
+    detail::for_each_chunk(std::forward<P>(policy), count, 1, [&] (std::size_t begin, std::size_t end) {
+        auto in = std::ranges::begin(inputs);
+        auto out = std::ranges::begin(outputs);
+        for (std::size_t i = begin; i < end; ++i)
+            out[i] = f(in[i]);
+    });
+}
+
+/*!
+ * \brief Evaluate the given expression at each of the given bindings in parallel (see `parallel_transform`).
+ *        Instead of an expression, any evaluation callable can be passed, for instance, to compute derivatives:
+ *        `parallel_evaluate([&] (const auto& b) { return derivatives_of(expr, wrt(a), b)[a]; }, ...)`.
+ *        Evaluators are stateless, so the threads do not need to synchronize.
+ */
+template<typename E, std::ranges::random_access_range I, std::ranges::random_access_range O, typename P>
+    requires(detail::parallel_policy<P>)
+inline void parallel_evaluate(const E& expr, const I& inputs, O&& outputs, P&& policy) {
+    if constexpr (expression<E>)
+        parallel_transform(std::forward<P>(policy), inputs, std::forward<O>(outputs), [] (const auto& b) {
+            return value_of(E{}, b);
+        });
+    else
+        parallel_transform(std::forward<P>(policy), inputs, std::forward<O>(outputs), expr);
+}
+
+/*!
+ * \brief Batched evaluation (see `evaluator::batch`) with the points distributed over multiple cores.
+ *        Each thread evaluates a contiguous range of whole blocks.
+ */
+template<expression E, typename R, typename P, binder... V>
+    requires(detail::parallel_policy<P>)
+inline void parallel_batch(const E&, std::span<R> out, P&& policy, const V&... values) {
+    const bindings<V...> all_values{values...};
+    detail::for_each_chunk(std::forward<P>(policy), out.size(), batch_block_size, [&] (std::size_t begin, std::size_t end) {
+        evaluator{E{}}.batch(
+            out.subspan(begin, end - begin),
+            value_binder{typename V::symbol_type{}, detail::chunk_of(all_values[typename V::symbol_type{}], begin, end)}...
+        );
+    });
+}
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -0,0 +1,217 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Compile-time rendering of the textual form of expressions.
+ */
+#pragma once
+
+#include <array>
+#include <limits>
+#include <cstddef>
+#include <concepts>
+#include <exception>
+#include <string_view>
+#include <type_traits>
+
+#ifndef XP_NO_IOSTREAM
+#include <ostream>
+#endif
+
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // not constexpr, such that reaching it makes a constant evaluation ill-formed
+    [[noreturn]] inline void fixed_string_capacity_exceeded() noexcept {
+        std::terminate();
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+//! A string with a fixed (compile-time) capacity, which can be used in constant expressions
+template<std::size_t capacity>
+class fixed_string {
+ public:
+    constexpr fixed_string() = default;
+
+    //! Append the given characters (it is an error to exceed the capacity)
+    constexpr void append(std::string_view chars) noexcept {
+        if (chars.size() > capacity - _size)
+            detail::fixed_string_capacity_exceeded();
+        for (const char c : chars)
+            _chars[_size++] = c;
+    }
+
+    constexpr std::size_t size() const noexcept { return _size; }
+    constexpr const char* data() const noexcept { return _chars.data(); }
+    constexpr std::string_view view() const noexcept { return {_chars.data(), _size}; }
+    constexpr operator std::string_view() const noexcept { return view(); }
+
+#ifndef XP_NO_IOSTREAM
+    friend std::ostream& operator<<(std::ostream& out, const fixed_string& s) {
+        return out.write(s.data(), static_cast<std::streamsize>(s.size()));
+    }
+#endif
+
+ private:
+    std::array<char, capacity> _chars{};
+    std::size_t _size = 0;
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // Output for the stream traits that renders into a fixed_string in constant expressions. Supports
+    // strings, integers and floating-point values (which are written like std::ostream does by default).
+    template<std::size_t capacity>
+    class fixed_string_writer {
+     public:
+        constexpr explicit fixed_string_writer(fixed_string<capacity>& out) noexcept
+        : _out{out}
+        {}
+
+        template<typename T>
+        constexpr fixed_string_writer& operator<<(const T& value) {
+            if constexpr (std::convertible_to<const T&, std::string_view>)
+                _out.append(std::string_view{value});
+            else if constexpr (std::same_as<T, char>)
+                _out.append(std::string_view{&value, 1});
+            else if constexpr (std::same_as<T, bool>)
+                _out.append(value ? "1" : "0");
+            else if constexpr (std::integral<T>)
+                _write_integer(value);
+            else if constexpr (std::floating_point<T>)
+                _write_floating_point(static_cast<long double>(value));
+            else
+                static_assert(always_false<T>::value, "Only strings and arithmetic values can be rendered at compile-time.");
+            return *this;
+        }
+
+     private:
+        template<typename T>
+        struct always_false : std::false_type {};
+
+        template<std::integral T>
+        constexpr void _write_integer(T value) {
+            if (value < T{0})
+                _out.append("-");
+            _write_digits_of(value < T{0} ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value));
+        }
+
+        constexpr void _write_digits_of(unsigned long long value, std::size_t min_digits = 1) {
+            std::array<char, std::numeric_limits<unsigned long long>::digits10 + 1> digits{};
+            std::size_t count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + value%10);
+                value /= 10;
+            } while (value > 0 || count < min_digits);
+            while (count > 0)
+                _out.append(std::string_view{&digits[--count], 1});
+        }
+
+        // like the default (%g) format of streams, with 6 significant digits
+        static constexpr int precision = 6;
+
+        constexpr void _write_floating_point(long double value) {
+            if (value != value)
+                return _out.append("nan");
+            if (value < 0.0L) {
+                _out.append("-");
+                value = -value;
+            }
+            if (value == std::numeric_limits<long double>::infinity())
+                return _out.append("inf");
+            if (value == 0.0L)
+                return _out.append("0");
+
+            int exponent = 0;
+            while (value >= 10.0L) { value /= 10.0L; ++exponent; }
+            while (value < 1.0L) { value *= 10.0L; --exponent; }
+
+            long double scaled = value;
+            for (int i = 1; i < precision; ++i)
+                scaled *= 10.0L;
+            auto digits = static_cast<unsigned long long>(scaled + 0.5L);
+            if (digits >= 1'000'000ull) {
+                digits /= 10;
+                ++exponent;
+            }
+
+            std::array<char, precision> significand{};
+            for (int i = precision; i-- > 0; digits /= 10)
+                significand[i] = static_cast<char>('0' + digits%10);
+            const auto significant_digits = [&] (int first) {
+                int last = precision;
+                while (last > first && significand[last - 1] == '0')
+                    --last;
+                return last;
+            };
+
+            if (exponent >= -4 && exponent < precision) {
+                if (exponent < 0) {
+                    _out.append("0.");
+                    for (int i = -1; i > exponent; --i)
+                        _out.append("0");
+                    _out.append(std::string_view{significand.data(), static_cast<std::size_t>(significant_digits(0))});
+                } else {
+                    const int integral_digits = exponent + 1;
+                    const int last = significant_digits(integral_digits);
+                    _out.append(std::string_view{significand.data(), static_cast<std::size_t>(integral_digits)});
+                    if (last > integral_digits) {
+                        _out.append(".");
+                        _out.append(std::string_view{significand.data() + integral_digits, static_cast<std::size_t>(last - integral_digits)});
+                    }
+                }
+            } else {
+                const int last = significant_digits(1);
+                _out.append(std::string_view{significand.data(), 1});
+                if (last > 1) {
+                    _out.append(".");
+                    _out.append(std::string_view{significand.data() + 1, static_cast<std::size_t>(last - 1)});
+                }
+                _out.append(exponent < 0 ? "e-" : "e+");
+                _write_digits_of(static_cast<unsigned long long>(exponent < 0 ? -exponent : exponent), 2);
+            }
+        }
+
+        fixed_string<capacity>& _out;
+    };
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Render the textual form of the given expression with the given (compile-time) values, e.g. symbol names,
+ *        into a `fixed_string` at compile-time. This yields the same text as writing the expression into a stream:
+ *        \code{.cpp}
+ *            static constexpr var a;
+ *            static constexpr var b;
+ *            static constexpr auto text = render(a*b + a, with(a = "a", b = "b"));
+ *            std::cout << text;  // writes "a*b + a" from a static buffer
+ *        \endcode
+ * \tparam capacity The maximum number of characters (exceeding it fails compilation).
+ */
+template<std::size_t capacity = 256, expression E, typename... V>
+    requires(streamable_with<E, V...>)
+consteval auto render(const E&, const bindings<V...>& values) {
+    fixed_string<capacity> result;
+    detail::fixed_string_writer writer{result};
+    traits::stream<E>::to(writer, values);
+    return result;
+}
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -0,0 +1,206 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Reverse-mode (adjoint) evaluation of the derivatives of scalar expressions.
+ */
+#pragma once
+
+#include <array>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "symbols.hpp"
+#include "evaluation.hpp"
+#include "operators/common.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! Tag to select reverse-mode (adjoint) evaluation of derivatives
+struct reverse_t {};
+inline constexpr reverse_t reverse{};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<std::size_t i>
+    struct operand_id {};
+
+    // placeholder symbol for the i-th operand of an operation
+    template<std::size_t i>
+    using operand = var<dtype::any, operand_id<i>{}>;
+
+    // derivative of an operation w.r.t. its p-th operand, expressed in terms of operand placeholders
+    template<typename op, std::size_t p, std::size_t... i>
+    inline constexpr auto local_partial_of(const std::index_sequence<i...>&) noexcept {
+        return xp::derivative_of(operation<op, operand<i>...>{}, type_list<operand<p>>{});
+    }
+
+    // where the adjoint contributions of a node are accumulated
+    template<typename T, typename nodes, typename variables>
+    struct adjoint_target {
+        static constexpr std::size_t node_index = index_of_equal_node<T, nodes>::value;
+        static constexpr std::size_t variable_index = index_of_equal_node<T, variables>::value;
+        static constexpr bool is_variable = variable_index < variables::size;
+        static constexpr bool is_node = !is_variable and node_index < nodes::size;
+    };
+
+    // adjoints are propagated into the operands of scalar operations on scalars
+    template<typename N, typename B>
+    struct has_scalar_operands : std::false_type {};
+    template<typename op, typename... Ts, typename B>
+    struct has_scalar_operands<operation<op, Ts...>, B> : std::conjunction<is_scalar<node_value_t<Ts, B>>...> {};
+
+    template<typename op, typename... Ts, typename... B, typename R, typename accumulator>
+    inline constexpr void propagate_adjoint(const operation<op, Ts...>&,
+                                            const bindings<B...>& node_values,
+                                            const R& adjoint,
+                                            accumulator&& accumulate) noexcept {
+        [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
+            const auto operand_values = bindings{value_binder{operand<i>{}, xp::value_of(Ts{}, node_values)}...};
+            (..., accumulate(Ts{}, [&] () constexpr {
+                const auto partial = local_partial_of<op, i>(std::index_sequence_for<Ts...>{});
+                return adjoint*static_cast<R>(xp::value_of(partial, operand_values));
+            }));
+        } (std::index_sequence_for<Ts...>{});
+    }
+
+    template<typename E, typename... N, typename... X, typename... B>
+    inline constexpr auto adjoint_sweep(const type_list<N...>&,
+                                        const type_list<X...>&,
+                                        const bindings<B...>& node_values) noexcept {
+        using root_value = std::remove_cvref_t<decltype(xp::value_of(E{}, node_values))>;
+        static_assert(is_scalar_v<root_value>, "Reverse-mode differentiation is only supported for scalar expressions.");
+        using R = std::common_type_t<root_value, scalar_type_t<std::remove_cvref_t<decltype(node_values[N{}])>>...>;
+
+        std::array<R, sizeof...(N)> adjoints{};
+        std::array<R, sizeof...(X)> gradient{};
+        const auto accumulate = [&] <typename C, typename F> (const C&, F&& contribution) constexpr {
+            using target = adjoint_target<C, type_list<N...>, type_list<X...>>;
+            if constexpr (target::is_variable)
+                gradient[target::variable_index] += contribution();
+            else if constexpr (target::is_node)
+                adjoints[target::node_index] += contribution();
+        };
+
+        accumulate(E{}, [] () constexpr { return R{1}; });
+        [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
+            (..., [&] () constexpr {
+                constexpr std::size_t idx = sizeof...(N) - 1 - i;
+                using node = std::tuple_element_t<idx, std::tuple<N...>>;
+                using value_type = std::remove_cvref_t<decltype(node_values[node{}])>;
+                if constexpr (is_scalar_v<value_type>) {
+                    const R adjoint = adjoints[idx];
+                    if constexpr (has_scalar_operands<node, bindings<B...>>::value)
+                        propagate_adjoint(node{}, node_values, adjoint, accumulate);
+                    else  // fall back to the symbolic derivatives of this node
+                        (..., (gradient[index_of_equal_node<X, type_list<X...>>::value] += adjoint*static_cast<R>(
+                            xp::value_of(xp::derivative_of(node{}, type_list<X>{}), node_values)
+                        )));
+                }
+            } ());
+        } (std::index_sequence_for<N...>{});
+
+        return [&] <std::size_t... i> (const std::index_sequence<i...>&) constexpr {
+            return bindings{value_binder{X{}, static_cast<R>(gradient[i])}...};
+        } (std::index_sequence_for<X...>{});
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return the derivatives of the given scalar expression w.r.t the given variables, evaluated at the given values.
+ *        In contrast to the symbolic derivatives, the derivatives are computed in reverse mode, that is, with a single
+ *        forward sweep over the unique nodes of the expression, followed by a single adjoint sweep that accumulates
+ *        all partial derivatives at once. This scales well for expressions with many variables. As for the symbolic
+ *        mode, the result binds the derivative values to the variables.
+ * \note Values bound to sub-expressions are treated as constants in the adjoint sweep.
+ */
+template<expression E, typename... X, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto derivatives_of(const E&, const type_list<X...>&, const bindings<V...>& values, const reverse_t&) noexcept {
+    using nodes = traits::evaluation_nodes_of_t<bindings<V...>, E>;
+    return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+        return detail::adjoint_sweep<E>(nodes{}, type_list<X...>{}, node_values);
+    });
+}
+
+//! Return the gradient of the given scalar expression evaluated at the given values in reverse mode
+template<expression E, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto gradient_of(const E& expr, const bindings<V...>& values, const reverse_t& mode) noexcept {
+    return derivatives_of(expr, traits::variables_of_t<E>{}, values, mode);
+}
+
+/*!
+ * \brief Counterpart of `derivatives` for reverse mode, which evaluates the derivatives of the expression E w.r.t. the
+ *        variables X with an adjoint sweep (see `derivatives_of`). Since reverse mode does not form derivative expressions,
+ *        it only provides the evaluation interface of `derivatives`, i.e. `at`.
+ */
+template<typename E, typename... X>
+struct reverse_derivatives {
+    constexpr reverse_derivatives() = default;
+    constexpr reverse_derivatives(const E&, const type_list<X...>&) noexcept {}
+
+    //! Evaluate the derivatives at the given values
+    template<binder... V>
+    constexpr auto at(V&&... values) const noexcept {
+        return at(bindings{std::forward<V>(values)...});
+    }
+
+    //! Evaluate the derivatives at the given value bindings
+    template<typename... V>
+        requires(evaluatable_with<E, V...>)
+    constexpr auto at(const bindings<V...>& values) const noexcept {
+        return derivatives_of(E{}, type_list<X...>{}, values, reverse);
+    }
+};
+
+//! Return the derivatives of the given scalar expression w.r.t. the given variables, to be evaluated in reverse mode
+template<expression E, typename... X>
+inline constexpr auto derivatives_of(const E&, const type_list<X...>&, const reverse_t&) noexcept {
+    return reverse_derivatives<E, X...>{};
+}
+
+//! Return the gradient of the given scalar expression, to be evaluated in reverse mode
+template<expression E>
+inline constexpr auto gradient_of(const E& expr, const reverse_t& mode) noexcept {
+    return derivatives_of(expr, traits::variables_of_t<E>{}, mode);
+}
+
+//! Evaluate the given scalar expression and its derivatives w.r.t. the given variables in reverse mode (see `value_and_derivatives_of`)
+template<expression E, typename... X, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_and_derivatives_of(const E&, const type_list<X...>&, const bindings<V...>& values, const reverse_t&) noexcept {
+    using nodes = traits::evaluation_nodes_of_t<bindings<V...>, E>;
+    return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+        return std::pair{
+            detail::cached_value_of(E{}, node_values),
+            detail::adjoint_sweep<E>(nodes{}, type_list<X...>{}, node_values)
+        };
+    });
+}
+
+//! Evaluate the given scalar expression and its gradient in reverse mode (see `value_and_derivatives_of`)
+template<expression E, typename... V>
+    requires(evaluatable_with<E, V...>)
+inline constexpr auto value_and_gradient_of(const E& expr, const bindings<V...>& values, const reverse_t& mode) noexcept {
+    return value_and_derivatives_of(expr, traits::variables_of_t<E>{}, values, mode);
+}
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup TypeTraits
+ * \brief Registers SIMD pack types (`std::experimental::simd`) as values that can be bound to symbols.
+ *        Expressions evaluated with such values compute all lanes at once; `pow` and `log` dispatch to the
+ *        vectorized overloads of the pack type. Other pack types can be registered analogously by
+ *        specializing `is_scalar`, `scalar_type` and `is_bindable`.
+ */
+#pragma once
+
+#include <type_traits>
+
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#endif
+
+#include "type_traits.hpp"
+#include "dtype.hpp"
+
+
+#ifdef __cpp_lib_experimental_parallel_simd
+namespace xp {
+
+//! \addtogroup TypeTraits
+//! \{
+
+template<typename T, typename Abi>
+struct is_scalar<std::experimental::simd<T, Abi>> : std::true_type {};
+
+// packs are indexable, but are themselves the scalars of expressions
+template<typename T, typename Abi>
+struct scalar_type<std::experimental::simd<T, Abi>> : std::type_identity<std::experimental::simd<T, Abi>> {};
+
+namespace traits {
+
+template<typename Arg> requires(std::experimental::is_simd_v<std::remove_cvref_t<Arg>>)
+struct is_bindable<dtype::real, Arg> : is_bindable<dtype::real, typename std::remove_cvref_t<Arg>::value_type> {};
+template<typename Arg> requires(std::experimental::is_simd_v<std::remove_cvref_t<Arg>>)
+struct is_bindable<dtype::integral, Arg> : is_bindable<dtype::integral, typename std::remove_cvref_t<Arg>::value_type> {};
+
+}  // namespace traits
+
+//! \} group TypeTraits
+
+}  // namespace xp
+#endif  // __cpp_lib_experimental_parallel_simd
@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Compile-time simplification of expressions by collecting like terms in sums and products.
+ */
+#pragma once
+
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "values.hpp"
+#include "operators.hpp"
+#include "tensor.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+#ifndef DOXYGEN
+namespace detail::simplification {
+
+    template<typename E>
+    inline constexpr auto canonical(const E&) noexcept;
+
+    template<typename E>
+    using canonical_t = std::remove_cvref_t<decltype(canonical(std::declval<const E&>()))>;
+
+    // factor B^P of a product
+    template<typename B, typename P>
+    struct factor {};
+
+    // summand C*F_1*...*F_n of a sum with a constant coefficient C (a `value<c>`) and the list of factors F
+    template<typename C, typename F>
+    struct summand {};
+
+    // products involving tensors are not commutative in general, and thus, we keep them as they are
+    template<typename N>
+    struct has_tensor_nodes;
+    template<typename... N>
+    struct has_tensor_nodes<type_list<N...>> : std::disjunction<is_complete<shape_of<N>>...> {};
+    template<typename E>
+    inline constexpr bool is_scalar_expression_v = !has_tensor_nodes<traits::nodes_of_t<E>>::value;
+
+    template<typename E>
+    struct is_sum_or_product : std::false_type {};
+    template<typename... Ts>
+    struct is_sum_or_product<operation<operators::add, Ts...>> : std::true_type {};
+    template<typename A, typename B>
+    struct is_sum_or_product<operation<operators::subtract, A, B>> : std::true_type {};
+    template<typename... Ts>
+    struct is_sum_or_product<operation<operators::multiply, Ts...>>
+    : std::bool_constant<is_scalar_expression_v<operation<operators::multiply, Ts...>>> {};
+    template<typename A, typename B>
+    struct is_sum_or_product<operation<operators::pow, A, B>>
+    : std::bool_constant<is_scalar_expression_v<operation<operators::pow, A, B>>> {};
+
+    template<typename C>
+    struct is_negative_value : std::false_type {};
+    template<auto v>
+    struct is_negative_value<value<v>> : std::bool_constant<(v < 0)> {};
+
+    template<typename P0, typename P1>
+    using added_exponents_t = canonical_t<decltype(P0{} + P1{})>;
+
+    template<typename F0, typename F1>
+    struct is_equal_factor : std::false_type {};
+    template<typename B0, typename P0, typename B1, typename P1>
+    struct is_equal_factor<factor<B0, P0>, factor<B1, P1>>
+    : std::bool_constant<traits::is_equal_node_v<B0, B1> and traits::is_equal_node_v<P0, P1>> {};
+
+    template<typename F>
+    struct has_nonzero_exponent;
+    template<typename B, typename P>
+    struct has_nonzero_exponent<factor<B, P>> : std::bool_constant<!traits::is_zero_value_v<P>> {};
+
+    template<typename S>
+    struct has_factors;
+    template<typename C, typename... F>
+    struct has_factors<summand<C, type_list<F...>>> : std::bool_constant<(sizeof...(F) > 0)> {};
+
+    template<typename S>
+    struct is_constant_summand : std::bool_constant<!has_factors<S>::value> {};
+
+    template<typename S>
+    struct has_nonzero_coefficient;
+    template<typename C, typename F>
+    struct has_nonzero_coefficient<summand<C, F>> : std::bool_constant<!traits::is_zero_value_v<C>> {};
+
+    // multiply the given factor into a list of factors (merging it with a factor of the same base)
+    template<typename F, typename list, typename done = type_list<>>
+    struct with_factor;
+    template<typename B, typename P0, typename P1, typename done, typename rest>
+    struct with_merged_factor;
+    template<typename B, typename P0, typename P1, typename... D, typename... F>
+    struct with_merged_factor<B, P0, P1, type_list<D...>, type_list<F...>> {
+        using type = type_list<D..., factor<B, added_exponents_t<P0, P1>>, F...>;
+    };
+    template<typename B, typename P, typename... D>
+    struct with_factor<factor<B, P>, type_list<>, type_list<D...>>
+    : std::type_identity<type_list<D..., factor<B, P>>> {};
+    template<typename B, typename P, typename B0, typename P0, typename... F, typename... D>
+    struct with_factor<factor<B, P>, type_list<factor<B0, P0>, F...>, type_list<D...>>
+    : std::conditional_t<
+        traits::is_equal_node_v<B, B0>,
+        with_merged_factor<B0, P0, P, type_list<D...>, type_list<F...>>,
+        with_factor<factor<B, P>, type_list<F...>, type_list<D..., factor<B0, P0>>>
+    > {};
+
+    template<typename list, typename F>
+    struct with_factors;
+    template<typename list>
+    struct with_factors<list, type_list<>> : std::type_identity<list> {};
+    template<typename list, typename F0, typename... F>
+    struct with_factors<list, type_list<F0, F...>>
+    : with_factors<typename with_factor<F0, list>::type, type_list<F...>> {};
+
+    template<typename S0, typename S1>
+    struct multiplied;
+    template<typename C0, typename F0, typename C1, typename F1>
+    struct multiplied<summand<C0, F0>, summand<C1, F1>> {
+        using type = summand<
+            std::remove_cvref_t<decltype(C0{}*C1{})>,
+            filtered_list_t<has_nonzero_exponent, typename with_factors<F0, F1>::type>
+        >;
+    };
+
+    // the (flattened) product making up a summand
+    template<typename E>
+    struct product_of : std::type_identity<summand<value<1>, type_list<factor<canonical_t<E>, value<1>>>>> {};
+    template<auto v>
+    struct product_of<value<v>> : std::type_identity<summand<value<v>, type_list<>>> {};
+    template<typename S, typename... Ts>
+    struct multiplied_all : std::type_identity<S> {};
+    template<typename S, typename T0, typename... Ts>
+    struct multiplied_all<S, T0, Ts...>
+    : multiplied_all<typename multiplied<S, typename product_of<T0>::type>::type, Ts...> {};
+
+    template<typename... Ts>
+        requires(is_scalar_expression_v<operation<operators::multiply, Ts...>>)
+    struct product_of<operation<operators::multiply, Ts...>>
+    : multiplied_all<summand<value<1>, type_list<>>, Ts...> {};
+    template<typename A, typename P>
+        requires(is_scalar_expression_v<operation<operators::pow, A, P>>)
+    struct product_of<operation<operators::pow, A, P>>
+    : std::type_identity<summand<value<1>, type_list<factor<canonical_t<A>, canonical_t<P>>>>> {};
+
+    template<typename list>
+    struct negated;
+    template<typename... C, typename... F>
+    struct negated<type_list<summand<C, F>...>>
+    : std::type_identity<type_list<summand<std::remove_cvref_t<decltype(-C{})>, F>...>> {};
+
+    // the (flattened) summands of a sum
+    template<typename E>
+    struct summands_of : std::type_identity<type_list<typename product_of<E>::type>> {};
+    template<typename list, typename... Ts>
+    struct merged_summands_of : std::type_identity<list> {};
+    template<typename list, typename T0, typename... Ts>
+    struct merged_summands_of<list, T0, Ts...>
+    : merged_summands_of<concatenated_t<list, typename summands_of<T0>::type>, Ts...> {};
+
+    template<typename... Ts>
+    struct summands_of<operation<operators::add, Ts...>> : merged_summands_of<type_list<>, Ts...> {};
+    template<typename A, typename B>
+    struct summands_of<operation<operators::subtract, A, B>>
+    : std::type_identity<concatenated_t<typename summands_of<A>::type, typename negated<typename summands_of<B>::type>::type>> {};
+
+    template<typename F, typename list>
+    struct contains_equal_factor;
+    template<typename F, typename... Fs>
+    struct contains_equal_factor<F, type_list<Fs...>> : std::disjunction<is_equal_factor<F, Fs>...> {};
+
+    template<typename F0, typename F1>
+    struct is_same_factors : std::false_type {};
+    template<typename... F0, typename... F1> requires(sizeof...(F0) == sizeof...(F1))
+    struct is_same_factors<type_list<F0...>, type_list<F1...>>
+    : std::conjunction<contains_equal_factor<F0, type_list<F1...>>...> {};
+
+    // add the given summand to a list of summands (merging it with a like term)
+    template<typename S, typename list, typename done = type_list<>>
+    struct with_summand;
+    template<typename C0, typename C1, typename F, typename done, typename rest>
+    struct with_merged_summand;
+    template<typename C0, typename C1, typename F, typename... D, typename... S>
+    struct with_merged_summand<C0, C1, F, type_list<D...>, type_list<S...>> {
+        using type = type_list<D..., summand<std::remove_cvref_t<decltype(C0{} + C1{})>, F>, S...>;
+    };
+    template<typename C, typename F, typename... D>
+    struct with_summand<summand<C, F>, type_list<>, type_list<D...>>
+    : std::type_identity<type_list<D..., summand<C, F>>> {};
+    template<typename C, typename F, typename C0, typename F0, typename... S, typename... D>
+    struct with_summand<summand<C, F>, type_list<summand<C0, F0>, S...>, type_list<D...>>
+    : std::conditional_t<
+        is_same_factors<F, F0>::value,
+        with_merged_summand<C0, C, F0, type_list<D...>, type_list<S...>>,
+        with_summand<summand<C, F>, type_list<S...>, type_list<D..., summand<C0, F0>>>
+    > {};
+
+    template<typename list, typename S>
+    struct collected;
+    template<typename list>
+    struct collected<list, type_list<>> : std::type_identity<list> {};
+    template<typename list, typename S0, typename... S>
+    struct collected<list, type_list<S0, S...>>
+    : collected<typename with_summand<S0, list>::type, type_list<S...>> {};
+
+    // the like terms of E in canonical order: all non-constant summands in the order of their first appearance,
+    // followed by the constant summand (if any)
+    template<typename E>
+    struct collected_summands_of {
+        using all = filtered_list_t<has_nonzero_coefficient, typename collected<type_list<>, typename summands_of<E>::type>::type>;
+        using type = concatenated_t<filtered_list_t<has_factors, all>, filtered_list_t<is_constant_summand, all>>;
+    };
+
+    template<typename B, typename P>
+    inline constexpr auto expression_of(const factor<B, P>&) noexcept {
+        if constexpr (traits::is_unit_value_v<P>)
+            return B{};
+        else if constexpr (std::is_same_v<P, value<2>>)  // cheaper to evaluate than pow
+            return B{}*B{};
+        else
+            return pow(B{}, P{});
+    }
+
+    template<typename C, typename... F>
+    inline constexpr auto expression_of(const summand<C, type_list<F...>>&) noexcept {
+        if constexpr (sizeof...(F) == 0)
+            return C{};
+        else
+            return xp::product(C{}, expression_of(F{})...);
+    }
+
+    template<typename S>
+    struct is_negative_summand;
+    template<typename C, typename F>
+    struct is_negative_summand<summand<C, F>> : is_negative_value<C> {};
+
+    template<typename S>
+    struct is_non_negative_summand : std::bool_constant<!is_negative_summand<S>::value> {};
+
+    template<typename... S>
+    inline constexpr auto flat_sum_of(const type_list<S...>&) noexcept {
+        return xp::sum(expression_of(S{})...);
+    }
+
+    // sums with negative coefficients are expressed as the difference of two (flat) sums with positive coefficients
+    template<typename list>
+    inline constexpr auto sum_of(const list&) noexcept {
+        using positive = filtered_list_t<is_non_negative_summand, list>;
+        using negative = filtered_list_t<is_negative_summand, list>;
+        if constexpr (negative::size == 0 or positive::size == 0)
+            return flat_sum_of(list{});
+        else
+            return flat_sum_of(positive{}) - flat_sum_of(typename negated<negative>::type{});
+    }
+
+    // operations other than sums and products are rebuilt from their simplified operands
+    template<typename op, typename... Ts>
+    inline constexpr auto rebuilt(const operation<op, Ts...>&) noexcept {
+        return operation<op, canonical_t<Ts>...>{};
+    }
+
+    template<typename... Ts>
+    inline constexpr auto rebuilt(const operation<operators::multiply, Ts...>&) noexcept {
+        return xp::product(canonical_t<Ts>{}...);
+    }
+
+    template<typename A, typename B>
+    inline constexpr auto rebuilt(const operation<operators::divide, A, B>&) noexcept {
+        return canonical_t<A>{}/canonical_t<B>{};
+    }
+
+    template<typename A, typename B>
+    inline constexpr auto rebuilt(const operation<operators::pow, A, B>&) noexcept {
+        return pow(canonical_t<A>{}, canonical_t<B>{});
+    }
+
+    template<typename A>
+    inline constexpr auto rebuilt(const operation<operators::log, A>&) noexcept {
+        return log(canonical_t<A>{});
+    }
+
+    template<typename T>
+    struct is_operation : std::false_type {};
+    template<typename op, typename... Ts>
+    struct is_operation<operation<op, Ts...>> : std::true_type {};
+
+    template<typename E>
+    inline constexpr auto canonical(const E&) noexcept {
+        if constexpr (is_sum_or_product<E>::value)
+            return sum_of(typename collected_summands_of<E>::type{});
+        else if constexpr (is_operation<E>::value)
+            return rebuilt(E{});
+        else
+            return E{};
+    }
+
+}  // namespace detail::simplification
+#endif  // DOXYGEN
+
+/*!
+ * \brief Return a simplified, canonical form of the given expression. Chains of additions, subtractions and
+ *        multiplications are flattened, constant factors (`value<v>`) are collected into a single coefficient per
+ *        term, like terms are merged by adding their coefficients, and powers of the same base are merged by adding
+ *        their exponents. For instance, `a*b + b*a + a*b` becomes `3*a*b`, and `a*a*b*pow(a, val<-2>)` becomes `b`.
+ *        Terms and factors appear in the order of their first occurrence, with constant terms moved to the end,
+ *        and they are combined into flat n-ary sums and products (see `sum` and `product`).
+ * \note Products involving tensors are left unchanged (apart from simplifying their operands), as they do not
+ *       commute in general.
+ */
+template<expression E>
+inline constexpr auto simplify(const E&) noexcept {
+    return detail::simplification::canonical(E{});
+}
+
+namespace traits {
+
+//! Trait to get the type of the simplified form of an expression (see `simplify`)
+template<typename E>
+struct simplified_of : std::type_identity<std::remove_cvref_t<decltype(xp::simplify(std::declval<const E&>()))>> {};
+template<typename E>
+using simplified_of_t = typename simplified_of<E>::type;
+
+}  // namespace traits
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Solvers
+ * \brief Newton solver for many independent scalar equations that share the same expression.
+ */
+#pragma once
+
+#include <span>
+#include <cmath>
+#include <vector>
+#include <ranges>
+#include <numeric>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <iostream>
+
+#include <xpress/concepts.hpp>
+#include <xpress/bindings.hpp>
+#include <xpress/expressions.hpp>
+#include <xpress/evaluation.hpp>
+#include <xpress/traits.hpp>
+#include <xpress/batch.hpp>
+#include <xpress/parallel.hpp>
+
+#include "common.hpp"
+
+
+namespace xp::solvers {
+
+//! \addtogroup Solvers
+//! \{
+
+//! Outcome for one of the systems solved by the `batched_newton` solver
+enum class batch_status : std::uint8_t {
+    converged,
+    not_converged,     //!< the maximum number of iterations was reached
+    singular_jacobian, //!< the derivative vanished before convergence
+    diverged           //!< the residual or the derivative became infinite or NaN
+};
+
+//! Report on a batched solve, containing the status and the number of iterations for each system
+struct batch_report {
+    std::vector<batch_status> status;
+    std::vector<std::size_t> iterations;
+
+    std::size_t size() const noexcept { return status.size(); }
+    std::size_t converged_count() const noexcept {
+        return static_cast<std::size_t>(std::ranges::count(status, batch_status::converged));
+    }
+    bool all_converged() const noexcept { return converged_count() == size(); }
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // return the block of values of the given systems, padding it with the values of the first system in the tail
+    template<std::size_t n, typename V>
+    inline constexpr decltype(auto) gathered_block_of(const V& values, std::span<const std::size_t> systems) noexcept {
+        if constexpr (std::ranges::contiguous_range<V>) {
+            using scalar = std::remove_cvref_t<std::ranges::range_value_t<V>>;
+            const auto data = std::ranges::data(values);
+            value_block<scalar, n> result;
+            for (std::size_t k = 0; k < n; ++k)
+                result.values[k] = data[k < systems.size() ? systems[k] : systems[0]];
+            return result;
+        } else {
+            return (values);
+        }
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Finds the roots of many independent scalar equations that differ only in the values bound to their symbols,
+ *        e.g. the same equation for each cell of a grid. The unknowns and parameters are bound to contiguous arrays
+ *        (with one entry per system), or to scalars that are shared among all systems. The residuals and derivatives
+ *        of all unconverged systems are evaluated together in blocks of `batch_block_size` (see `evaluator::batch`),
+ *        and converged systems are removed from the set of active systems after each iteration.
+ *        \code{.cpp}
+ *            var x;
+ *            let c;
+ *            std::vector<double> guess(1000, 1.0), params = ...;
+ *            const auto report = batched_newton{{.threshold = 1e-10, .max_iterations = 20}}.find_roots_of(
+ *                x*x - c, x = std::span{guess}, c = std::span{params}
+ *            );  // guess now contains the solutions
+ *        \endcode
+ */
+template<typename T = double> requires(std::is_floating_point_v<T>)
+struct batched_newton {
+    constexpr batched_newton(solver_options<T>&& opts) noexcept
+    : _opts{std::move(opts)}
+    {}
+
+    //! Solve all systems, overwriting the initial guesses bound to the unknown with the solutions
+    template<expression E, binder... V>
+    batch_report find_roots_of(const E& equation, const V&... values) const {
+        const bindings<V...> all_values{values...};
+        auto report = _make_report(_system_count(all_values, traits::variables_of_t<E>{}));
+        _solve(equation, all_values, report, 0, traits::variables_of_t<E>{});
+        _log_summary(report);
+        return report;
+    }
+
+    /*!
+     * \brief Solve all systems, distributing contiguous chunks of them over multiple cores (see `parallel_transform`).
+     * \param policy Either `xp::threads{n}`, or a standard execution policy (e.g. `std::execution::par_unseq`).
+     */
+    template<typename P, expression E, binder... V>
+        requires(xp::detail::parallel_policy<P>)
+    batch_report find_roots_of(P&& policy, const E& equation, const V&... values) const {
+        const bindings<V...> all_values{values...};
+        auto report = _make_report(_system_count(all_values, traits::variables_of_t<E>{}));
+        xp::detail::for_each_chunk(std::forward<P>(policy), report.size(), batch_block_size, [&] (std::size_t begin, std::size_t end) {
+            _solve(
+                equation,
+                bindings{value_binder{
+                    typename V::symbol_type{},
+                    xp::detail::chunk_of(all_values[typename V::symbol_type{}], begin, end)
+                }...},
+                report,
+                begin,
+                traits::variables_of_t<E>{}
+            );
+        });
+        _log_summary(report);
+        return report;
+    }
+
+ private:
+    template<typename... V, typename... X>
+    static std::size_t _system_count(const bindings<V...>&, const type_list<X...>&) noexcept {
+        static_assert(sizeof...(X) == 1, "Batched Newton solver requires scalar equations with a single unknown.");
+        return 0;
+    }
+
+    template<typename... V, typename X>
+    static std::size_t _system_count(const bindings<V...>& values, const type_list<X>&) noexcept {
+        using unknowns_t = std::remove_cvref_t<decltype(values[X{}])>;
+        static_assert(
+            std::ranges::contiguous_range<const unknowns_t>
+            and !std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<const unknowns_t>>>,
+            "The unknown must be bound to a mutable contiguous range (e.g. std::span<double>)."
+        );
+        const std::size_t count = std::ranges::size(values[X{}]);
+        assert(([&] () {
+            const auto& value = values[typename V::symbol_type{}];
+            if constexpr (std::ranges::contiguous_range<std::remove_cvref_t<decltype(value)>>)
+                return std::ranges::size(value) >= count;
+            return true;
+        } () and ...) && "Arrays of parameter values must have at least as many entries as there are unknowns.");
+        return count;
+    }
+
+    static batch_report _make_report(std::size_t count) {
+        return {
+            .status = std::vector<batch_status>(count, batch_status::not_converged),
+            .iterations = std::vector<std::size_t>(count, 0)
+        };
+    }
+
+    template<expression E, typename... V, typename X>
+    void _solve(const E&,
+                const bindings<V...>& values,
+                batch_report& report,
+                std::size_t offset,
+                const type_list<X>&) const {
+        static constexpr std::size_t n = batch_block_size;
+        static constexpr std::size_t done = static_cast<std::size_t>(-1);
+        const auto unknowns = std::ranges::data(values[X{}]);
+        using scalar = std::remove_cvref_t<decltype(*unknowns)>;
+
+        std::vector<std::size_t> active(std::ranges::size(values[X{}]));
+        std::iota(active.begin(), active.end(), std::size_t{0});
+
+        const auto threshold_squared = static_cast<scalar>(_opts.threshold*_opts.threshold);
+        for (std::size_t iteration = 0; !active.empty(); ++iteration) {
+            for (std::size_t begin = 0; begin < active.size(); begin += n) {
+                const std::span<const std::size_t> systems{active.data() + begin, std::min(n, active.size() - begin)};
+                const auto block_values = bindings{value_binder{
+                    typename V::symbol_type{},
+                    detail::gathered_block_of<n>(values[typename V::symbol_type{}], systems)
+                }...};
+                const auto [residual, derivatives] = value_and_derivatives_of(E{}, type_list<X>{}, block_values);
+
+                for (std::size_t k = 0; k < systems.size(); ++k) {
+                    const std::size_t i = systems[k];
+                    const auto r = static_cast<scalar>(xp::detail::block_entry(residual, k));
+                    const auto j = static_cast<scalar>(xp::detail::block_entry(derivatives[X{}], k));
+                    const bool is_finite = std::isfinite(r) and std::isfinite(j);
+                    if (is_finite and r*r > threshold_squared and iteration < _opts.max_iterations and j != scalar{0}) {
+                        unknowns[i] -= r/j;
+                        continue;
+                    }
+
+                    report.status[offset + i] = !is_finite ? batch_status::diverged
+                                                : r*r <= threshold_squared ? batch_status::converged
+                                                : iteration >= _opts.max_iterations ? batch_status::not_converged
+                                                : batch_status::singular_jacobian;
+                    report.iterations[offset + i] = iteration;
+                    active[begin + k] = done;
+                }
+            }
+
+            // compact the active systems, such that subsequent iterations only evaluate full blocks of those
+            std::erase(active, done);
+        }
+    }
+
+    void _log_summary(const batch_report& report) const {
+        auto logger = _opts.verbosity_level >= 1
+            ? progress_logger::active(std::cout)
+            : progress_logger::suppressed(std::cout);
+        logger << " -- batched Newton solver: " << report.converged_count()
+               << " of " << report.size() << " systems converged.\n";
+    }
+
+    solver_options<T> _opts;
+};
+
+//! \} group Solvers
+
+}  // namespace xp::solvers
@@ -7,7 +7,10 @@
  */
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <utility>
+#include <concepts>
 #include <type_traits>
 #include <ostream>
 
@@ -25,14 +28,70 @@ inline constexpr auto starting_from(B&&... b) noexcept {
     return bindings{std::forward<B>(b)...};
 }
 
-//! Basic options for iterative solvers
+//! Status of an iterative solver reported to observers
+enum class solver_status {
+    iterating,         //!< the solver has not converged yet and continues with the next iteration
+    converged,
+    not_converged,     //!< the maximum number of iterations was reached
+    singular_jacobian
+};
+
+//! Time (in seconds) a solver spent in its different phases
+struct solver_timings {
+    double residual_evaluation = 0.0;  //!< evaluations of the residual only
+    double jacobian_evaluation = 0.0;  //!< evaluations of the Jacobian (together with the residual, in a single pass)
+    double linear_solve = 0.0;
+};
+
+//! Data on an iteration of a solver, reported to observers (see `solver_options`)
 template<typename T = double>
+struct solver_event {
+    solver_status status;
+    std::size_t iteration;
+    T residual_norm;  //!< Euclidean norm of the residual (or its absolute value for scalar equations)
+    solver_timings timings;  //!< time spent since the previous event
+};
+
+//! Default observer for solvers, which ignores all events (and for which no telemetry is collected)
+struct no_observer {
+    template<typename T>
+    constexpr void operator()(const solver_event<T>&) const noexcept {}
+};
+
+//! Basic options for iterative solvers
+template<typename T = double, typename O = no_observer>
+    requires(std::invocable<const O&, const solver_event<T>&>)
 struct solver_options {
     T threshold;
     std::size_t max_iterations;
     unsigned int verbosity_level = 0;
+    //! Callable invoked with a `solver_event` after each iteration, e.g. to feed a metrics system
+    [[no_unique_address]] O observer = {};
 };
 
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename O>
+    inline constexpr bool is_observer_v = !std::is_same_v<std::remove_cvref_t<O>, no_observer>;
+
+    // invoke f, adding the elapsed time to the given seconds if timing is enabled (and not in constant evaluation)
+    template<bool enabled, std::invocable F>
+    inline constexpr auto timed(double& seconds, F&& f) {
+        if constexpr (enabled) {
+            if (!std::is_constant_evaluated()) {
+                const auto start = std::chrono::steady_clock::now();
+                auto result = f();
+                seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                return result;
+            }
+        }
+        return f();
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
 //! Small wrapper around an std::ostream to activate/deactivate progress output
 class progress_logger {
  public:
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Solvers
+ * \brief Levenberg-Marquardt (and Gauss-Newton) solver for nonlinear least-squares problems.
+ */
+#pragma once
+
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
+#include <iostream>
+
+#include <xpress/concepts.hpp>
+#include <xpress/bindings.hpp>
+#include <xpress/expressions.hpp>
+#include <xpress/evaluation.hpp>
+#include <xpress/traits.hpp>
+#include <xpress/linalg.hpp>
+
+#include "common.hpp"
+
+
+namespace xp::solvers {
+
+//! \addtogroup Solvers
+//! \{
+
+//! Options for the adaptive damping in the Levenberg-Marquardt solver
+template<typename T = double>
+struct damping_options {
+    T initial = T{1e-3};  //!< initial damping factor (with zero, the solver performs undamped Gauss-Newton steps)
+    T increase = T{10};   //!< factor by which the damping is increased after a rejected step
+    T decrease = T{10};   //!< factor by which the damping is decreased after an accepted step
+};
+
+/*!
+ * \brief Finds the parameters that minimize the sum of squares of a vector of residuals, i.e. it solves the (possibly
+ *        over-determined) nonlinear least-squares problem `min_x |r(x)|^2` with the unknowns x being the variables of
+ *        the residual expression. In each iteration, the Jacobian J is evaluated with the residuals in a single pass, and
+ *        the step follows from the damped normal equations `(J^T*J + lambda*diag(J^T*J))*dx = J^T*r`. Steps that do not
+ *        reduce the sum of squares are rejected and the damping factor lambda is increased, while it is decreased after
+ *        accepted steps. The solver converges once the gradient `J^T*r` or the step falls below the threshold.
+ */
+template<typename T = double> requires(is_scalar_v<T>)
+struct levenberg_marquardt {
+    constexpr levenberg_marquardt(solver_options<T>&& opts, damping_options<T>&& damping = {}) noexcept
+    : _opts{std::move(opts)}
+    , _damping{std::move(damping)}
+    {}
+
+    template<expression E, typename... I>
+    constexpr auto find_least_squares_solution_of(const E& residuals, bindings<I...>&& initial_guess) const noexcept {
+        static_assert(
+            !std::conjunction_v<std::is_const<std::remove_reference_t<
+                decltype(initial_guess[typename I::symbol_type{}])
+            >>...>,
+            "Bindings to const refs are not supported as initial guess is updated with the solution."
+        );
+
+        using result_t = std::optional<bindings<I...>>;
+        using variables = traits::variables_of_t<E>;
+        auto [residual, jacobian] = _evaluate(residuals, initial_guess, variables{});
+        auto normal_matrix = _normal_matrix_of(jacobian);
+        auto gradient = _gradient_of(jacobian, residual);
+        auto cost = linalg::dot(residual, residual);
+
+        using scalar = scalar_type_t<decltype(residual)>;
+        const auto threshold_squared = static_cast<scalar>(_opts.threshold*_opts.threshold);
+        auto damping = static_cast<scalar>(_damping.initial);
+        std::size_t iteration = 0;
+        while (linalg::dot(gradient, gradient) > threshold_squared) {
+            if (iteration >= _opts.max_iterations) {
+                if (!std::is_constant_evaluated())
+                    _logger(1) << " -- Levenberg-Marquardt solver did not converge after " << iteration << " iterations.\n";
+                return result_t{};
+            }
+            ++iteration;
+
+            auto damped_matrix = normal_matrix;
+            for (std::size_t i = 0; i < variables::size; ++i)
+                damped_matrix[i, i] += damping*normal_matrix[i, i];
+            const linalg::lu_factorization lu{std::move(damped_matrix)};
+            if (lu.is_singular()) {
+                if (damping == scalar{0}) {
+                    if (!std::is_constant_evaluated())
+                        _logger(1) << " -- Gauss-Newton solver encountered a singular matrix in iteration " << iteration << ".\n";
+                    return result_t{};
+                }
+                damping *= static_cast<scalar>(_damping.increase);
+                continue;
+            }
+
+            const auto step = lu.solve(gradient);
+            const auto previous = _values_of(initial_guess, variables{});
+            _apply(initial_guess, step, variables{});
+            auto [new_residual, new_jacobian] = _evaluate(residuals, initial_guess, variables{});
+            const auto new_cost = linalg::dot(new_residual, new_residual);
+            if (damping != scalar{0} and !(new_cost < cost)) {
+                _restore(initial_guess, previous, variables{});
+                // near the optimum, rounding errors may prevent tiny steps from reducing the cost
+                if (linalg::dot(step, step) <= threshold_squared) {
+                    if (!std::is_constant_evaluated())
+                        _logger(1) << " -- converged with a rejected step below the threshold in iteration " << iteration << "\n";
+                    break;
+                }
+                damping *= static_cast<scalar>(_damping.increase);
+                if (!std::is_constant_evaluated())
+                    _logger(2) << " -- rejected step in iteration " << iteration << "; damping = " << damping << "\n";
+                continue;
+            }
+
+            residual = std::move(new_residual);
+            jacobian = std::move(new_jacobian);
+            normal_matrix = _normal_matrix_of(jacobian);
+            gradient = _gradient_of(jacobian, residual);
+            cost = new_cost;
+            damping /= static_cast<scalar>(_damping.decrease);
+            if (!std::is_constant_evaluated())
+                _logger(1) << " -- finished iteration " << iteration << "; sum of squares = " << cost << "\n";
+            if (linalg::dot(step, step) <= threshold_squared)
+                break;
+        }
+
+        return result_t{std::move(initial_guess)};
+    }
+
+ private:
+    constexpr progress_logger _logger(unsigned int verbosity_level) const noexcept {
+        return verbosity_level <= _opts.verbosity_level
+            ? progress_logger::active(std::cout)
+            : progress_logger::suppressed(std::cout);
+    }
+
+    // evaluate the residuals (as a vector) and the Jacobian (as an m x n matrix) in one pass
+    template<expression E, typename... S, typename... V>
+    constexpr auto _evaluate(const E& residuals, const bindings<S...>& guess, const type_list<V...>& vars) const noexcept {
+        const auto [residual, derivatives] = value_and_derivatives_of(residuals, vars, guess);
+        using R = std::remove_cvref_t<decltype(residual)>;
+        using scalar = std::common_type_t<
+            linalg::detail::factorization_scalar_t<R>,
+            linalg::detail::factorization_scalar_t<std::remove_cvref_t<decltype(derivatives[V{}])>>...
+        >;
+        static constexpr std::size_t n = sizeof...(V);
+        if constexpr (is_scalar_v<R>) {
+            return std::pair{
+                linalg::tensor<scalar, md_shape<1>>{static_cast<scalar>(residual)},
+                linalg::tensor<scalar, md_shape<1, n>>{md_shape<1, n>{}, static_cast<scalar>(derivatives[V{}])...}
+            };
+        } else {
+            static_assert(shape_of_t<R>{}.dimensions == 1, "Least-squares problems require vectors of residuals.");
+            static constexpr std::size_t m = shape_of_t<R>{}.first();
+            static_assert(m >= n, "Least-squares problems require at least as many residuals as unknowns.");
+
+            linalg::tensor<scalar, md_shape<m>> residual_vector{scalar{0}};
+            linalg::tensor<scalar, md_shape<m, n>> jacobian{scalar{0}};
+            visit_indices_in(shape<m>, [&] <std::size_t i> (const md_index<i>& idx) constexpr {
+                residual_vector[i] = static_cast<scalar>(access<R>::at(idx, residual));
+                [&] <std::size_t... j> (const std::index_sequence<j...>&) constexpr {
+                    (..., (jacobian[i, j] = static_cast<scalar>(
+                        access<std::remove_cvref_t<decltype(derivatives[V{}])>>::at(idx, derivatives[V{}])
+                    )));
+                } (std::index_sequence_for<V...>{});
+            });
+            return std::pair{std::move(residual_vector), std::move(jacobian)};
+        }
+    }
+
+    // J^T*J
+    template<typename S, std::size_t m, std::size_t n>
+    constexpr auto _normal_matrix_of(const linalg::tensor<S, md_shape<m, n>>& jacobian) const noexcept {
+        linalg::tensor<S, md_shape<n, n>> result{S{0}};
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = i; j < n; ++j) {
+                for (std::size_t k = 0; k < m; ++k)
+                    result[i, j] += jacobian[k, i]*jacobian[k, j];
+                result[j, i] = result[i, j];
+            }
+        return result;
+    }
+
+    // J^T*r
+    template<typename S, std::size_t m, std::size_t n>
+    constexpr auto _gradient_of(const linalg::tensor<S, md_shape<m, n>>& jacobian,
+                                const linalg::tensor<S, md_shape<m>>& residual) const noexcept {
+        linalg::tensor<S, md_shape<n>> result{S{0}};
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t k = 0; k < m; ++k)
+                result[i] += jacobian[k, i]*residual[k];
+        return result;
+    }
+
+    template<typename... S, typename... V>
+    constexpr auto _values_of(const bindings<S...>& solution, const type_list<V...>&) const noexcept {
+        return std::tuple{static_cast<std::remove_cvref_t<decltype(solution[V{}])>>(solution[V{}])...};
+    }
+
+    template<typename... S, typename R, typename... V>
+    constexpr void _apply(bindings<S...>& solution, const R& step, const type_list<V...>&) const noexcept {
+        [&] <std::size_t... j> (const std::index_sequence<j...>&) constexpr {
+            (..., (solution[V{}] -= step[j]));
+        } (std::index_sequence_for<V...>{});
+    }
+
+    template<typename... S, typename P, typename... V>
+    constexpr void _restore(bindings<S...>& solution, const P& previous, const type_list<V...>&) const noexcept {
+        [&] <std::size_t... j> (const std::index_sequence<j...>&) constexpr {
+            (..., (solution[V{}] = std::get<j>(previous)));
+        } (std::index_sequence_for<V...>{});
+    }
+
+    solver_options<T> _opts;
+    damping_options<T> _damping;
+};
+
+//! \} group Solvers
+
+}  // namespace xp::solvers
@@ -7,7 +7,10 @@
  */
 #pragma once
 
+#include <array>
+#include <algorithm>
 #include <optional>
+#include <utility>
 #include <type_traits>
 #include <iostream>
 #include <string>
@@ -15,8 +18,11 @@
 #include <xpress/concepts.hpp>
 #include <xpress/bindings.hpp>
 #include <xpress/expressions.hpp>
+#include <xpress/evaluation.hpp>
 #include <xpress/traits.hpp>
+#include <xpress/math.hpp>
 #include <xpress/linalg.hpp>
+#include <xpress/jacobian.hpp>
 
 #include "common.hpp"
 
@@ -26,11 +32,31 @@ namespace xp::solvers {
 //! \addtogroup Solvers
 //! \{
 
-//! Finds the roots of nonlinear equations using Newton's method
-template<typename T = double> requires(is_scalar_v<T>)
+//! Strategies for obtaining the Jacobian in the iterations of the Newton solver
+enum class jacobian_update {
+    always,  //!< evaluate the Jacobian in each iteration
+    frozen,  //!< reuse an evaluated Jacobian for a number of iterations (see `jacobian_options`)
+    broyden  //!< evaluate the Jacobian only initially and apply Broyden's rank-1 updates in subsequent iterations
+};
+
+//! Options for the evaluation of Jacobians in the Newton solver
+struct jacobian_options {
+    jacobian_update update = jacobian_update::always;
+    std::size_t reevaluation_interval = 1;  //!< number of iterations a Jacobian is reused for with `jacobian_update::frozen`
+};
+
+/*!
+ * \brief Finds the roots of nonlinear equations using Newton's method. An observer given in the options is invoked
+ *        with a `solver_event` after each iteration, which contains the time spent in the evaluations and linear solves.
+ *        Without an observer, no timings are collected. For systems of equations whose Jacobian has structural zeros
+ *        (see `traits::jacobian_pattern_of`), only the non-zero entries are stored, and the linear systems are solved
+ *        per independent diagonal block of the Jacobian (see `linalg::block_lu_factorization`).
+ */
+template<typename T = double, typename O = no_observer> requires(is_scalar_v<T>)
 struct newton {
-    constexpr newton(solver_options<T>&& opts) noexcept
+    constexpr newton(solver_options<T, O>&& opts, jacobian_options&& jac_opts = {}) noexcept
     : _opts{std::move(opts)}
+    , _jac_opts{std::move(jac_opts)}
     {}
 
     template<expression E, typename I>
@@ -55,23 +81,56 @@ struct newton {
 
         using result_t = std::optional<bindings<I...>>;
         using variables = traits::variables_of_t<E>;
-        const auto gradient = derivatives_of(equation, variables{});
-        auto residual = value_of(equation, initial_guess);
+        solver_timings timings{};
+        auto [residual, jacobian] = detail::timed<observed>(timings.jacobian_evaluation, [&] () {
+            return _evaluate(equation, initial_guess, variables{});
+        });
 
         const auto threshold_squared = _opts.threshold*_opts.threshold;
         std::size_t iteration = 0;
+        std::size_t jacobian_age = 0;
         auto residual_norm_squared = _squared_norm_of(residual);
+        _notify(residual_norm_squared > threshold_squared ? solver_status::iterating : solver_status::converged,
+                iteration, residual_norm_squared, timings);
         while (residual_norm_squared > threshold_squared) {
             if (iteration >= _opts.max_iterations) {
+                _notify(solver_status::not_converged, iteration, residual_norm_squared, timings);
                 if (!std::is_constant_evaluated())
                     _logger(1) << " -- Newton solver did not converge after " << iteration << " iterations.\n";
                 return result_t{};
             }
 
-            residual = value_of(equation, initial_guess);
-            residual_norm_squared = _squared_norm_of(residual);
-            _update(initial_guess, residual, gradient.at(initial_guess), variables{});
+            auto step = detail::timed<observed>(timings.linear_solve, [&] () { return _step(jacobian, residual); });
+            if (!step) {
+                _notify(solver_status::singular_jacobian, iteration, residual_norm_squared, timings);
+                if (!std::is_constant_evaluated())
+                    _logger(1) << " -- Newton solver encountered a singular Jacobian in iteration " << iteration << ".\n";
+                return result_t{};
+            }
+            _apply(initial_guess, *step, variables{});
             ++iteration;
+            ++jacobian_age;
+
+            // evaluate the residual exactly once per iteration, and the Jacobian only if requested
+            if (_reevaluate_jacobian(jacobian_age)) {
+                auto [new_residual, new_jacobian] = detail::timed<observed>(timings.jacobian_evaluation, [&] () {
+                    return _evaluate(equation, initial_guess, variables{});
+                });
+                residual = std::move(new_residual);
+                jacobian = std::move(new_jacobian);
+                jacobian_age = 0;
+            } else {
+                auto new_residual = detail::timed<observed>(timings.residual_evaluation, [&] () {
+                    return _residual_from<decltype(residual)>(value_of(equation, initial_guess));
+                });
+                if (_jac_opts.update == jacobian_update::broyden)
+                    _broyden_update(jacobian, *step, residual, new_residual);
+                residual = std::move(new_residual);
+            }
+
+            residual_norm_squared = _squared_norm_of(residual);
+            _notify(residual_norm_squared > threshold_squared ? solver_status::iterating : solver_status::converged,
+                    iteration, residual_norm_squared, timings);
             if (!std::is_constant_evaluated())
                 _logger(1) << " -- finished iteration " << iteration << "; residual = " << residual_norm_squared << "\n";
         }
@@ -80,42 +139,184 @@ struct newton {
     }
 
  private:
+    static constexpr bool observed = detail::is_observer_v<O>;
+
+    // report the given state to the observer and reset the timings
+    template<typename N>
+    constexpr void _notify(solver_status status, std::size_t iteration, const N& squared_norm, solver_timings& timings) const {
+        if constexpr (observed) {
+            _opts.observer(solver_event<T>{
+                .status = status,
+                .iteration = iteration,
+                .residual_norm = static_cast<T>(math::sqrt(static_cast<T>(squared_norm))),
+                .timings = timings
+            });
+            timings = {};
+        }
+    }
+
     constexpr progress_logger _logger(unsigned int verbosity_level) const noexcept {
         return verbosity_level <= _opts.verbosity_level
             ? progress_logger::active(std::cout)
             : progress_logger::suppressed(std::cout);
     }
 
-    template<typename... S, typename R, typename G, typename V>
+    constexpr bool _reevaluate_jacobian(std::size_t jacobian_age) const noexcept {
+        switch (_jac_opts.update) {
+            case jacobian_update::frozen: return jacobian_age >= std::max(_jac_opts.reevaluation_interval, std::size_t{1});
+            case jacobian_update::broyden: return false;
+            default: return true;
+        }
+    }
+
+    // evaluate the residual and the Jacobian (as a scalar or a matrix) in one pass
+    template<expression E, typename... S, typename... V>
+    constexpr auto _evaluate(const E& equation, const bindings<S...>& guess, const type_list<V...>& vars) const noexcept {
+        const auto [residual, gradient] = value_and_derivatives_of(equation, vars, guess);
+        using R = std::remove_cvref_t<decltype(residual)>;
+        if constexpr (is_scalar_v<R>) {
+            static_assert(sizeof...(V) == 1, "Scalar equations must have a single unknown.");
+            using scalar = std::common_type_t<R, std::remove_cvref_t<decltype(gradient[V{}])>...>;
+            return std::pair{static_cast<scalar>(residual), static_cast<scalar>(gradient[V{}]...)};
+        } else {
+            static constexpr std::size_t n = sizeof...(V);
+            static_assert(
+                shape_of_t<R>{} == shape<n>,
+                "Newton solver requires equation systems with as many equations as unknowns."
+            );
+
+            using scalar = std::common_type_t<
+                scalar_type_t<R>,
+                scalar_type_t<std::remove_cvref_t<decltype(gradient[V{}])>>...
+            >;
+            if constexpr (_has_sparse_jacobian<E>(type_list<V...>{})) {
+                return std::pair{
+                    _residual_from<linalg::tensor<scalar, md_shape<n>>>(residual),
+                    xp::detail::assemble_sparse_jacobian<scalar, E>(vars, gradient)
+                };
+            } else {
+                linalg::tensor<scalar, md_shape<n, n>> jacobian{scalar{0}};
+                [&] <std::size_t... j> (const std::index_sequence<j...>&) constexpr {
+                    visit_indices_in(shape<n>, [&] <std::size_t i> (const md_index<i>& idx) constexpr {
+                        (..., (jacobian[i, j] = access<std::remove_cvref_t<decltype(gradient[V{}])>>::at(idx, gradient[V{}])));
+                    });
+                } (std::index_sequence_for<V...>{});
+                return std::pair{_residual_from<linalg::tensor<scalar, md_shape<n>>>(residual), std::move(jacobian)};
+            }
+        }
+    }
+
+    // true if the system's Jacobian is known to have structural zeros at compile-time
+    template<typename E, typename... V>
+    static constexpr bool _has_sparse_jacobian(const type_list<V...>&) noexcept {
+        if constexpr (is_complete_v<traits::jacobian_pattern_of<E, type_list<V...>>>)
+            return traits::jacobian_pattern_of_t<E, type_list<V...>>::size < sizeof...(V)*sizeof...(V);
+        else
+            return false;
+    }
+
+    // convert an evaluated residual into the type in which the solver stores it
+    template<typename R, typename V>
+    constexpr R _residual_from(const V& value) const noexcept {
+        if constexpr (is_scalar_v<R>)
+            return static_cast<R>(value);
+        else {
+            R result{scalar_type_t<R>{0}};
+            visit_indices_in(shape_of_t<R>{}, [&] <std::size_t i> (const md_index<i>& idx) constexpr {
+                result[i] = static_cast<scalar_type_t<R>>(access<V>::at(idx, value));
+            });
+            return result;
+        }
+    }
+
+    template<typename R> requires(is_scalar_v<R>)
+    constexpr std::optional<R> _step(const R& jacobian, const R& residual) const noexcept {
+        if (jacobian == R{0})
+            return {};
+        return residual/jacobian;
+    }
+
+    template<typename J, typename R> requires(tensorial<R>)
+    constexpr std::optional<R> _step(const J& jacobian, const R& residual) const noexcept {
+        const linalg::lu_factorization lu{jacobian};
+        if (lu.is_singular())
+            return {};
+        return lu.solve(residual);
+    }
+
+    template<typename S, std::size_t n, typename P, typename R> requires(tensorial<R>)
+    constexpr std::optional<R> _step(const linalg::sparse_tensor<S, md_shape<n, n>, P>& jacobian, const R& residual) const noexcept {
+        const linalg::block_lu_factorization lu{jacobian};
+        if (lu.is_singular())
+            return {};
+        return lu.solve(residual);
+    }
+
+    template<typename... S, typename R, typename V>
         requires(is_scalar_v<R>)
-    constexpr void _update(bindings<S...>& solution,
-                           const R& residual,
-                           const G& gradient,
-                           const type_list<V>&) const noexcept {
-        solution[V{}] -= residual/gradient[V{}];
+    constexpr void _apply(bindings<S...>& solution, const R& step, const type_list<V>&) const noexcept {
+        solution[V{}] -= step;
     }
 
-    template<typename... S, typename R, typename G, typename V1, typename V2>
+    template<typename... S, typename R, typename... V>
         requires(tensorial<R>)
-    constexpr void _update(bindings<S...>& solution,
-                           const R& residual,
-                           const G& gradient,
-                           const type_list<V1, V2>&) const noexcept {
-        static_assert(
-            shape_of_t<R>{}.first() == 2,
-            "Newton update currently only implemented for scalar equations or 2d equation systems."
-        );
-        const linalg::tensor jacobian{shape<2, 2>,
-            gradient[V1{}][at<0>()], gradient[V2{}][at<0>()],
-            gradient[V1{}][at<1>()], gradient[V2{}][at<1>()]
-        };
-        const auto jacobian_inverse = linalg::tensor{shape<2, 2>,
-            jacobian[at<1, 1>()], -jacobian[at<0, 1>()],
-            -jacobian[at<1, 0>()], jacobian[at<0, 0>()]
-        }*(1.0/linalg::determinant_of(jacobian));
-        const auto update = mat_mul(jacobian_inverse, residual);
-        solution[V1{}] -= update[at<0>()];
-        solution[V2{}] -= update[at<1>()];
+    constexpr void _apply(bindings<S...>& solution, const R& step, const type_list<V...>&) const noexcept {
+        [&] <std::size_t... j> (const std::index_sequence<j...>&) constexpr {
+            (..., (solution[V{}] -= step[j]));
+        } (std::index_sequence_for<V...>{});
+    }
+
+    // Broyden's rank-1 update J += (dr - J*dx)*dx^T/(dx^T*dx) with dx = -step
+    template<typename R> requires(is_scalar_v<R>)
+    constexpr void _broyden_update(R& jacobian, const R& step, const R& old_residual, const R& new_residual) const noexcept {
+        if (step != R{0})
+            jacobian = (old_residual - new_residual)/step;
+    }
+
+    template<typename J, typename R> requires(tensorial<R>)
+    constexpr void _broyden_update(J& jacobian, const R& step, const R& old_residual, const R& new_residual) const noexcept {
+        using scalar = scalar_type_t<R>;
+        static constexpr std::size_t n = shape_of_t<R>{}.first();
+        scalar step_norm_squared{0};
+        for (std::size_t i = 0; i < n; ++i)
+            step_norm_squared += step[i]*step[i];
+        if (step_norm_squared == scalar{0})
+            return;
+
+        // with dx = -step, we have (dr - J*dx) = new_residual - old_residual + J*step
+        R defect{scalar{0}};
+        for (std::size_t i = 0; i < n; ++i) {
+            defect[i] = new_residual[i] - old_residual[i];
+            for (std::size_t j = 0; j < n; ++j)
+                defect[i] += jacobian[i, j]*step[j];
+        }
+        for (std::size_t i = 0; i < n; ++i)
+            for (std::size_t j = 0; j < n; ++j)
+                jacobian[i, j] -= defect[i]*step[j]/step_norm_squared;
+    }
+
+    // Schubert's sparse variant of the update, which updates each row only at its stored entries: with the step
+    // s_i restricted to the stored columns of row i, we have J_i += (dr_i - J_i*dx)*s_i^T/(s_i^T*s_i)
+    template<typename S, std::size_t n, std::size_t... r, std::size_t... c, typename R> requires(tensorial<R>)
+    constexpr void _broyden_update(linalg::sparse_tensor<S, md_shape<n, n>, linalg::sparsity_pattern<md_index<r, c>...>>& jacobian,
+                                   const R& step,
+                                   const R& old_residual,
+                                   const R& new_residual) const noexcept {
+        static constexpr std::array<std::size_t, sizeof...(r)> rows{r...};
+        static constexpr std::array<std::size_t, sizeof...(c)> cols{c...};
+        auto& values = jacobian.stored_values();
+
+        R defect{S{0}};
+        R row_step_norms_squared{S{0}};
+        for (std::size_t i = 0; i < n; ++i)
+            defect[i] = new_residual[i] - old_residual[i];
+        for (std::size_t k = 0; k < values.size(); ++k) {
+            defect[rows[k]] += values[k]*step[cols[k]];
+            row_step_norms_squared[rows[k]] += step[cols[k]]*step[cols[k]];
+        }
+        for (std::size_t k = 0; k < values.size(); ++k)
+            if (row_step_norms_squared[rows[k]] != S{0})
+                values[k] -= defect[rows[k]]*step[cols[k]]/row_step_norms_squared[rows[k]];
     }
 
     template<typename R> requires(is_scalar_v<R>)
@@ -128,7 +329,8 @@ struct newton {
         return operators::traits::multiplication_of<R, R>{}(residual, residual);
     }
 
-    solver_options<T> _opts;
+    solver_options<T, O> _opts;
+    jacobian_options _jac_opts;
 };
 
 //! \} group Solvers
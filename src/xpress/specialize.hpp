@@ -0,0 +1,145 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Partial evaluation of expressions for values of a subset of their symbols.
+ */
+#pragma once
+
+#include <utility>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "traits.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "evaluation.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename B, typename symbols>
+    struct are_bound;
+    template<typename B, typename... S>
+    struct are_bound<B, type_list<S...>> : std::bool_constant<(true && ... && B::template has_bindings_for<S>)> {};
+
+    // composite nodes whose value follows from the bindings B alone
+    template<typename B, typename T>
+    struct is_staged_node : std::bool_constant<
+        traits::children_of_t<T>::size > 0 and are_bound<B, traits::symbols_of_t<T>>::value
+    > {};
+
+    template<typename B, typename children>
+    struct staged_nodes_in;
+
+    // the maximal sub-expressions of T whose values follow from the bindings B alone (except for those bound in B)
+    template<typename B, typename T, bool = B::template has_bindings_for<T>, bool = is_staged_node<B, T>::value>
+    struct staged_nodes_of : std::type_identity<type_list<>> {};
+    template<typename B, typename T>
+    struct staged_nodes_of<B, T, false, true> : std::type_identity<type_list<T>> {};
+    template<typename B, typename T>
+    struct staged_nodes_of<B, T, false, false> : staged_nodes_in<B, traits::children_of_t<T>> {};
+
+    template<typename B, typename... C>
+    struct staged_nodes_in<B, type_list<C...>> : concatenated<typename staged_nodes_of<B, C>::type...> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Evaluator for an expression E, for which the values of some of its symbols (the parameters P) are fixed.
+ *        On construction, the values of all maximal sub-expressions that depend on the parameters only (the
+ *        staged nodes S) are computed and stored, such that evaluations only compute the remaining part of
+ *        the expression from the values of the other symbols.
+ */
+template<typename E, typename P, typename S>
+class specialized_evaluator;
+
+template<typename E, typename... P, typename... S>
+class specialized_evaluator<E, bindings<P...>, type_list<S...>> {
+    using parameters = bindings<P...>;
+    using storage = bindings<
+        value_binder<typename P::symbol_type, typename P::value_type>...,
+        value_binder<S, detail::node_value_t<S, parameters>>...
+    >;
+
+ public:
+    //! The sub-expressions whose values are precomputed
+    using staged_nodes = type_list<S...>;
+
+    constexpr specialized_evaluator(const E&, const parameters& params) noexcept
+    : _values{_make_storage(params)}
+    {}
+
+    //! Evaluate the expression at the given values of the remaining symbols
+    template<binder... V>
+    constexpr auto operator()(V&&... values) const noexcept {
+        return at(bindings{std::forward<V>(values)...});
+    }
+
+    //! Evaluate the expression at the given values of the remaining symbols
+    template<binder... V>
+    constexpr auto at(V&&... values) const noexcept {
+        return at(bindings{std::forward<V>(values)...});
+    }
+
+    //! Evaluate the expression at the given value bindings of the remaining symbols
+    template<typename... V>
+    constexpr auto at(const bindings<V...>& values) const noexcept {
+        return xp::value_of(E{}, bindings{
+            value_binder{typename P::symbol_type{}, _values[typename P::symbol_type{}]}...,
+            value_binder{S{}, _values[S{}]}...,
+            value_binder{typename V::symbol_type{}, values[typename V::symbol_type{}]}...
+        });
+    }
+
+    //! Return the stored value of the given staged sub-expression (or parameter)
+    template<typename T> requires(storage::template has_bindings_for<T>)
+    constexpr decltype(auto) operator[](const T&) const noexcept {
+        return _values[T{}];
+    }
+
+ private:
+    static constexpr storage _make_storage(const parameters& params) noexcept {
+        using nodes = traits::evaluation_nodes_of_t<parameters, S...>;
+        return with_values_of(nodes{}, params, [&] <typename... B> (const bindings<B...>& node_values) constexpr {
+            return storage{
+                value_binder<typename P::symbol_type, typename P::value_type>{
+                    typename P::symbol_type{}, params[typename P::symbol_type{}]
+                }...,
+                value_binder<S, detail::node_value_t<S, parameters>>{S{}, detail::cached_value_of(S{}, node_values)}...
+            };
+        });
+    }
+
+    storage _values;
+};
+
+/*!
+ * \brief Return an evaluator for the given expression with the given parameter values fixed, which precomputes
+ *        the values of all sub-expressions that only depend on the parameters (see `specialized_evaluator`):
+ *        \code{.cpp}
+ *            let c;
+ *            var x;
+ *            const auto f = specialize(log(c*c)*x, at(c = 2.0));  // computes log(c*c) once
+ *            const double value = f(x = 3.0);
+ *        \endcode
+ * \note The parameter values are copied into the evaluator.
+ */
+template<expression E, typename... P>
+inline constexpr auto specialize(const E& expr, const bindings<P...>& params) noexcept {
+    using staged = last_occurrences_t<typename detail::staged_nodes_of<bindings<P...>, E>::type>;
+    return specialized_evaluator<E, bindings<P...>, staged>{expr, params};
+}
+
+//! \} group Expressions
+
+}  // namespace xp
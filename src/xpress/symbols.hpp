@@ -59,7 +59,10 @@ struct _symbol_value {
     static constexpr decltype(auto) from(const bindings<V...>& bindings) noexcept {
         // TODO: necessary?
         using bound_type = std::remove_cvref_t<decltype(bindings[T{}])>;
-        static_assert(is_scalar_v<bound_type>, "Symbol values have to be scalars");
+        static_assert(
+            is_scalar_v<bound_type> or is_runtime_sized_v<bound_type>,
+            "Symbol values have to be scalars (or runtime-sized containers of scalars)"
+        );
         return bindings[T{}];
     }
 };
@@ -85,8 +88,8 @@ template<typename T, auto _> struct derivative_of<let<T, _>> : _symbol_derivativ
 
 template<typename T>
 struct _bound_symbol_stream {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) {
         out << values[T{}];
     }
 };
@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Evaluators that interpolate expressions of few bounded inputs from precomputed tables.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "utils.hpp"
+#include "bindings.hpp"
+#include "concepts.hpp"
+#include "expressions.hpp"
+#include "operators.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! The range of values of an input of a tabulated expression
+template<typename T>
+struct interval {
+    T lower;
+    T upper;
+};
+
+template<typename T>
+interval(T, T) -> interval<T>;
+
+//! Interpolation schemes for tabulated expressions
+enum class interpolation : std::uint8_t {
+    linear,  //!< (multi-)linear interpolation of the values
+    cubic    //!< cubic Hermite interpolation of the values and (mixed) derivatives
+};
+
+//! Estimated error of a tabulated expression w.r.t. to the exact values of the expression
+template<typename T>
+struct tabulation_error {
+    T max_absolute;  //!< maximum absolute deviation
+    T max_relative;  //!< maximum deviation relative to the exact value (at points with nonzero exact value)
+};
+
+#ifndef DOXYGEN
+namespace detail {
+
+    inline constexpr std::size_t integer_power_of(std::size_t base, std::size_t exponent) noexcept {
+        std::size_t result = 1;
+        for (std::size_t i = 0; i < exponent; ++i)
+            result *= base;
+        return result;
+    }
+
+    // the derivative of the expression w.r.t. to all variables whose bits are set in the mask
+    template<std::size_t mask, typename E>
+    inline constexpr auto mixed_derivative_of(const E& expr, const type_list<>&) noexcept {
+        return expr;
+    }
+
+    template<std::size_t mask, typename E, typename X0, typename... X>
+    inline constexpr auto mixed_derivative_of(const E& expr, const type_list<X0, X...>&) noexcept {
+        if constexpr ((mask & 1) != 0)
+            return mixed_derivative_of<(mask >> 1)>(xp::derivative_of(expr, type_list<X0>{}), type_list<X...>{});
+        else
+            return mixed_derivative_of<(mask >> 1)>(expr, type_list<X...>{});
+    }
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Evaluator that interpolates an expression of the variables X from its values (and derivatives) at n equidistant
+ *        points per variable, which are sampled once on construction (possibly at compile-time). With cubic interpolation,
+ *        each table entry stores the value and the (mixed) derivatives obtained from `derivative_of`, contiguously, such
+ *        that an evaluation reads the 2^d neighbouring entries of the cell the point lies in. Points outside of the
+ *        tabulated ranges are clamped to the ranges.
+ * \note The expression must not depend on other symbols than the tabulated variables.
+ */
+template<typename E, typename X, typename T, std::size_t n, interpolation order>
+class tabulated_evaluator;
+
+template<typename E, typename... X, typename T, std::size_t n, interpolation order>
+class tabulated_evaluator<E, type_list<X...>, T, n, order> {
+    static_assert(n >= 2, "Tabulation requires at least two points per variable.");
+    static_assert(sizeof...(X) > 0, "Tabulation requires at least one variable.");
+
+    static constexpr std::size_t dimension = sizeof...(X);
+    static constexpr std::size_t corners = std::size_t{1} << dimension;
+    static constexpr std::size_t entries = order == interpolation::cubic ? corners : 1;
+    static constexpr std::size_t point_count = detail::integer_power_of(n, dimension);
+
+    using point = std::array<T, dimension>;
+
+ public:
+    using entry_type = std::array<T, entries>;
+
+    constexpr tabulated_evaluator(const E&, const std::array<interval<T>, dimension>& ranges) noexcept
+    : _ranges{ranges}
+    {
+        for (std::size_t d = 0; d < dimension; ++d) {
+            _spacing[d] = (ranges[d].upper - ranges[d].lower)/static_cast<T>(n - 1);
+            _stride[d] = detail::integer_power_of(n, dimension - 1 - d);
+        }
+        for (std::size_t i = 0; i < point_count; ++i)
+            _sample(i, _point_at(i));
+    }
+
+    //! Interpolate the expression at the given (bound) values
+    template<binder... V>
+    constexpr T operator()(V&&... values) const noexcept {
+        return at(bindings{std::forward<V>(values)...});
+    }
+
+    //! Interpolate the expression at the given value bindings
+    template<typename... V>
+    constexpr T at(const bindings<V...>& values) const noexcept {
+        return _interpolate(point{static_cast<T>(values[X{}])...});
+    }
+
+    /*!
+     * \brief Estimate the interpolation error by comparing against the exact values of the expression at
+     *        `samples_per_cell` equidistant points per variable in each cell of the table.
+     */
+    constexpr tabulation_error<T> estimated_error(std::size_t samples_per_cell = 4) const noexcept {
+        const std::size_t samples = (n - 1)*std::max(samples_per_cell, std::size_t{1}) + 1;
+        const std::size_t sample_count = detail::integer_power_of(samples, dimension);
+        const auto abs = [] (const T& t) constexpr { return t < T{0} ? -t : t; };
+
+        tabulation_error<T> result{T{0}, T{0}};
+        for (std::size_t i = 0; i < sample_count; ++i) {
+            point p{};
+            for (std::size_t d = dimension, remainder = i; d-- > 0; remainder /= samples)
+                p[d] = _ranges[d].lower
+                    + (_ranges[d].upper - _ranges[d].lower)*static_cast<T>(remainder%samples)/static_cast<T>(samples - 1);
+
+            const T exact = _exact_value_at<0>(p);
+            const T deviation = abs(_interpolate(p) - exact);
+            result.max_absolute = std::max(result.max_absolute, deviation);
+            if (exact != T{0})
+                result.max_relative = std::max(result.max_relative, deviation/abs(exact));
+        }
+        return result;
+    }
+
+    //! Return the number of tabulated points per variable
+    static constexpr std::size_t points_per_variable() noexcept {
+        return n;
+    }
+
+ private:
+    constexpr point _point_at(std::size_t i) const noexcept {
+        point p{};
+        for (std::size_t d = dimension; d-- > 0; i /= n) {
+            const std::size_t k = i%n;
+            p[d] = k == n - 1 ? _ranges[d].upper : _ranges[d].lower + static_cast<T>(k)*_spacing[d];
+        }
+        return p;
+    }
+
+    template<std::size_t mask>
+    constexpr T _exact_value_at(const point& p) const noexcept {
+        return [&] <std::size_t... d> (const std::index_sequence<d...>&) constexpr {
+            return static_cast<T>(xp::value_of(
+                detail::mixed_derivative_of<mask>(E{}, type_list<X...>{}),
+                bindings{value_binder{X{}, p[d]}...}
+            ));
+        } (std::make_index_sequence<dimension>{});
+    }
+
+    constexpr void _sample(std::size_t i, const point& p) noexcept {
+        [&] <std::size_t... mask> (const std::index_sequence<mask...>&) constexpr {
+            (..., (_table[i][mask] = _exact_value_at<mask>(p)));
+        } (std::make_index_sequence<entries>{});
+    }
+
+    // weight of the value (kind = 0) or derivative (kind = 1) at the lower (corner = 0) or upper (corner = 1) point of a cell
+    static constexpr T _basis(const T& u, std::size_t corner, std::size_t kind, const T& h) noexcept {
+        if constexpr (order == interpolation::linear)
+            return corner == 0 ? T{1} - u : u;
+        else {
+            const T u2 = u*u;
+            const T u3 = u2*u;
+            if (kind == 0)
+                return corner == 0 ? T{2}*u3 - T{3}*u2 + T{1} : T{-2}*u3 + T{3}*u2;
+            return h*(corner == 0 ? u3 - T{2}*u2 + u : u3 - u2);
+        }
+    }
+
+    constexpr T _interpolate(const point& p) const noexcept {
+        std::size_t base = 0;
+        point u{};
+        for (std::size_t d = 0; d < dimension; ++d) {
+            const T s = (std::clamp(p[d], _ranges[d].lower, _ranges[d].upper) - _ranges[d].lower)/_spacing[d];
+            const std::size_t cell = std::min(static_cast<std::size_t>(s), n - 2);
+            u[d] = s - static_cast<T>(cell);
+            base += cell*_stride[d];
+        }
+
+        T result{0};
+        for (std::size_t corner = 0; corner < corners; ++corner) {
+            std::size_t index = base;
+            for (std::size_t d = 0; d < dimension; ++d)
+                index += ((corner >> d) & 1)*_stride[d];
+
+            const entry_type& entry = _table[index];
+            for (std::size_t mask = 0; mask < entries; ++mask) {
+                T weight = entry[mask];
+                for (std::size_t d = 0; d < dimension; ++d)
+                    weight *= _basis(u[d], (corner >> d) & 1, (mask >> d) & 1, _spacing[d]);
+                result += weight;
+            }
+        }
+        return result;
+    }
+
+    std::array<interval<T>, dimension> _ranges;
+    std::array<T, dimension> _spacing{};
+    std::array<std::size_t, dimension> _stride{};
+    std::array<entry_type, point_count> _table{};
+};
+
+/*!
+ * \brief Tabulate the given expression on the given ranges of its variables with n points per variable (see `tabulated_evaluator`):
+ *        \code{.cpp}
+ *            var t;
+ *            const auto f = tabulate<128>(log(t)*pow(t, val<3>), wrt(t), interval{1.0, 2.0});
+ *            const auto value = f(t = 1.5);
+ *        \endcode
+ */
+template<std::size_t n, interpolation order = interpolation::cubic, expression E, typename... X, typename... T>
+    requires(sizeof...(X) == sizeof...(T) and (... and is_scalar_v<T>))
+inline constexpr auto tabulate(const E& expr, const type_list<X...>&, const interval<T>&... ranges) noexcept {
+    using scalar = std::common_type_t<T...>;
+    static_assert(std::is_floating_point_v<scalar>, "Tabulation requires floating-point ranges.");
+    return tabulated_evaluator<E, type_list<X...>, scalar, n, order>{
+        expr, {interval<scalar>{static_cast<scalar>(ranges.lower), static_cast<scalar>(ranges.upper)}...}
+    };
+}
+
+//! \} group Expressions
+
+}  // namespace xp
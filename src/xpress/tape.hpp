@@ -0,0 +1,376 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+/*!
+ * \file
+ * \ingroup Expressions
+ * \brief Runtime representation of expressions as a flat tape of operations.
+ */
+#pragma once
+
+#include <span>
+#include <array>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "math.hpp"
+#include "utils.hpp"
+#include "traits.hpp"
+#include "values.hpp"
+#include "bindings.hpp"
+#include "expressions.hpp"
+#include "evaluation.hpp"
+#include "operators.hpp"
+#include "batch.hpp"
+
+
+namespace xp {
+
+//! \addtogroup Expressions
+//! \{
+
+//! Operations that can be recorded on a tape
+enum class tape_operator : std::uint8_t {
+    input,     //!< value of the input with index `first`
+    constant,  //!< constant with index `first`
+    add,
+    subtract,
+    multiply,
+    divide,
+    pow,
+    log        //!< unary operation on `first`
+};
+
+//! A node on a tape, i.e. an operator applied to the nodes with the indices `first` and `second`
+struct tape_node {
+    tape_operator op;
+    std::uint32_t first = 0;
+    std::uint32_t second = 0;
+};
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    template<typename op>
+    struct tape_operator_of;
+    template<> struct tape_operator_of<operators::add> : std::integral_constant<tape_operator, tape_operator::add> {};
+    template<> struct tape_operator_of<operators::subtract> : std::integral_constant<tape_operator, tape_operator::subtract> {};
+    template<> struct tape_operator_of<operators::multiply> : std::integral_constant<tape_operator, tape_operator::multiply> {};
+    template<> struct tape_operator_of<operators::divide> : std::integral_constant<tape_operator, tape_operator::divide> {};
+    template<> struct tape_operator_of<operators::pow> : std::integral_constant<tape_operator, tape_operator::pow> {};
+    template<> struct tape_operator_of<operators::log> : std::integral_constant<tape_operator, tape_operator::log> {};
+
+    template<typename T>
+    struct is_constant_node : std::false_type {};
+    template<auto v>
+    struct is_constant_node<value<v>> : std::true_type {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+/*!
+ * \brief Runtime representation of (scalar) expressions with a fixed number of inputs, stored as a flat
+ *        array of nodes in evaluation order. Nodes refer to their operands by index, such that shared
+ *        sub-expressions are stored (and evaluated) only once. Tapes can be recorded from compile-time
+ *        expressions (see `tape_of`) or assembled programmatically, e.g. from configuration files:
+ *        \code{.cpp}
+ *            tape<double> t{2};  // nodes 0 and 1 are the inputs
+ *            t.mark_output(t.add(t.multiply(t.input(0), t.input(1)), t.constant(1.0)));
+ *        \endcode
+ */
+template<typename T = double> requires(is_scalar_v<T>)
+class tape {
+ public:
+    using value_type = T;
+    using index_type = std::uint32_t;
+
+    constexpr explicit tape(std::size_t input_count) {
+        for (std::size_t i = 0; i < input_count; ++i)
+            _nodes.push_back({tape_operator::input, static_cast<index_type>(i), 0});
+        _input_count = input_count;
+    }
+
+    //! Return the number of inputs
+    constexpr std::size_t input_count() const noexcept { return _input_count; }
+    //! Return the number of nodes on this tape (including inputs and constants)
+    constexpr std::size_t size() const noexcept { return _nodes.size(); }
+    //! Return the indices of the nodes that are outputs
+    constexpr std::span<const index_type> outputs() const noexcept { return _outputs; }
+    //! Return the nodes of this tape in evaluation order
+    constexpr std::span<const tape_node> nodes() const noexcept { return _nodes; }
+
+    //! Return the index of the node of the i-th input
+    constexpr index_type input(std::size_t i) const noexcept {
+        assert(i < _input_count && "Input index out of bounds.");
+        return static_cast<index_type>(i);
+    }
+
+    //! Record a constant and return the index of its node
+    constexpr index_type constant(const T& value) {
+        _constants.push_back(value);
+        return _push(tape_operator::constant, static_cast<index_type>(_constants.size() - 1), 0);
+    }
+
+    constexpr index_type add(index_type a, index_type b) { return _push(tape_operator::add, a, b); }
+    constexpr index_type subtract(index_type a, index_type b) { return _push(tape_operator::subtract, a, b); }
+    constexpr index_type multiply(index_type a, index_type b) { return _push(tape_operator::multiply, a, b); }
+    constexpr index_type divide(index_type a, index_type b) { return _push(tape_operator::divide, a, b); }
+    constexpr index_type pow(index_type a, index_type b) { return _push(tape_operator::pow, a, b); }
+    constexpr index_type log(index_type a) { return _push(tape_operator::log, a, a); }
+
+    //! Mark the given node as an output and return the index of the output
+    constexpr std::size_t mark_output(index_type node) {
+        assert(node < _nodes.size() && "Node index out of bounds.");
+        _outputs.push_back(node);
+        return _outputs.size() - 1;
+    }
+
+    /*!
+     * \brief Record the given expression on this tape and return the index of its root node. The given symbols are
+     *        mapped to the inputs (in the given order), and all other leaves of the expression must be constants.
+     */
+    template<expression E, typename... S>
+    constexpr index_type record(const E&, const type_list<S...>&) {
+        static_assert(sizeof...(S) <= std::numeric_limits<index_type>::max());
+        assert(sizeof...(S) <= _input_count && "Tape has fewer inputs than the given symbols.");
+        using nodes = traits::evaluation_nodes_of_t<bindings<>, E>;
+        using constants = filtered_list_t<detail::is_constant_node, traits::unique_leaf_nodes_of_t<E>>;
+        std::array<index_type, nodes::size + constants::size> ids{};
+        [&] <typename... C, typename... N> (const type_list<C...>&, const type_list<N...>&) constexpr {
+            std::size_t i = 0;
+            // each distinct constant is recorded once, and all references to it share its node
+            (..., (ids[nodes::size + i++] = constant(static_cast<T>(traits::value_of<C>::from(bindings<>{})))));
+            i = 0;
+            (..., (ids[i++] = _record(N{}, ids, nodes{}, constants{}, type_list<S...>{})));
+        } (constants{}, nodes{});
+        return _id_of(E{}, ids, nodes{}, constants{}, type_list<S...>{});
+    }
+
+    //! Evaluate all outputs at the given inputs, using the given scratch space for the values of all nodes
+    constexpr void evaluate(std::span<const T> inputs, std::span<T> outputs, std::span<T> scratch) const noexcept {
+        assert(outputs.size() >= _outputs.size() && "Output span is too small.");
+        _forward(inputs, scratch);
+        for (std::size_t o = 0; o < _outputs.size(); ++o)
+            outputs[o] = scratch[_outputs[o]];
+    }
+
+    //! Evaluate all outputs at the given inputs
+    constexpr void evaluate(std::span<const T> inputs, std::span<T> outputs) const {
+        std::vector<T> scratch(_nodes.size());
+        evaluate(inputs, outputs, scratch);
+    }
+
+    //! Return the value of the given output at the given inputs
+    constexpr T value(std::span<const T> inputs, std::size_t output = 0) const {
+        assert(output < _outputs.size() && "Output index out of bounds.");
+        std::vector<T> scratch(_nodes.size());
+        _forward(inputs, scratch);
+        return scratch[_outputs[output]];
+    }
+
+    /*!
+     * \brief Evaluate the given output and its gradient w.r.t. all inputs in reverse mode, that is, with a forward
+     *        sweep followed by a single adjoint sweep over the tape. Returns the value of the output.
+     */
+    constexpr T value_and_gradient(std::span<const T> inputs, std::span<T> gradient, std::size_t output = 0) const {
+        assert(output < _outputs.size() && "Output index out of bounds.");
+        assert(gradient.size() >= _input_count && "Gradient span is too small.");
+        std::vector<T> values(_nodes.size());
+        std::vector<T> adjoints(_nodes.size(), T{0});
+        _forward(inputs, values);
+
+        std::ranges::fill(gradient, T{0});
+        const index_type root = _outputs[output];
+        const std::vector<bool> is_active = _input_dependencies(root);
+        adjoints[root] = T{1};
+        for (std::size_t i = root + 1; i-- > 0;) {
+            const T adjoint = adjoints[i];
+            if (adjoint == T{0})
+                continue;
+            const auto& [op, a, b] = _nodes[i];
+            switch (op) {
+                case tape_operator::input: gradient[a] += adjoint; break;
+                case tape_operator::constant: break;
+                case tape_operator::add: adjoints[a] += adjoint; adjoints[b] += adjoint; break;
+                case tape_operator::subtract: adjoints[a] += adjoint; adjoints[b] -= adjoint; break;
+                case tape_operator::multiply:
+                    adjoints[a] += adjoint*values[b];
+                    adjoints[b] += adjoint*values[a];
+                    break;
+                case tape_operator::divide:
+                    adjoints[a] += adjoint/values[b];
+                    adjoints[b] -= adjoint*values[i]/values[b];
+                    break;
+                case tape_operator::pow:
+                    // the partial derivatives are not finite for some arguments, so only use those that are needed
+                    if (is_active[a])
+                        adjoints[a] += adjoint*math::pow_base_derivative(values[a], values[b]);
+                    if (is_active[b])
+                        adjoints[b] += adjoint*values[i]*operators::log{}(values[a]);
+                    break;
+                case tape_operator::log: adjoints[a] += adjoint/values[a]; break;
+            }
+        }
+        return values[root];
+    }
+
+    //! Evaluate the gradient of the given output w.r.t. all inputs in reverse mode (see `value_and_gradient`)
+    constexpr void gradient(std::span<const T> inputs, std::span<T> gradient, std::size_t output = 0) const {
+        value_and_gradient(inputs, gradient, output);
+    }
+
+    /*!
+     * \brief Evaluate all outputs at many points, where `inputs[i]` contains the values of the i-th input at all points
+     *        and the values of the o-th output are written into `outputs[o]`. The points are processed in blocks of
+     *        `batch_block_size`, such that each node is dispatched once per block (rather than once per point),
+     *        and its values are computed in a loop that compilers can vectorize.
+     */
+    constexpr void batch(std::span<const std::span<const T>> inputs, std::span<const std::span<T>> outputs) const {
+        static constexpr std::size_t n = batch_block_size;
+        assert(inputs.size() >= _input_count && "Too few input spans.");
+        assert(outputs.size() >= _outputs.size() && "Too few output spans.");
+        const std::size_t count = _outputs.empty() ? 0 : outputs[0].size();
+        assert(std::ranges::all_of(inputs.first(_input_count), [&] (const auto& in) { return in.size() >= count; })
+               && "Input spans must have at least as many entries as the outputs.");
+
+        std::vector<T> scratch(_nodes.size()*n);
+        for (std::size_t begin = 0; begin < count; begin += n) {
+            const std::size_t m = std::min(n, count - begin);
+            for (std::size_t i = 0; i < _nodes.size(); ++i) {
+                const auto& [op, a, b] = _nodes[i];
+                T* out = scratch.data() + i*n;
+                const T* x = scratch.data() + a*n;
+                const T* y = scratch.data() + b*n;
+                switch (op) {
+                    case tape_operator::input: std::copy_n(inputs[a].data() + begin, m, out); break;
+                    case tape_operator::constant: std::fill_n(out, m, _constants[a]); break;
+                    case tape_operator::add: for (std::size_t k = 0; k < m; ++k) out[k] = x[k] + y[k]; break;
+                    case tape_operator::subtract: for (std::size_t k = 0; k < m; ++k) out[k] = x[k] - y[k]; break;
+                    case tape_operator::multiply: for (std::size_t k = 0; k < m; ++k) out[k] = x[k]*y[k]; break;
+                    case tape_operator::divide: for (std::size_t k = 0; k < m; ++k) out[k] = x[k]/y[k]; break;
+                    case tape_operator::pow: for (std::size_t k = 0; k < m; ++k) out[k] = operators::pow{}(x[k], y[k]); break;
+                    case tape_operator::log: for (std::size_t k = 0; k < m; ++k) out[k] = operators::log{}(x[k]); break;
+                }
+            }
+            for (std::size_t o = 0; o < _outputs.size(); ++o)
+                std::copy_n(scratch.data() + _outputs[o]*n, m, outputs[o].data() + begin);
+        }
+    }
+
+ private:
+    constexpr index_type _push(tape_operator op, index_type a, index_type b) {
+        assert((op == tape_operator::constant or (a < _nodes.size() and b < _nodes.size())) && "Operand index out of bounds.");
+        assert(_nodes.size() < std::numeric_limits<index_type>::max() && "Too many nodes.");
+        _nodes.push_back({op, a, b});
+        return static_cast<index_type>(_nodes.size() - 1);
+    }
+
+    constexpr void _forward(std::span<const T> inputs, std::span<T> values) const noexcept {
+        assert(inputs.size() >= _input_count && "Too few inputs.");
+        assert(values.size() >= _nodes.size() && "Scratch space is too small.");
+        for (std::size_t i = 0; i < _nodes.size(); ++i) {
+            const auto& [op, a, b] = _nodes[i];
+            switch (op) {
+                case tape_operator::input: values[i] = inputs[a]; break;
+                case tape_operator::constant: values[i] = _constants[a]; break;
+                case tape_operator::add: values[i] = values[a] + values[b]; break;
+                case tape_operator::subtract: values[i] = values[a] - values[b]; break;
+                case tape_operator::multiply: values[i] = values[a]*values[b]; break;
+                case tape_operator::divide: values[i] = values[a]/values[b]; break;
+                case tape_operator::pow: values[i] = operators::pow{}(values[a], values[b]); break;
+                case tape_operator::log: values[i] = operators::log{}(values[a]); break;
+            }
+        }
+    }
+
+    // flags for the nodes up to the given one, telling if their values depend on any of the inputs
+    constexpr std::vector<bool> _input_dependencies(index_type last) const {
+        std::vector<bool> result(last + 1, false);
+        for (std::size_t i = 0; i <= last; ++i) {
+            const auto& [op, a, b] = _nodes[i];
+            switch (op) {
+                case tape_operator::input: result[i] = true; break;
+                case tape_operator::constant: result[i] = false; break;
+                case tape_operator::log: result[i] = result[a]; break;
+                default: result[i] = result[a] or result[b]; break;
+            }
+        }
+        return result;
+    }
+
+    // index of the node that holds the value of the given child of a recorded node, where the ids of the
+    // recorded nodes are followed by those of the constants
+    template<typename C, std::size_t n, typename nodes, typename constants, typename... S>
+    constexpr index_type _id_of(const C&,
+                                const std::array<index_type, n>& ids,
+                                const nodes&,
+                                const constants&,
+                                const type_list<S...>&) const noexcept {
+        if constexpr (detail::index_of_equal_node<C, type_list<S...>>::value < sizeof...(S))
+            return input(detail::index_of_equal_node<C, type_list<S...>>::value);
+        else if constexpr (detail::is_constant_node<C>::value)
+            return ids[nodes::size + detail::index_of_equal_node<C, constants>::value];
+        else {
+            static_assert(
+                detail::index_of_equal_node<C, nodes>::value < nodes::size,
+                "Leaves of recorded expressions must be constants or one of the given input symbols."
+            );
+            return ids[detail::index_of_equal_node<C, nodes>::value];
+        }
+    }
+
+    // record an operation (n-ary operations are recorded as a chain of binary operations)
+    template<typename op, typename C0, typename... Cs, std::size_t n, typename nodes, typename constants, typename... S>
+    constexpr index_type _record(const operation<op, C0, Cs...>&,
+                                 const std::array<index_type, n>& ids,
+                                 const nodes&,
+                                 const constants&,
+                                 const type_list<S...>&) {
+        static_assert(
+            is_complete_v<detail::tape_operator_of<op>>,
+            "Operator cannot be recorded on a tape (only scalar arithmetic, pow and log are supported)."
+        );
+        static constexpr tape_operator tape_op = detail::tape_operator_of<op>::value;
+        index_type result = _id_of(C0{}, ids, nodes{}, constants{}, type_list<S...>{});
+        if constexpr (sizeof...(Cs) == 0)
+            result = _push(tape_op, result, result);
+        else
+            (..., (result = _push(tape_op, result, _id_of(Cs{}, ids, nodes{}, constants{}, type_list<S...>{}))));
+        return result;
+    }
+
+    std::vector<tape_node> _nodes;
+    std::vector<T> _constants;
+    std::vector<index_type> _outputs;
+    std::size_t _input_count;
+};
+
+/*!
+ * \brief Record the given expression on a tape with the given symbols as inputs (in the given order),
+ *        and with the value of the expression as the only output:
+ *        \code{.cpp}
+ *            const auto t = tape_of(a*log(b), wrt(a, b));
+ *            const double value = t.value(std::array{1.0, 2.0});
+ *        \endcode
+ */
+template<typename T = double, expression E, typename... S>
+inline constexpr tape<T> tape_of(const E& expr, const type_list<S...>& inputs) {
+    tape<T> result{sizeof...(S)};
+    result.mark_output(result.record(expr, inputs));
+    return result;
+}
+
+//! Record the given expression on a tape with all its symbols as inputs (in the order of `traits::symbols_of_t`)
+template<typename T = double, expression E>
+inline constexpr tape<T> tape_of(const E& expr) {
+    return tape_of<T>(expr, traits::symbols_of_t<E>{});
+}
+
+//! \} group Expressions
+
+}  // namespace xp
@@ -8,12 +8,12 @@
 #pragma once
 
 #include <tuple>
-#include <ostream>
 
 #include "dtype.hpp"
 #include "utils.hpp"
 #include "traits.hpp"
 #include "expressions.hpp"
+#include "evaluation.hpp"
 #include "linalg.hpp"
 #include "values.hpp"
 
@@ -174,8 +174,8 @@ namespace traits {
 
 template<typename shape, typename T, auto _>
 struct stream<tensor<shape, T, _>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) {
         using self = tensor<shape, T, _>;
         out << values[self{}];
     }
@@ -183,30 +183,30 @@ struct stream<tensor<shape, T, _>> {
 
 template<typename tensor, std::size_t... i>
 struct stream<tensor_var<tensor, i...>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) {
         out << values[tensor{}] << "[" << xp::values<i...>{} << "]";
     }
 };
 
 template<typename shape, typename... E>
 struct stream<tensor_expression<shape, E...>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>& values) {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>& values) {
         out << "T" << shape{} << "(";
         _write_args_to(out, values, unique_leaf_nodes_of_t<tensor_expression<shape, E...>>{});
         out << ")";
     }
 
  private:
-    template<typename... V, typename L0, typename... L>
-    static constexpr void _write_args_to(std::ostream& out, const bindings<V...>& values, const type_list<L0, L...>&) {
+    template<typename O, typename... V, typename L0, typename... L>
+    static constexpr void _write_args_to(O& out, const bindings<V...>& values, const type_list<L0, L...>&) {
         stream<L0>::to(out, values);
         (..., (out << ", ", stream<L>::to(out, values)));
     }
 
-    template<typename... V>
-    static constexpr void _write_args_to(std::ostream& out, const bindings<V...>& values, const type_list<>&) {}
+    template<typename O, typename... V>
+    static constexpr void _write_args_to(O& out, const bindings<V...>& values, const type_list<>&) {}
 };
 
 template<typename shape, typename T, auto _>
@@ -230,11 +230,15 @@ struct value_of<tensor_var<tensor, i...>> {
     }
 };
 
+//! The components are evaluated jointly, such that sub-expressions they share are evaluated only once
 template<typename shape, typename... E>
 struct value_of<tensor_expression<shape, E...>> {
     template<typename... V>
     static constexpr decltype(auto) from(const bindings<V...>& values) {
-        return linalg::tensor{shape{}, xp::value_of(E{}, values)...};
+        using nodes = evaluation_nodes_of_t<bindings<V...>, E...>;
+        return with_values_of(nodes{}, values, [] <typename... B> (const bindings<B...>& node_values) constexpr {
+            return linalg::tensor{shape{}, xp::detail::cached_value_of(E{}, node_values)...};
+        });
     }
 };
 
@@ -250,9 +254,12 @@ struct nodes_of<tensor_var<tensor, i...>> {
 
 template<typename shape, typename... E>
 struct nodes_of<tensor_expression<shape, E...>> {
-    using type = merged_t<type_list<tensor_expression<shape, E...>>, merged_nodes_of_t<E...>>;
+    using type = concatenated_t<type_list<tensor_expression<shape, E...>>, merged_nodes_of_t<E...>>;
 };
 
+template<typename shape, typename... E>
+struct children_of<tensor_expression<shape, E...>> : std::type_identity<type_list<E...>> {};
+
 template<typename shape, typename T, auto _>
 struct derivative_of<tensor<shape, T, _>> {
     template<typename V>
@@ -8,8 +8,11 @@
 #pragma once
 
 #include <type_traits>
+#include <algorithm>
 #include <concepts>
-#include <ostream>
+#include <cstddef>
+#include <utility>
+#include <array>
 
 #include "type_traits.hpp"
 
@@ -80,12 +83,24 @@ struct nodes_of;
 template<typename T>
 using nodes_of_t = typename nodes_of<T>::type;
 
+//! Trait to get the list of the direct child nodes of a node in an expression tree (empty for leaf nodes)
+template<typename T>
+struct children_of : std::type_identity<type_list<>> {};
+template<typename T>
+using children_of_t = typename children_of<T>::type;
+
 //! Trait to compare two expressions for equality (can be specialized e.g. for commutative operators)
 template<typename A, typename B>
 struct is_equal_node : std::is_same<A, B> {};
 template<typename A, typename B>
 inline constexpr bool is_equal_node_v = is_equal_node<A, B>::value;
 
+//! Trait to get the operator of a node in an expression tree (void for nodes that are not operations)
+template<typename T>
+struct operator_of : std::type_identity<void> {};
+template<typename T>
+using operator_of_t = typename operator_of<T>::type;
+
 //! Trait to determine if a node is a leaf node (defaults to checking if there is only one node in its expression tree)
 template<typename T>
 struct is_leaf_node : std::bool_constant<nodes_of_t<T>::size == 1> {};
@@ -100,13 +115,13 @@ inline constexpr bool is_composite_node_v = is_composite_node<T>::value;
 
 //! All leaf nodes in the given expresssion
 template<typename T>
-struct leaf_nodes_of : std::type_identity<filtered_t<traits::is_leaf_node, nodes_of_t<T>>> {};
+struct leaf_nodes_of : std::type_identity<filtered_list_t<traits::is_leaf_node, nodes_of_t<T>>> {};
 template<typename T>
 using leaf_nodes_of_t = typename leaf_nodes_of<T>::type;
 
 //! All non-leaf nodes in the given expression
 template<typename T>
-struct composite_nodes_of : std::type_identity<filtered_t<traits::is_composite_node, nodes_of_t<T>>> {};
+struct composite_nodes_of : std::type_identity<filtered_list_t<traits::is_composite_node, nodes_of_t<T>>> {};
 template<typename T>
 using composite_nodes_of_t = typename composite_nodes_of<T>::type;
 
@@ -114,34 +129,32 @@ using composite_nodes_of_t = typename composite_nodes_of<T>::type;
 #ifndef DOXYGEN
 namespace detail {
 
-    template<typename merged, typename... Es>
-    struct merged_nodes_of;
-    template<typename... R>
-    struct merged_nodes_of<type_list<R...>> : std::type_identity<type_list<R...>> {};
-    template<typename... R, typename E0, typename... Es>
-    struct merged_nodes_of<type_list<R...>, E0, Es...> {
-        using type = typename merged_nodes_of<
-            merged_t<type_list<R...>, typename nodes_of<E0>::type>,
-            Es...
-        >::type;
+    // Among distinct types, flags the nodes for which no equal node follows. `is_equal_node` is only
+    // queried for pairs of nodes with the same operator, such that the number of instantiations is
+    // quadratic only in the number of distinct nodes per operator rather than in the number of nodes.
+    template<typename... U>
+    struct last_equal_nodes {
+        static constexpr std::array<const char*, sizeof...(U)> operator_tags{
+            &xp::detail::type_lists::tag<operator_of_t<U>>...
+        };
+
+        template<std::size_t a, typename A, std::size_t... b>
+        static consteval bool has_equal_successor(std::index_sequence<b...>) {
+            return (false || ... || xp::detail::type_lists::select<(b > a && operator_tags[a] == operator_tags[b])>
+                ::template type<traits::is_equal_node<A, U>, std::false_type>::value);
+        }
+
+        template<std::size_t... a>
+        static consteval std::array<bool, sizeof...(U)> mask(std::index_sequence<a...> s) {
+            return {!has_equal_successor<a, U>(s)...};
+        }
     };
 
     template<typename T>
     struct unique_nodes_of;
-
-    template<typename T, typename... Ts>
-    struct unique_nodes_of<type_list<T, Ts...>> {
-        using type = std::conditional_t<
-            std::disjunction_v<traits::is_equal_node<T, Ts>...>,
-            typename unique_nodes_of<type_list<Ts...>>::type,
-            merged_t<type_list<T>, typename unique_nodes_of<type_list<Ts...>>::type>
-        >;
-    };
-
-    template<>
-    struct unique_nodes_of<type_list<>> {
-        using type = type_list<>;
-    };
+    template<typename... U>
+    struct unique_nodes_of<type_list<U...>>
+    : xp::detail::type_lists::masked<last_equal_nodes<U...>::mask(std::index_sequence_for<U...>{}), U...> {};
 
     template<typename T>
     struct common_dtype_of;
@@ -155,40 +168,129 @@ namespace detail {
 
 //! Trait to get the merged list of nodes of all given expressions
 template<typename... T> requires(std::conjunction_v<is_complete<nodes_of<T>>...>)
-struct merged_nodes_of : detail::merged_nodes_of<type_list<>, T...> {};
+struct merged_nodes_of : concatenated<typename nodes_of<T>::type...> {};
 template<typename... T>
 using merged_nodes_of_t = typename merged_nodes_of<T...>::type;
 
-//! All unique nodes in the given expression
+/*!
+ * \brief All unique nodes in the given expression. Of equal nodes (see `is_equal_node`), the last occurrence
+ *        in `nodes_of_t<T>` is kept. Identical types are removed first, before comparing the remaining nodes.
+ */
 template<typename T>
-struct unique_nodes_of : std::type_identity<typename detail::unique_nodes_of<nodes_of_t<T>>::type> {};
+struct unique_nodes_of : std::type_identity<
+    typename detail::unique_nodes_of<last_occurrences_t<nodes_of_t<T>>>::type
+> {};
 template<typename T>
 using unique_nodes_of_t = typename unique_nodes_of<T>::type;
 
 //! All leaf nodes in the given expresssion
 template<typename T>
-struct unique_leaf_nodes_of : std::type_identity<filtered_t<traits::is_leaf_node, unique_nodes_of_t<T>>> {};
+struct unique_leaf_nodes_of : std::type_identity<filtered_list_t<traits::is_leaf_node, unique_nodes_of_t<T>>> {};
 template<typename T>
 using unique_leaf_nodes_of_t = typename unique_leaf_nodes_of<T>::type;
 
 //! All unique non-leaf nodes in the given expression
 template<typename T>
-struct unique_composite_nodes_of : std::type_identity<filtered_t<traits::is_composite_node, unique_nodes_of_t<T>>> {};
+struct unique_composite_nodes_of : std::type_identity<filtered_list_t<traits::is_composite_node, unique_nodes_of_t<T>>> {};
 template<typename T>
 using unique_composite_nodes_of_t = typename unique_composite_nodes_of<T>::type;
 
 //! All symbols in the given expression
 template<typename T>
-struct symbols_of : std::type_identity<filtered_t<traits::is_symbol, unique_leaf_nodes_of_t<T>>> {};
+struct symbols_of : std::type_identity<filtered_list_t<traits::is_symbol, unique_leaf_nodes_of_t<T>>> {};
 template<typename T>
 using symbols_of_t = typename symbols_of<T>::type;
 
 //! All variables in the given expression
 template<typename T>
-struct variables_of : std::type_identity<filtered_t<traits::is_variable, unique_leaf_nodes_of_t<T>>> {};
+struct variables_of : std::type_identity<filtered_list_t<traits::is_variable, unique_leaf_nodes_of_t<T>>> {};
 template<typename T>
 using variables_of_t = typename variables_of<T>::type;
 
+//! Trait to specify the estimated cost of evaluating an operator, relative to the cost of an addition
+template<typename op>
+struct operator_cost : std::integral_constant<std::size_t, 1> {};
+template<>
+struct operator_cost<void> : std::integral_constant<std::size_t, 0> {};
+template<typename op>
+inline constexpr std::size_t operator_cost_v = operator_cost<op>::value;
+
+//! Trait to get the depth of an expression tree (1 for leaf nodes)
+template<typename T>
+struct depth_of;
+
+
+#ifndef DOXYGEN
+namespace detail {
+
+    // number of (binary) operations performed to evaluate a node, where n-ary nodes combine their n operands in n - 1 operations
+    template<typename N>
+    inline constexpr std::size_t operations_in_node_v = children_of_t<N>::size > 2 ? children_of_t<N>::size - 1 : 1;
+
+    template<typename op, typename nodes>
+    struct operation_count_in;
+    template<typename op, typename... N>
+    struct operation_count_in<op, type_list<N...>>
+    : std::integral_constant<std::size_t, (
+        std::size_t{0} + ... + (std::is_same_v<operator_of_t<N>, op> ? operations_in_node_v<N> : std::size_t{0})
+    )> {};
+
+    template<typename nodes>
+    struct evaluation_cost_of;
+    template<typename... N>
+    struct evaluation_cost_of<type_list<N...>>
+    : std::integral_constant<std::size_t, (std::size_t{0} + ... + operator_cost_v<operator_of_t<N>>*operations_in_node_v<N>)> {};
+
+    template<typename children>
+    struct max_depth_of;
+    template<typename... C>
+    struct max_depth_of<type_list<C...>>
+    : std::integral_constant<std::size_t, std::max({std::size_t{0}, depth_of<C>::value...})> {};
+
+}  // namespace detail
+#endif  // DOXYGEN
+
+template<typename T>
+struct depth_of : std::integral_constant<std::size_t, 1 + detail::max_depth_of<children_of_t<T>>::value> {};
+template<typename T>
+inline constexpr std::size_t depth_of_v = depth_of<T>::value;
+
+//! Trait to get the number of nodes in the expression tree of T
+template<typename T>
+struct node_count_of : std::integral_constant<std::size_t, nodes_of_t<T>::size> {};
+template<typename T>
+inline constexpr std::size_t node_count_of_v = node_count_of<T>::value;
+
+//! Trait to get the number of unique nodes of T, i.e. the number of nodes of the graph in which equal nodes are shared
+template<typename T>
+struct unique_node_count_of : std::integral_constant<std::size_t, unique_nodes_of_t<T>::size> {};
+template<typename T>
+inline constexpr std::size_t unique_node_count_of_v = unique_node_count_of<T>::value;
+
+//! Trait to get the number of operations with the operator `op` in the expression tree of T (n-ary operations with n operands count n - 1 times)
+template<typename op, typename T>
+struct operation_count_of : detail::operation_count_in<op, nodes_of_t<T>> {};
+template<typename op, typename T>
+inline constexpr std::size_t operation_count_of_v = operation_count_of<op, T>::value;
+
+//! Trait to get the number of unique operations with the operator `op` in T
+template<typename op, typename T>
+struct unique_operation_count_of : detail::operation_count_in<op, unique_nodes_of_t<T>> {};
+template<typename op, typename T>
+inline constexpr std::size_t unique_operation_count_of_v = unique_operation_count_of<op, T>::value;
+
+//! Trait to get the estimated cost of evaluating T, visiting each node of its expression tree (see `operator_cost`)
+template<typename T>
+struct evaluation_cost_of : detail::evaluation_cost_of<nodes_of_t<T>> {};
+template<typename T>
+inline constexpr std::size_t evaluation_cost_of_v = evaluation_cost_of<T>::value;
+
+//! Trait to get the estimated cost of evaluating T, visiting each of its unique nodes only once (see `operator_cost`)
+template<typename T>
+struct unique_evaluation_cost_of : detail::evaluation_cost_of<unique_nodes_of_t<T>> {};
+template<typename T>
+inline constexpr std::size_t unique_evaluation_cost_of_v = unique_evaluation_cost_of<T>::value;
+
 //! Trait to flag a type as representing a unit value
 template<typename T>
 struct is_unit_value : std::false_type {};
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <array>
 
 #include <cpputils/type_traits.hpp>
 
@@ -22,12 +25,134 @@ namespace xp {
 // bring in all cpputils type traits
 using namespace cpputils;
 
+#ifndef DOXYGEN
+namespace detail::type_lists {
+
+    // an object with a unique address per type, such that types can be compared in constexpr
+    // loops without instantiating a trait (e.g. std::is_same) for each pair of types
+    template<typename T>
+    inline constexpr char tag = 0;
+
+    // alias-based selection between two types, which avoids instantiating std::conditional for each pair of types
+    template<bool>
+    struct select { template<typename T, typename F> using type = F; };
+    template<>
+    struct select<true> { template<typename T, typename F> using type = T; };
+
+    template<std::size_t i, typename T>
+    struct leaf {};
+
+    // inherits from leaf<i, T_i>, such that the i-th type is found by overload resolution in O(1)
+    template<typename seq, typename... T>
+    struct indexed_types;
+    template<std::size_t... i, typename... T>
+    struct indexed_types<std::index_sequence<i...>, T...> : leaf<i, T>... {};
+
+    template<std::size_t i, typename T>
+    std::type_identity<T> type_at(const leaf<i, T>&);
+
+    template<std::size_t n>
+    consteval std::size_t count_of(const std::array<bool, n>& mask) {
+        std::size_t count = 0;
+        for (bool m : mask)
+            count += m ? 1 : 0;
+        return count;
+    }
+
+    template<std::size_t count, std::size_t n>
+    consteval std::array<std::size_t, count> indices_of(const std::array<bool, n>& mask) {
+        std::array<std::size_t, count> result{};
+        for (std::size_t i = 0, k = 0; i < n; ++i)
+            if (mask[i])
+                result[k++] = i;
+        return result;
+    }
+
+    // mask flagging the last occurrence of each type in the list of the given tags
+    template<std::size_t n>
+    consteval std::array<bool, n> last_occurrences(const std::array<const char*, n>& tags) {
+        std::array<bool, n> result{};
+        for (std::size_t i = 0; i < n; ++i) {
+            result[i] = true;
+            for (std::size_t j = i + 1; j < n && result[i]; ++j)
+                result[i] = tags[i] != tags[j];
+        }
+        return result;
+    }
+
+    template<typename base, auto indices, std::size_t... k>
+    auto selected_at(std::index_sequence<k...>)
+        -> type_list<typename decltype(type_at<indices[k]>(std::declval<const base&>()))::type...>;
+
+    // the types T_i for which mask[i] is true, obtained with a single pack expansion
+    template<auto mask, typename... T>
+    struct masked {
+        static constexpr std::size_t count = count_of(mask);
+        using type = decltype(selected_at<
+            indexed_types<std::index_sequence_for<T...>, T...>,
+            indices_of<count>(mask)
+        >(std::make_index_sequence<count>{}));
+    };
+
+}  // namespace detail::type_lists
+#endif  // DOXYGEN
+
+/*!
+ * \brief Concatenation of the given type lists.
+ * \note In contrast to `merged_t`, this is variadic and concatenates up to four lists per instantiation.
+ */
+template<typename... lists>
+struct concatenated;
+template<>
+struct concatenated<> : std::type_identity<type_list<>> {};
+template<typename... A>
+struct concatenated<type_list<A...>> : std::type_identity<type_list<A...>> {};
+template<typename... A, typename... B, typename... lists>
+struct concatenated<type_list<A...>, type_list<B...>, lists...>
+: concatenated<type_list<A..., B...>, lists...> {};
+template<typename... A, typename... B, typename... C, typename... D, typename... lists>
+struct concatenated<type_list<A...>, type_list<B...>, type_list<C...>, type_list<D...>, lists...>
+: concatenated<type_list<A..., B..., C..., D...>, lists...> {};
+template<typename... lists>
+using concatenated_t = typename concatenated<lists...>::type;
+
+/*!
+ * \brief The types in the given list that fulfill the given predicate (in the order of the list).
+ * \note In contrast to `filtered_t`, this evaluates the predicates in one pack expansion and selects the types
+ *       via index sequences, instead of recursing through the list.
+ */
+template<template<typename> typename pred, typename list>
+struct filtered_list;
+template<template<typename> typename pred, typename... T>
+struct filtered_list<pred, type_list<T...>>
+: detail::type_lists::masked<std::array<bool, sizeof...(T)>{pred<T>::value...}, T...> {};
+template<template<typename> typename pred, typename list>
+using filtered_list_t = typename filtered_list<pred, list>::type;
+
+//! The list of the last occurrences of all distinct types in the given list (in the order of the list)
+template<typename list>
+struct last_occurrences;
+template<typename... T>
+struct last_occurrences<type_list<T...>>
+: detail::type_lists::masked<
+    detail::type_lists::last_occurrences(std::array<const char*, sizeof...(T)>{&detail::type_lists::tag<T>...}),
+    T...
+> {};
+template<typename list>
+using last_occurrences_t = typename last_occurrences<list>::type;
+
 //! Register a type to be a scalar
 template<typename T>
 struct is_scalar : std::bool_constant<std::is_floating_point_v<T> || std::is_integral_v<T>> {};
 template<typename T>
 inline constexpr bool is_scalar_v = is_scalar<T>::value;
 
+//! Register a type to hold a number of scalars that is known only at runtime, and which can be bound to symbols
+template<typename T>
+struct is_runtime_sized : std::false_type {};
+template<typename T>
+inline constexpr bool is_runtime_sized_v = is_runtime_sized<std::remove_cvref_t<T>>::value;
+
 //! Trait to expose if a type implements `operator[](std::size_t)`
 template<typename T>
 struct is_indexable : std::bool_constant< requires(const T& t) { {t[std::size_t{}] }; } > {};
@@ -85,11 +210,10 @@ struct access;
 template<typename A, typename B>
 concept same_remove_cvref_t_as = std::is_same_v<std::remove_cvref_t<A>, std::remove_cvref_t<B>>;
 
-//! A type that can be used for tensorial values
+//! A type that can be used for tensorial values (this includes non-owning views, e.g. `std::span<T, N>`)
 template<typename T>
 concept tensorial
-= std::is_default_constructible_v<std::remove_cvref_t<T>>  // TODO: can we relax this?
-and is_complete_v<scalar_type<std::remove_cvref_t<T>>>
+= is_complete_v<scalar_type<std::remove_cvref_t<T>>>
 and is_complete_v<shape_of<std::remove_cvref_t<T>>>
 and is_complete_v<access<std::remove_cvref_t<T>>>
 and requires(const T& t) {
@@ -8,7 +8,6 @@
 
 #pragma once
 
-#include <ostream>
 #include <utility>
 #include <type_traits>
 
@@ -57,7 +56,9 @@ struct md_shape {
         return values<s...>::at(idx);
     }
 
-    friend std::ostream& operator<<(std::ostream& out, const md_shape&) {
+    //! Write this shape into the given output (e.g. a std::ostream)
+    template<typename O> requires(requires(O& o) { o << values<s...>{}; })
+    friend constexpr O& operator<<(O& out, const md_shape&) {
         out << "<";
         out << values<s...>{};
         out << ">";
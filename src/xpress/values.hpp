@@ -67,8 +67,8 @@ struct derivative_of<value<v>> {
 
 template<auto v>
 struct stream<value<v>> {
-    template<typename... V>
-    static constexpr void to(std::ostream& out, const bindings<V...>&) {
+    template<typename O, typename... V>
+    static constexpr void to(O& out, const bindings<V...>&) {
         out << v;
     }
 };
@@ -7,3 +7,10 @@
 #include "symbols.hpp"
 #include "operators.hpp"
 #include "tensor.hpp"
+#include "evaluation.hpp"
+#include "reverse.hpp"
+#include "hessian.hpp"
+#include "specialize.hpp"
+#include "memoizing.hpp"
+#include "simplify.hpp"
+#include "batch.hpp"
@@ -0,0 +1,17 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <xpress/xp.hpp>
+
+#include "instantiated_evaluators.hpp"
+
+namespace xp::testing {
+
+static constexpr var a;
+static constexpr var b;
+static constexpr auto model = a*log(b) + a*a*b;
+
+XP_DEFINE_EVALUATOR(instantiated_model, model, a, b);
+XP_DEFINE_EVALUATOR(instantiated_model_derivative, derivative_of(model, wrt(a)), b, a);
+
+}  // namespace xp::testing
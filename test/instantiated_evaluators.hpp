@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <xpress/instantiate.hpp>
+
+namespace xp::testing {
+
+XP_DECLARE_EVALUATOR(instantiated_model, double(double, double));
+XP_DECLARE_EVALUATOR(instantiated_model_derivative, double(double, double));
+
+}  // namespace xp::testing
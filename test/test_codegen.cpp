@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <string>
+#include <sstream>
+
+#include <xpress/xp.hpp>
+#include <xpress/codegen.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "kernel_with_common_subexpressions"_test = [] () {
+        var a;
+        var b;
+        std::ostringstream out;
+        write_kernel_to(out, a*b + log(a*b), with(a = "a", b = "b"));
+        expect(eq(out.str(), std::string{
+            "void kernel(const double a, const double b, double* out) noexcept {\n"
+            "    const double t0 = a*b;\n"
+            "    const double t1 = std::log(t0);\n"
+            "    const double t2 = t0 + t1;\n"
+            "    out[0] = t2;\n"
+            "}\n"
+        }));
+    };
+
+    "kernel_with_derivatives"_test = [] () {
+        var a;
+        var b;
+        std::ostringstream out;
+        write_kernel_to(out, a*b + log(a*b), wrt(a, b), with(a = "x", b = "y"), {.name = "f"});
+        expect(eq(out.str(), std::string{
+            "void f(const double x, const double y, double* out) noexcept {\n"
+            "    const double t0 = x*y;\n"
+            "    const double t1 = std::log(t0);\n"
+            "    const double t2 = t0 + t1;\n"
+            "    const double t3 = y/t0;\n"
+            "    const double t4 = y + t3;\n"
+            "    const double t5 = x/t0;\n"
+            "    const double t6 = x + t5;\n"
+            "    out[0] = t2;\n"
+            "    out[1] = t4;\n"
+            "    out[2] = t6;\n"
+            "}\n"
+        }));
+    };
+
+    "c_kernel_with_literals"_test = [] () {
+        var a;
+        let b;
+        std::ostringstream out;
+        write_kernel_to(out, pow(-a, val<2>) - b/val<2>, with(b = "b", a = "a"), {
+            .name = "g",
+            .scalar_type = "float",
+            .temporary_prefix = "_t",
+            .lang = language::c
+        });
+        expect(eq(out.str(), std::string{
+            "void g(const float b, const float a, float* restrict out) {\n"
+            "    const float _t0 = (-1.0)*a;\n"
+            "    const float _t1 = pow(_t0, 2.0);\n"
+            "    const float _t2 = b/2.0;\n"
+            "    const float _t3 = _t1 - _t2;\n"
+            "    out[0] = _t3;\n"
+            "}\n"
+        }));
+    };
+
+    "kernel_with_named_subexpression"_test = [] () {
+        var a;
+        var b;
+        std::ostringstream out;
+        write_kernel_to(out, log(a*b)/b, with(a*b = "ab", b = "b"));
+        expect(eq(out.str(), std::string{
+            "void kernel(const double ab, const double b, double* out) noexcept {\n"
+            "    const double t0 = std::log(ab);\n"
+            "    const double t1 = t0/b;\n"
+            "    out[0] = t1;\n"
+            "}\n"
+        }));
+    };
+
+    return 0;
+}
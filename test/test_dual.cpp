@@ -0,0 +1,129 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+
+#include <xpress/xp.hpp>
+#include <xpress/dual.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "dual_arithmetic"_test = [] () {
+        static constexpr auto a = dual<double, 2>::seeded<0>(2.0);
+        static constexpr auto b = dual<double, 2>::seeded<1>(4.0);
+        static constexpr auto result = a*b - a/b + 1.0;
+        static_assert(result.value == 8.5);
+        static_assert(result.tangents[0] == 4.0 - 0.25);
+        static_assert(result.tangents[1] == 2.0 + 2.0/16.0);
+    };
+
+    "dual_bound_to_var"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        constexpr auto result = value_of(a*b + a, at(a = dual<double>{2.0, {1.0}}, b = 3.0));
+        static_assert(result.value == 8.0);
+        static_assert(result.tangents[0] == 4.0);
+    };
+
+    "forward_dual_gradient_simple"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr auto expr = a*b + a;
+        constexpr auto grad = gradient_of(expr, at(a = 2, b = 3), forward_dual);
+        static_assert(grad[a] == 4);
+        static_assert(grad[b] == 2);
+        expect(eq(grad[a], 4));
+        expect(eq(grad[b], 2));
+    };
+
+    "forward_dual_gradient_matches_symbolic"_test = [] () {
+        var a;
+        var b;
+        let c;
+        auto unit = a*((a + b)*b + (a*b) + b);
+        auto expr = unit*log(a*b) + pow(unit, c)/b - unit + pow(a, val<3>)/val<4>;
+        const auto values = at(a = 1.5, b = 2.5, c = 2.0);
+        const auto symbolic = gradient_of(expr, values);
+        const auto forward = gradient_of(expr, values, forward_dual);
+        expect(fuzzy_eq(forward[a], symbolic[a]));
+        expect(fuzzy_eq(forward[b], symbolic[b]));
+    };
+
+    "forward_dual_derivatives_selected_variables"_test = [] () {
+        var a;
+        var b;
+        var c;
+        auto expr = a*b*c + c*c;
+        const auto derivs = derivatives_of(expr, wrt(c, a), at(a = 1.0, b = 2.0, c = 3.0), forward_dual);
+        expect(fuzzy_eq(derivs[a], 6.0));
+        expect(fuzzy_eq(derivs[c], 2.0 + 6.0));
+    };
+
+    "forward_dual_derivative_wrt_sub_expression"_test = [] () {
+        var a;
+        var b;
+        auto sum = a + b;
+        auto expr = val<42>*sum + sum*sum;
+        const auto derivs = derivatives_of(expr, wrt(sum), at(a = 1.0, b = 2.0), forward_dual);
+        expect(fuzzy_eq(derivs[sum], 42.0 + 2.0*3.0));
+    };
+
+    "forward_dual_derivative_of_independent_expression"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        constexpr auto derivs = derivatives_of(b*b, wrt(a), at(a = 1.0, b = 2.0), forward_dual);
+        static_assert(derivs[a] == 0.0);
+    };
+
+    "value_and_gradient_of_forward_dual"_test = [] () {
+        var a;
+        var b;
+        auto expr = a*log(b) + a*a*b;
+        const auto values = at(a = 2.0, b = 3.0);
+        const auto [value, grad] = value_and_gradient_of(expr, values, forward_dual);
+        const auto symbolic = gradient_of(expr, values);
+        expect(fuzzy_eq(value, value_of(expr, values)));
+        expect(fuzzy_eq(grad[a], symbolic[a]));
+        expect(fuzzy_eq(grad[b], symbolic[b]));
+    };
+
+    "dual_pow_with_constant_exponent"_test = [] () {
+        // the exponent has no tangents, so the (non-finite) derivative w.r.t. it must not enter the result
+        const auto a = dual<double, 2>::seeded<0>(-2.0);
+        const auto b = dual<double, 2>{2.0};
+        const auto result = pow(a, b);
+        expect(fuzzy_eq(result.value, 4.0));
+        expect(fuzzy_eq(result.tangents[0], -4.0));
+        expect(result.tangents[1] == 0.0);
+
+        const auto at_zero = pow(dual<double, 2>::seeded<0>(0.0), b);
+        expect(at_zero.value == 0.0);
+        expect(at_zero.tangents[0] == 0.0);
+        expect(at_zero.tangents[1] == 0.0);
+    };
+
+    "dual_pow_with_zero_exponent"_test = [] () {
+        const auto a = dual<double, 2>::seeded<0>(0.0);
+        const auto result = pow(a, 0.0);
+        expect(result.value == 1.0);
+        expect(result.tangents[0] == 0.0);
+        expect(result.tangents[1] == 0.0);
+
+        const auto mixed = pow(a, dual<double, 2>::seeded<1>(0.0));
+        expect(mixed.value == 1.0);
+        expect(mixed.tangents[0] == 0.0);
+    };
+
+    "dual_pow_with_constant_base"_test = [] () {
+        const auto result = pow(-2.0, dual<double, 2>{3.0});
+        expect(fuzzy_eq(result.value, -8.0));
+        expect(result.tangents[0] == 0.0);
+        expect(result.tangents[1] == 0.0);
+    };
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <vector>
+#include <memory_resource>
+
+#include <xpress/xp.hpp>
+#include <xpress/dynamic.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "dynamic_tensor_access"_test = [] () {
+        linalg::dynamic_tensor<double, 2> t{{2, 3}, 1.0};
+        expect(eq(t.size(), std::size_t{6}));
+        expect(eq(t.extent(1), std::size_t{3}));
+        t[1, 2] = 42.0;
+        expect(eq(t.data()[5], 42.0));
+        expect(eq(t[0, 1], 1.0));
+
+        const linalg::dynamic_tensor v{std::vector{1.0, 2.0, 3.0}};
+        expect(eq(v.size(), std::size_t{3}));
+        expect(eq(v[2], 3.0));
+    };
+
+    "dynamic_tensor_elementwise_expressions"_test = [] () {
+        var u;
+        var w;
+        let c;
+        const std::vector<double> nodal_values{1.0, 2.0, 3.0, 4.0, 5.0};
+        const linalg::dynamic_tensor values{nodal_values};
+        const linalg::dynamic_tensor weights{std::vector{2.0, 2.0, 2.0, 2.0, 2.0}};
+        const auto bound = at(u = values, w = weights, c = 3.0);
+
+        const auto result = value_of(u*c + w - u/val<2>, bound);
+        for (std::size_t i = 0; i < nodal_values.size(); ++i)
+            expect(fuzzy_eq(result[i], nodal_values[i]*3.0 + 2.0 - nodal_values[i]/2.0));
+        const auto logs = value_of(log(pow(u, val<2>)), bound);
+        for (std::size_t i = 0; i < nodal_values.size(); ++i)
+            expect(fuzzy_eq(logs[i], 2.0*std::log(nodal_values[i])));
+
+        // products of dynamic tensors are scalar products (i.e. reductions)
+        expect(fuzzy_eq(value_of(u*w, bound), 30.0));
+        expect(fuzzy_eq(derivatives_of(u*c, wrt(c), bound)[c][3], 4.0));
+    };
+
+    "dynamic_tensor_from_memory_resource"_test = [] () {
+        std::pmr::unsynchronized_pool_resource pool;
+        var u;
+        const linalg::dynamic_tensor values{std::vector{1.0, 2.0, 3.0}, &pool};
+        const auto result = value_of(u*val<2> + u, at(u = values));
+        expect(result.get_allocator().resource() == &pool);
+        expect(result == linalg::dynamic_tensor{std::vector{3.0, 6.0, 9.0}});
+    };
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <span>
+#include <array>
+#include <vector>
+#include <type_traits>
+
+#include <xpress/xp.hpp>
+#include <xpress/evaluation.hpp>
+#include <xpress/batch.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "evaluation_nodes_order"_test = [] () {
+        var a;
+        var b;
+        auto sum = a + b;
+        auto product = sum*b;
+        auto expr = product + log(sum);
+
+        using nodes = traits::evaluation_nodes_of_t<bindings<>, decltype(expr)>;
+        static_assert(nodes::size == 4);
+        static_assert(std::is_same_v<nodes, type_list<decltype(sum), decltype(product), decltype(log(sum)), decltype(expr)>>);
+    };
+
+    "evaluation_nodes_commutative"_test = [] () {
+        var a;
+        var b;
+        auto expr = (a + b)*(b + a);
+        using nodes = traits::evaluation_nodes_of_t<bindings<>, decltype(expr)>;
+        static_assert(nodes::size == 2);
+    };
+
+    "evaluation_nodes_skip_bound_subtrees"_test = [] () {
+        var a;
+        var b;
+        auto arg = a*a + b;
+        auto expr = log(arg) + arg*arg;
+        using bound = decltype(at(arg = 1.0));
+        using nodes = traits::evaluation_nodes_of_t<bound, decltype(expr)>;
+        static_assert(nodes::size == 3);
+    };
+
+    "cse_value_of"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr auto unit = a*((a + b)*b + (a*b) + b);
+        static constexpr auto expr = unit + unit*(b + a) + log(b*a);
+        expect(fuzzy_eq(value_of(expr, at(a = 2.0, b = 5.0), cse), value_of(expr, at(a = 2.0, b = 5.0))));
+        static_assert(value_of(a*b + b*a, at(a = 2, b = 3), cse) == 12);
+    };
+
+    "cse_value_of_bound_subexpression"_test = [] () {
+        var a;
+        var b;
+        auto arg = a*a + b;
+        auto expr = log(arg) + arg*arg;
+        expect(fuzzy_eq(value_of(expr, with(arg = 3.0), cse), std::log(3.0) + 9.0));
+    };
+
+    "cse_value_of_leaf"_test = [] () {
+        static constexpr var a;
+        static_assert(value_of(a, at(a = 42), cse) == 42);
+        static_assert(value_of(val<42>, at(), cse) == 42);
+    };
+
+    "cse_value_of_tensor_expression"_test = [] () {
+        var a;
+        var b;
+        auto v = vector_expression::from(a*b, a*b + a, b*a);
+        expect(value_of(v, at(a = 2, b = 3), cse) == linalg::tensor{shape<3>, 6, 8, 6});
+    };
+
+    "joint_value_of_tensor_expression"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static_assert(value_of(vector_expression::from(a*b, a*b + a, b), at(a = 2, b = 3)) == linalg::tensor{shape<3>, 6, 8, 3});
+        const auto v = vector_expression::from(a*b, a*b + a, log(a*b)*b, val<4>);
+        const auto values = value_of(v, at(a = 2.0, b = 3.0));
+        expect(fuzzy_eq(values[2], std::log(6.0)*3.0));
+        expect(fuzzy_eq(values[3], 4.0));
+    };
+
+    "joint_derivatives_of_vector_expression"_test = [] () {
+        var a;
+        var b;
+        auto v = vector_expression::from(a*b*log(a*b), a*b + a*log(a*b));
+        const auto values = at(a = 1.5, b = 2.5);
+        const auto jacobian = derivatives_of(v, wrt(a, b), values);
+        for_each(derivatives_of(v, wrt(a, b)), [&] (const auto& var, const auto& expr) {
+            const auto expected = value_of(expr, values);
+            expect(fuzzy_eq(jacobian[var][0], expected[0]));
+            expect(fuzzy_eq(jacobian[var][1], expected[1]));
+        });
+    };
+
+    "value_and_derivatives_of"_test = [] () {
+        var a;
+        var b;
+        auto unit = a*((a + b)*b + (a*b) + b);
+        auto expr = unit*log(a*b) + unit*unit/b;
+        const auto values = at(a = 1.5, b = 2.5);
+        const auto [value, derivs] = value_and_derivatives_of(expr, wrt(a, b), values);
+        expect(fuzzy_eq(value, value_of(expr, values)));
+        expect(fuzzy_eq(derivs[a], derivatives_of(expr, wrt(a), values)[a]));
+        expect(fuzzy_eq(derivs[b], derivatives_of(expr, wrt(b), values)[b]));
+    };
+
+    "value_and_gradient_of"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr auto result = value_and_gradient_of(a*b + a, at(a = 2, b = 3));
+        static_assert(result.first == 8);
+        static_assert(result.second[a] == 4);
+        static_assert(result.second[b] == 2);
+    };
+
+    "batch_evaluation"_test = [] () {
+        var a;
+        var b;
+        let c;
+        auto expr = a*b + log(a)*c - pow(b, val<2>)/a;
+
+        // two full blocks plus a tail
+        const std::size_t n = 2*batch_block_size + 22;
+        std::vector<double> a_values(n);
+        std::vector<double> b_values(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a_values[i] = 1.0 + 0.5*static_cast<double>(i);
+            b_values[i] = 2.0 - 0.01*static_cast<double>(i);
+        }
+
+        std::vector<double> out(n);
+        evaluator{expr}.batch(std::span{out}, a = std::span{a_values}, b = b_values, c = 3.0);
+        for (std::size_t i = 0; i < n; ++i)
+            expect(fuzzy_eq(out[i], value_of(expr, at(a = a_values[i], b = b_values[i], c = 3.0))));
+    };
+
+    "batch_evaluation_constexpr"_test = [] () {
+        static constexpr var a;
+        static constexpr let b;
+        static_assert([] () {
+            constexpr std::array values{1, 2, 3};
+            std::array<int, 3> out{};
+            evaluator{a*val<3> + b}.batch(std::span{out}, a = std::span{values}, b = 10);
+            return out;
+        } () == std::array{13, 16, 19});
+    };
+
+    return 0;
+}
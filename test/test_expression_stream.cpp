@@ -4,9 +4,11 @@
 #include <string>
 #include <sstream>
 #include <format>
+#include <string_view>
 
 #include <xpress/symbols.hpp>
 #include <xpress/operators.hpp>
+#include <xpress/render.hpp>
 
 #include "testing.hpp"
 
@@ -41,6 +43,37 @@ int main() {
         expect(eq(text, std::string{"a + b + c"}));
     };
 
+    "bound_expression_format_with_values"_test = [] () {
+        var a;
+        var b;
+        auto bound_expr = (a*b + val<2>).with(a = 1.23456, b = 2.5);
+        expect(eq(std::format("{}", bound_expr), std::string{"1.23456*2.5 + 2"}));
+        expect(eq(std::format("{:.2f}", bound_expr), std::string{"1.23*2.50 + 2"}));
+        expect(eq(std::format("{:>6.1f}", bound_expr), std::string{"   1.2*   2.5 + 2"}));
+    };
+
+    "compile_time_rendering"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr var c;
+        static constexpr auto text = render((a + b)/c + (b + c)*a, with(a = "a", b = "b", c = "c"));
+        static_assert(text.view() == std::string_view{"(a + b)/c + (b + c)*a"});
+
+        std::ostringstream out;
+        out << text;
+        expect(eq(out.str(), std::string{"(a + b)/c + (b + c)*a"}));
+    };
+
+    "compile_time_rendering_of_values"_test = [] () {
+        static constexpr var a;
+        static constexpr auto text = render(val<2>*a + val<-3> + val<0.25> + val<1.5e-7>, with(a = 1.23456789));
+        static_assert(text.view() == std::string_view{"2*1.23457 + -3 + 0.25 + 1.5e-07"});
+
+        std::ostringstream out;
+        write_to(out, val<2>*a + val<-3> + val<0.25> + val<1.5e-7>, with(a = 1.23456789));
+        expect(eq(out.str(), std::string{text.view()}));
+    };
+
     "mixed_arithmetic_stream"_test = [] () {
         var a;
         var b;
@@ -61,6 +94,16 @@ int main() {
         expect(eq(out.str(), std::string{"(a*b)/c + (b + c)*a"}));
     };
 
+    "nary_arithmetic_stream"_test = [] () {
+        var a;
+        var b;
+        var c;
+        auto expression = sum(a, b*c, product(a, b + c, c));
+        std::ostringstream out;
+        write_to(out, expression, with(a = "a", b = "b", c = "c"));
+        expect(eq(out.str(), std::string{"a + b*c + a*(b + c)*c"}));
+    };
+
     "add_operator_same_operand"_test = [] () {
         static constexpr let a;
         constexpr auto added = a + a;
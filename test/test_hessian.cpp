@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <type_traits>
+
+#include <xpress/xp.hpp>
+#include <xpress/hessian.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "hessian_expressions_are_symmetric"_test = [] () {
+        var a;
+        var b;
+        var c;
+        auto h = hessian_of(a*a*b + log(b)*c, wrt(a, b, c));
+        static_assert(decltype(h)::size == 3);
+        static_assert(decltype(h)::stored_size == 6);
+        static_assert(std::is_same_v<decltype(h.wrt(a, b)), decltype(h.wrt(b, a))>);
+        static_assert(std::is_same_v<decltype(h.wrt(c, a)), decltype(h.wrt(a, c))>);
+        static_assert(std::is_same_v<
+            decltype(h.wrt(a, b)),
+            std::remove_cvref_t<decltype(derivative_of(derivative_of(a*a*b + log(b)*c, wrt(a)), wrt(b)))>
+        >);
+    };
+
+    "hessian_evaluation"_test = [] () {
+        var a;
+        var b;
+        const auto h = hessian_of(a*a*b + log(b), wrt(a, b), at(a = 2.0, b = 3.0));
+        expect(fuzzy_eq(h[0, 0], 6.0));
+        expect(fuzzy_eq(h[0, 1], 4.0));
+        expect(fuzzy_eq(h[1, 0], 4.0));
+        expect(fuzzy_eq(h[1, 1], -1.0/9.0));
+        static_assert(decltype(h)::stored_size == 3);
+    };
+
+    "hessian_matches_repeated_derivatives"_test = [] () {
+        var a;
+        var b;
+        auto expr = pow(a*b, val<2>)/(a + b) + log(a*a + b);
+        const auto values = at(a = 1.5, b = 0.5);
+        const auto h = hessian_of(expr).at(values);
+        expect(fuzzy_eq(h[0, 0], derivative_of(derivative_of(expr, wrt(a)), wrt(a), values)));
+        expect(fuzzy_eq(h[0, 1], derivative_of(derivative_of(expr, wrt(a)), wrt(b), values)));
+        expect(fuzzy_eq(h[1, 0], derivative_of(derivative_of(expr, wrt(b)), wrt(a), values)));
+        expect(fuzzy_eq(h[1, 1], derivative_of(derivative_of(expr, wrt(b)), wrt(b), values)));
+    };
+
+    "value_gradient_and_hessian"_test = [] () {
+        var a;
+        var b;
+        const auto [value, gradient, h] = value_gradient_and_hessian_of(a*a*b + log(b), wrt(a, b), at(a = 2.0, b = 3.0));
+        expect(fuzzy_eq(value, 12.0 + std::log(3.0)));
+        expect(fuzzy_eq(gradient[a], 12.0));
+        expect(fuzzy_eq(gradient[b], 4.0 + 1.0/3.0));
+        expect(fuzzy_eq(h[0, 0], 6.0));
+        expect(fuzzy_eq(h[0, 1], 4.0));
+        expect(fuzzy_eq(h[1, 1], -1.0/9.0));
+    };
+
+    "hessian_constexpr"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        constexpr auto h = hessian_of(a*a*b, wrt(a, b), at(a = 2, b = 3));
+        static_assert(h[0, 0] == 6);
+        static_assert(h[0, 1] == 4);
+        static_assert(h[1, 1] == 0);
+    };
+}
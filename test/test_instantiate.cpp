@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+
+#include "instantiated_evaluators.hpp"
+#include "testing.hpp"
+
+int main() {
+    using namespace xp::testing;
+
+    "instantiated_evaluator"_test = [] () {
+        expect(fuzzy_eq(instantiated_model(2.0, 3.0), 2.0*std::log(3.0) + 12.0));
+    };
+
+    "instantiated_evaluator_argument_order"_test = [] () {
+        expect(fuzzy_eq(instantiated_model_derivative(3.0, 2.0), std::log(3.0) + 12.0));
+    };
+
+    "instantiated_evaluator_function_pointer"_test = [] () {
+        double (*f)(double, double) noexcept = instantiated_model.get();
+        expect(fuzzy_eq(f(2.0, 3.0), instantiated_model(2.0, 3.0)));
+    };
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <type_traits>
+
+#include <xpress/xp.hpp>
+#include <xpress/jacobian.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "jacobian_pattern_of_vector_expression"_test = [] () {
+        var a;
+        var b;
+        var c;
+        constexpr auto residual = vector_expression::from(a*a - b, log(b), c*a + val<1>);
+        using pattern = traits::jacobian_pattern_of_t<decltype(residual), decltype(wrt(a, b, c))>;
+        static_assert(std::is_same_v<
+            pattern,
+            linalg::sparsity_pattern<md_index<0, 0>, md_index<0, 1>, md_index<1, 1>, md_index<2, 0>, md_index<2, 2>>
+        >);
+
+        // the columns follow the order of the given variables
+        using permuted = traits::jacobian_pattern_of_t<decltype(residual), decltype(wrt(c, a))>;
+        static_assert(std::is_same_v<
+            permuted,
+            linalg::sparsity_pattern<md_index<0, 1>, md_index<2, 0>, md_index<2, 1>>
+        >);
+    };
+
+    "jacobian_pattern_of_constant_component"_test = [] () {
+        var a;
+        var b;
+        constexpr auto residual = vector_expression::from(val<2>, b*b);
+        using pattern = traits::jacobian_pattern_of_t<decltype(residual), decltype(wrt(a, b))>;
+        static_assert(std::is_same_v<pattern, linalg::sparsity_pattern<md_index<1, 1>>>);
+    };
+
+    "jacobian_pattern_wrt_let_symbols_and_sub_expressions"_test = [] () {
+        var a;
+        var b;
+        let c;
+        constexpr auto residual = vector_expression::from(a*c, c*c, a);
+        using pattern = traits::jacobian_pattern_of_t<decltype(residual), decltype(wrt(a, c))>;
+        static_assert(std::is_same_v<
+            pattern,
+            linalg::sparsity_pattern<md_index<0, 0>, md_index<0, 1>, md_index<1, 1>, md_index<2, 0>>
+        >);
+
+        constexpr auto product = a*b;
+        constexpr auto composite = vector_expression::from(product + a, log(b), a*b*b);
+        using composite_pattern = traits::jacobian_pattern_of_t<decltype(composite), decltype(wrt(product, a))>;
+        static_assert(std::is_same_v<
+            composite_pattern,
+            linalg::sparsity_pattern<md_index<0, 0>, md_index<0, 1>, md_index<2, 0>, md_index<2, 1>>
+        >);
+    };
+
+    "sparse_jacobian_wrt_sub_expression"_test = [] () {
+        var a;
+        var b;
+        auto sum = a + b;
+        auto residual = vector_expression::from(val<3>*sum, b*b);
+        const auto jacobian = sparse_jacobian_of(residual, wrt(sum, b), at(a = 1.0, b = 2.0));
+        expect(fuzzy_eq(jacobian[at<0, 0>()], 3.0));
+        expect(fuzzy_eq(jacobian[at<1, 1>()], 4.0));
+        static_assert(linalg::is_structural_zero_v<decltype(jacobian), md_index<1, 0>>);
+    };
+
+    "sparse_jacobian_stores_only_nonzeros"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr var c;
+        static constexpr auto residual = vector_expression::from(a*a - b, b*b, c*a + val<1>);
+        static constexpr auto result = value_and_sparse_jacobian_of(residual, wrt(a, b, c), at(a = 2.0, b = 3.0, c = 4.0));
+        static constexpr auto& value = result.first;
+        static constexpr auto& jacobian = result.second;
+        static_assert(std::remove_cvref_t<decltype(jacobian)>::stored_size == 5);
+        static_assert(fuzzy_eq(value[0], 1.0));
+        static_assert(fuzzy_eq(value[2], 9.0));
+        static_assert(fuzzy_eq(jacobian[at<0, 0>()], 4.0));
+        static_assert(fuzzy_eq(jacobian[at<0, 1>()], -1.0));
+        static_assert(fuzzy_eq(jacobian[at<2, 0>()], 4.0));
+        static_assert(fuzzy_eq(jacobian[at<2, 2>()], 2.0));
+        static_assert(jacobian[at<1, 0>()] == 0.0);
+        static_assert(linalg::is_structural_zero_v<decltype(jacobian), md_index<1, 2>>);
+
+        const auto j = sparse_jacobian_of(residual, wrt(a, b, c), at(a = 2.0, b = 3.0, c = 4.0));
+        expect(fuzzy_eq(j[at<1, 1>()], 6.0));
+    };
+
+    "sparse_jacobian_of_block_diagonal_system"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr var c;
+        static constexpr var d;
+        static constexpr auto residual = vector_expression::from(a*b, c*c, a + b, d*c);
+        constexpr auto jacobian = sparse_jacobian_of(residual, wrt(a, b, c, d), at(a = 1.0, b = 2.0, c = 3.0, d = 4.0));
+        static_assert(linalg::block_lu_factorization{jacobian}.block_count() == 2);
+        static_assert(fuzzy_eq(linalg::block_lu_factorization{jacobian}.determinant(), linalg::determinant_of(jacobian)));
+    };
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <algorithm>
+#include <type_traits>
 
 #include <xpress/linalg.hpp>
 
@@ -108,5 +109,274 @@ int main() {
         static_assert(tensorial<linalg::tensor<int, md_shape<2, 2>>>);
     };
 
+    "tensor_mat_mul_blocked"_test = [] () {
+        // large enough for the loop-based kernel, and with a number of rows that is not a multiple of the row blocks
+        linalg::tensor<int, md_shape<6, 10>> A{0};
+        linalg::tensor<int, md_shape<10, 5>> B{0};
+        for (std::size_t i = 0; i < 6; ++i)
+            for (std::size_t j = 0; j < 10; ++j)
+                A[i, j] = static_cast<int>((i*7 + j*3)%11) - 5;
+        for (std::size_t i = 0; i < 10; ++i)
+            for (std::size_t j = 0; j < 5; ++j)
+                B[i, j] = static_cast<int>((i*5 + j*2)%7) - 3;
+
+        linalg::tensor<int, md_shape<6, 5>> expected{0};
+        for (std::size_t i = 0; i < 6; ++i)
+            for (std::size_t j = 0; j < 5; ++j)
+                for (std::size_t k = 0; k < 10; ++k)
+                    expected[i, j] += A[i, k]*B[k, j];
+        expect(linalg::mat_mul(A, B) == expected);
+
+        linalg::tensor<int, md_shape<10, 6>> A_transposed{0};
+        for (std::size_t i = 0; i < 6; ++i)
+            for (std::size_t j = 0; j < 10; ++j)
+                A_transposed[j, i] = A[i, j];
+        expect(linalg::mat_mul(linalg::transposed(A_transposed), B) == expected);
+    };
+
+    "tensor_mat_vec_blocked"_test = [] () {
+        std::array<std::array<double, 9>, 9> A{};
+        linalg::tensor<double, md_shape<9>> x{0.0};
+        for (std::size_t i = 0; i < 9; ++i) {
+            x[i] = 1.0 + static_cast<double>(i);
+            for (std::size_t j = 0; j < 9; ++j)
+                A[i][j] = static_cast<double>((i + 2*j)%5);
+        }
+        const auto y = linalg::mat_vec(A, x);
+        const auto y_transposed = linalg::mat_vec(linalg::transposed(A), x);
+        for (std::size_t i = 0; i < 9; ++i) {
+            double expected = 0.0;
+            double expected_transposed = 0.0;
+            for (std::size_t j = 0; j < 9; ++j) {
+                expected += A[i][j]*x[j];
+                expected_transposed += A[j][i]*x[j];
+            }
+            expect(fuzzy_eq(y[i], expected));
+            expect(fuzzy_eq(y_transposed[i], expected_transposed));
+        }
+    };
+
+    "tensor_mat_mul_transposed_small"_test = [] () {
+        static constexpr linalg::tensor A{shape<2, 2>, 1, 2, 3, 4};
+        static constexpr linalg::tensor B{shape<2, 2>, 5, 6, 7, 8};
+        static_assert(linalg::mat_mul(linalg::transposed(A), B) == linalg::tensor{shape<2, 2>, 26, 30, 38, 44});
+        static_assert(linalg::mat_mul(A, linalg::transposed(B)) == linalg::tensor{shape<2, 2>, 17, 23, 39, 53});
+    };
+
+    "lu_solve"_test = [] () {
+        static constexpr linalg::tensor A{shape<3, 3>, 0.0, 2.0, 1.0, 1.0, 1.0, 1.0, 2.0, 1.0, 3.0};
+        static constexpr linalg::tensor b{shape<3>, 7.0, 6.0, 13.0};
+        static constexpr auto x = linalg::solve(A, b);
+        static_assert(x.has_value());
+        expect(fuzzy_eq((*x)[0], 1.0));
+        expect(fuzzy_eq((*x)[1], 2.0));
+        expect(fuzzy_eq((*x)[2], 3.0));
+    };
+
+    "lu_solve_singular"_test = [] () {
+        static constexpr linalg::tensor A{shape<2, 2>, 1.0, 2.0, 2.0, 4.0};
+        static_assert(linalg::lu_factorization{A}.is_singular());
+        static_assert(!linalg::solve(A, linalg::tensor{shape<2>, 1.0, 1.0}).has_value());
+    };
+
+    "lu_determinant"_test = [] () {
+        static constexpr linalg::tensor A{shape<3, 3>, 0.0, 2.0, 1.0, 1.0, 1.0, 1.0, 2.0, 1.0, 3.0};
+        static_assert(fuzzy_eq(linalg::lu_factorization{A}.determinant(), linalg::determinant_of(A)));
+        static_assert(fuzzy_eq(linalg::lu_factorization{A}.determinant(), -3.0));
+    };
+
+    "determinant_4x4"_test = [] () {
+        static constexpr linalg::tensor A{shape<4, 4>,
+            2, 0, 1, 0,
+            0, 3, 0, 0,
+            1, 0, 4, 0,
+            1, 2, 0, 5
+        };
+        static_assert(fuzzy_eq(linalg::determinant_of(A), 105.0));
+    };
+
+    "determinant_of_integral_matrices_is_integral"_test = [] () {
+        static constexpr linalg::tensor A{shape<4, 4>,
+            2, 0, 1, 0,
+            0, 3, 0, 0,
+            1, 0, 4, 0,
+            1, 2, 0, 5
+        };
+        static constexpr linalg::tensor P{shape<4, 4>,
+            0, 1, 0, 0,
+            1, 0, 0, 0,
+            0, 0, 2, 1,
+            0, 0, 1, 3
+        };
+        static_assert(std::is_same_v<decltype(linalg::determinant_of(A)), int>);
+        static_assert(std::is_same_v<decltype(linalg::determinant_of(linalg::tensor{shape<2, 2>, 1, 2, 3, 4})), int>);
+        static_assert(linalg::determinant_of(A) == 105);
+        static_assert(linalg::determinant_of(P) == -5);
+        static_assert(linalg::determinant_of(linalg::tensor{shape<4, 4>, 1, 2, 3, 4, 2, 4, 6, 8, 1, 0, 1, 0, 0, 1, 0, 1}) == 0);
+    };
+
+    "cofactors_laplace_expansion"_test = [] () {
+        const auto check_expansion = [] (const auto& A) {
+            const auto det = linalg::determinant_of(A);
+            const auto cof = linalg::cofactors_of(A);
+            for (std::size_t i = 0; i < 5; ++i) {
+                double expansion = 0.0;
+                for (std::size_t j = 0; j < 5; ++j)
+                    expansion += A[i, j]*cof[i, j];
+                expect(fuzzy_eq(expansion, det));
+            }
+        };
+        check_expansion(linalg::tensor{shape<5, 5>,
+            4.0, 1.0, 0.0, 2.0, 1.0,
+            1.0, 5.0, 1.0, 0.0, 0.0,
+            0.0, 1.0, 3.0, 1.0, 2.0,
+            2.0, 0.0, 1.0, 6.0, 1.0,
+            1.0, 0.0, 2.0, 1.0, 7.0
+        });
+        // singular matrix (the last row duplicates the first), for which the minors are used
+        const linalg::tensor singular{shape<5, 5>,
+            4.0, 1.0, 0.0, 2.0, 1.0,
+            1.0, 5.0, 1.0, 0.0, 0.0,
+            0.0, 1.0, 3.0, 1.0, 2.0,
+            2.0, 0.0, 1.0, 6.0, 1.0,
+            4.0, 1.0, 0.0, 2.0, 1.0
+        };
+        check_expansion(singular);
+        expect(fuzzy_eq(linalg::determinant_of(singular), 0.0));
+        expect(!fuzzy_eq(linalg::cofactors_of(singular)[0, 0], 0.0));
+    };
+
+    "determinant_and_cofactors_from_one_factorization"_test = [] () {
+        static constexpr linalg::tensor A{shape<4, 4>,
+            2.0, 0.0, 1.0, 0.0,
+            0.0, 3.0, 0.0, 0.0,
+            1.0, 0.0, 4.0, 0.0,
+            1.0, 2.0, 0.0, 5.0
+        };
+        static constexpr auto result = linalg::determinant_and_cofactors_of(A);
+        static_assert(fuzzy_eq(result.determinant, linalg::determinant_of(A)));
+        static_assert(fuzzy_eq(result.cofactors[1, 1], linalg::cofactors_of(A)[1, 1]));
+    };
+
+    "cofactor_derivatives"_test = [] () {
+        static constexpr linalg::tensor A{shape<2, 2>, 1.0, 2.0, 3.0, 4.0};
+        static constexpr auto d = linalg::cofactor_derivatives_of(A);
+        // cof(A) = [[a11, -a10], [-a01, a00]]
+        static_assert(d[0, 0][1, 1] == 1.0 and d[1, 1][0, 0] == 1.0);
+        static_assert(d[0, 1][1, 0] == -1.0 and d[1, 0][0, 1] == -1.0);
+        static_assert(d[0, 0][0, 0] == 0.0 and d[0, 0][0, 1] == 0.0 and d[0, 0][1, 0] == 0.0);
+
+        static constexpr linalg::tensor B{shape<3, 3>, 1.0, 2.0, 3.0, 0.0, 4.0, 5.0, 1.0, 0.0, 6.0};
+        // cof(B)[0, 0] = b11*b22 - b12*b21
+        static_assert(linalg::cofactor_derivatives_of(B)[0, 0][1, 1] == 6.0);
+        static_assert(linalg::cofactor_derivatives_of(B)[0, 0][1, 2] == 0.0);
+        static_assert(linalg::cofactor_derivatives_of(B)[0, 0][2, 1] == -5.0);
+    };
+
+    "symmetric_tensor_storage"_test = [] () {
+        linalg::symmetric_tensor S{shape<3, 3>, 1, 2, 3, 4, 5, 6};
+        static_assert(decltype(S)::stored_size == 6);
+        expect(eq(S[at<1, 0>()], 2));
+        expect(eq(S[at<2, 1>()], 5));
+        expect(eq(S[2, 2], 6));
+        S[2, 0] = 42;
+        expect(eq(S[0, 2], 42));
+        expect(eq(S.stored_values()[2], 42));
+    };
+
+    "diagonal_and_sparse_tensor_access"_test = [] () {
+        static constexpr linalg::diagonal_tensor D{shape<3, 3>, 1, 2, 3};
+        static_assert(D[at<1, 1>()] == 2);
+        static_assert(D[at<0, 2>()] == 0);
+        static_assert(linalg::is_structural_zero_v<decltype(D), md_index<0, 2>>);
+        static_assert(!linalg::is_structural_zero_v<decltype(D), md_index<2, 2>>);
+
+        static constexpr linalg::sparse_tensor A{shape<2, 3>, linalg::pattern(at<0, 1>(), at<1, 2>()), 4, 5};
+        static_assert(decltype(A)::stored_size == 2);
+        static_assert(A[at<0, 1>()] == 4);
+        static_assert(A[at<1, 2>()] == 5);
+        static_assert(A[at<1, 0>()] == 0);
+    };
+
+    "structured_tensor_mat_mul"_test = [] () {
+        const auto dense = [] <typename T> (const T& t) {
+            linalg::tensor<double, shape_of_t<T>> result{0.0};
+            visit_indices_in(shape_of_t<T>{}, [&] <std::size_t... i> (const md_index<i...>& idx) {
+                result[idx] = access<T>::at(idx, t);
+            });
+            return result;
+        };
+        const auto check = [&] <typename T1, typename T2> (const T1& A, const T2& B) {
+            static constexpr std::size_t n = shape_of_t<T1>{}.first();
+            const auto product = linalg::mat_mul(A, B);
+            const auto expected = linalg::mat_mul(dense(A), dense(B));
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t j = 0; j < n; ++j)
+                    expect(fuzzy_eq(product[i, j], expected[i, j]));
+        };
+
+        // small products are unrolled, skipping the structural zeros
+        const linalg::tensor M2{shape<2, 2>, 1.0, 2.0, 3.0, 4.0};
+        check(linalg::diagonal_tensor{shape<2, 2>, 2.0, 3.0}, M2);
+        check(M2, linalg::symmetric_tensor{shape<2, 2>, 1.0, 2.0, 3.0});
+        check(linalg::sparse_tensor{shape<2, 2>, linalg::pattern(at<0, 1>()), 5.0}, M2);
+
+        // larger products use the structure-aware kernels
+        linalg::tensor<double, md_shape<8, 8>> M8{0.0};
+        for (std::size_t i = 0; i < 8; ++i)
+            for (std::size_t j = 0; j < 8; ++j)
+                M8[i, j] = static_cast<double>((i*3 + j*5)%7) - 3.0;
+        const linalg::diagonal_tensor D8{shape<8, 8>, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+        const linalg::sparse_tensor S8{shape<8, 8>, linalg::pattern(at<0, 7>(), at<3, 3>(), at<6, 1>()), 2.0, -1.0, 4.0};
+        check(D8, M8);
+        check(M8, D8);
+        check(S8, M8);
+        check(M8, S8);
+    };
+
+    "structured_tensor_determinant"_test = [] () {
+        static constexpr linalg::diagonal_tensor D{shape<4, 4>, 1.0, 2.0, 3.0, 4.0};
+        static_assert(fuzzy_eq(linalg::determinant_of(D), 24.0));
+
+        static constexpr linalg::sparse_tensor U{
+            shape<3, 3>,
+            linalg::pattern(at<0, 0>(), at<0, 2>(), at<1, 1>(), at<2, 2>()),
+            2.0, 7.0, 3.0, 4.0
+        };
+        static_assert(fuzzy_eq(linalg::determinant_of(U), 24.0));
+
+        static constexpr linalg::symmetric_tensor S{shape<2, 2>, 2.0, 1.0, 3.0};
+        static_assert(fuzzy_eq(linalg::determinant_of(S), 5.0));
+    };
+
+    "block_lu_factorization"_test = [] () {
+        // rows (0, 2) couple with columns (1, 3), rows (1, 3) with columns (0, 2), and row 4 with column 4
+        static constexpr linalg::sparse_tensor A{
+            shape<5, 5>,
+            linalg::pattern(
+                at<0, 1>(), at<0, 3>(), at<1, 0>(), at<1, 2>(), at<2, 1>(),
+                at<2, 3>(), at<3, 0>(), at<3, 2>(), at<4, 4>()
+            ),
+            2.0, 1.0, 3.0, -1.0, 1.0, 4.0, 1.0, 2.0, 5.0
+        };
+        static constexpr linalg::block_lu_factorization lu{A};
+        static_assert(lu.block_count() == 3);
+        static_assert(!lu.is_singular());
+        static_assert(fuzzy_eq(lu.determinant(), linalg::determinant_of(A)));
+
+        const linalg::tensor b{shape<5>, 1.0, 2.0, 3.0, 4.0, 5.0};
+        const auto x = lu.solve(b);
+        const auto expected = linalg::solve(linalg::detail::as_dense<double>(A), b);
+        expect(expected.has_value());
+        for (std::size_t i = 0; i < 5; ++i)
+            expect(fuzzy_eq(x[i], (*expected)[i]));
+    };
+
+    "block_lu_factorization_structurally_singular"_test = [] () {
+        static constexpr linalg::sparse_tensor A{shape<2, 2>, linalg::pattern(at<0, 0>(), at<1, 0>()), 1.0, 2.0};
+        static_assert(linalg::block_lu_factorization{A}.is_singular());
+        static_assert(linalg::block_lu_factorization{A}.determinant() == 0.0);
+    };
+
     return 0;
 }
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// compiled with XP_NO_IOSTREAM and the C math backend, as for evaluations in device code
+#include <cmath>
+#include <array>
+#include <span>
+#include <type_traits>
+
+#include <xpress/symbols.hpp>
+#include <xpress/operators.hpp>
+#include <xpress/evaluation.hpp>
+#include <xpress/batch.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "c_math_backend_selected"_test = [] () {
+        static_assert(std::is_same_v<XP_MATH_BACKEND, math::c_backend>);
+        expect(fuzzy_eq(math::c_backend::pow(2.0f, 0.5f), std::sqrt(2.0f), 1e-6f));
+        expect(fuzzy_eq(math::c_backend::log(3), std::log(3.0)));
+        expect(fuzzy_eq(math::c_backend::sqrt(2.0L), std::sqrt(2.0L)));
+    };
+
+    "evaluation_with_c_math_backend"_test = [] () {
+        var a;
+        var b;
+        const auto expr = log(a*b)*pow(a, b) + pow(b, val<0.5>) + pow(a, val<2>);
+        const double expected = std::log(6.0)*std::pow(2.0, 3.0) + std::sqrt(3.0) + 4.0;
+        expect(fuzzy_eq(value_of(expr, at(a = 2.0, b = 3.0)), expected));
+        expect(fuzzy_eq(derivative_of(expr, wrt(a), at(a = 2.0, b = 3.0)), 4.0 + 12.0*std::log(6.0) + 4.0));
+    };
+
+    "batch_evaluation_with_c_math_backend"_test = [] () {
+        var a;
+        var b;
+        const std::array<double, 3> a_values{1.0, 2.0, 3.0};
+        std::array<double, 3> out{};
+        evaluator{log(a*b)*a}.batch(std::span{out}, a = std::span{a_values}, b = 2.0);
+        for (std::size_t i = 0; i < out.size(); ++i)
+            expect(fuzzy_eq(out[i], std::log(2.0*a_values[i])*a_values[i]));
+    };
+
+    return 0;
+}
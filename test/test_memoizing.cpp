@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+
+#include <xpress/xp.hpp>
+#include <xpress/memoizing.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "memoizing_evaluator_recomputes_dirty_nodes"_test = [] () {
+        var a;
+        var b;
+        var c;
+        auto expr = log(b*b + b)*c + a*c;
+        const auto reference = [&] (double _a, double _b, double _c) {
+            return value_of(expr, at(a = _a, b = _b, c = _c));
+        };
+
+        memoizing_evaluator f{expr, at(a = 1.0, b = 2.0, c = 3.0)};
+        static_assert(decltype(f)::node_count() == 6);
+        expect(eq(f.recomputed_node_count(), std::size_t{6}));
+        expect(fuzzy_eq(f.value(), reference(1.0, 2.0, 3.0)));
+        expect(eq(f.recomputed_node_count(), std::size_t{0}));
+
+        expect(fuzzy_eq(f.at(a = 4.0), reference(4.0, 2.0, 3.0)));
+        expect(eq(f.recomputed_node_count(), std::size_t{2}));
+
+        expect(fuzzy_eq(f.at(c = 5.0), reference(4.0, 2.0, 5.0)));
+        expect(eq(f.recomputed_node_count(), std::size_t{3}));
+
+        f.update(b = 3.0);
+        f.update(a = 1.0);
+        expect(fuzzy_eq(f.value(), reference(1.0, 3.0, 5.0)));
+        expect(eq(f.recomputed_node_count(), std::size_t{6}));
+    };
+
+    "memoizing_evaluator_bound_subexpression"_test = [] () {
+        var a;
+        var b;
+        auto arg = a*b;
+        auto expr = log(arg) + arg*b;
+        memoizing_evaluator f{expr, at(arg = 2.0, b = 3.0)};
+        expect(fuzzy_eq(f.value(), std::log(2.0) + 6.0));
+        expect(fuzzy_eq(f.at(arg = 4.0), std::log(4.0) + 12.0));
+        expect(eq(f.recomputed_node_count(), std::size_t{3}));
+        expect(fuzzy_eq(f.at(b = 1.0), std::log(4.0) + 4.0));
+        expect(eq(f.recomputed_node_count(), std::size_t{2}));
+    };
+
+    "memoizing_evaluator_constexpr"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        constexpr auto value = [] () {
+            memoizing_evaluator f{a*b + b*b, at(a = 1, b = 2)};
+            return f.at(a = 3);
+        } ();
+        static_assert(value == 10);
+    };
+}
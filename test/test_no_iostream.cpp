@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+// Checks that the evaluation headers do not depend on iostreams if XP_NO_IOSTREAM is defined.
+// This does not use the testing framework, since that includes <iostream> itself.
+#ifndef XP_NO_IOSTREAM
+#define XP_NO_IOSTREAM
+#endif
+
+#include <xpress/xp.hpp>
+#include <xpress/dual.hpp>
+#include <xpress/render.hpp>
+#include <xpress/dynamic.hpp>
+#include <xpress/jacobian.hpp>
+
+#if defined(_GLIBCXX_OSTREAM) || defined(_GLIBCXX_IOSTREAM)
+#error "<ostream> or <iostream> was included despite XP_NO_IOSTREAM"
+#endif
+
+#if defined(_LIBCPP_OSTREAM) || defined(_LIBCPP_IOSTREAM)
+#error "<ostream> or <iostream> was included despite XP_NO_IOSTREAM"
+#endif
+
+int main() {
+    using namespace xp;
+
+    static constexpr var a;
+    static constexpr var b;
+    static constexpr auto result = value_of(a*b + a, at(a = 1.0, b = 2.0));
+    static_assert(result == 3.0);
+    return 0;
+}
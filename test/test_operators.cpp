@@ -1,11 +1,13 @@
 // SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
 // SPDX-License-Identifier: MIT
 
+#include <cmath>
 #include <type_traits>
 #include <memory>
 
 #include <xpress/symbols.hpp>
 #include <xpress/operators.hpp>
+#include <xpress/tensor.hpp>
 
 #include "testing.hpp"
 
@@ -180,6 +182,30 @@ int main() {
         expect(eq(derivative_of(log(a*a), wrt(a), at(a = 2)), 2*2/(2*2)));
     };
 
+    "pow_operator_with_constant_exponents"_test = [] () {
+        var a;
+        expect(fuzzy_eq(value_of(pow(a, val<3>), at(a = 1.5)), std::pow(1.5, 3)));
+        expect(fuzzy_eq(value_of(pow(a, val<7>), at(a = 1.5)), std::pow(1.5, 7)));
+        expect(fuzzy_eq(value_of(pow(a, val<-2>), at(a = 1.5)), std::pow(1.5, -2)));
+        expect(fuzzy_eq(value_of(pow(a, val<0.5>), at(a = 2.0)), std::sqrt(2.0)));
+        expect(eq(value_of(pow(a, val<3>), at(a = 2)), 8));
+    };
+
+    "division_operator_by_constant"_test = [] () {
+        var a;
+        expect(fuzzy_eq(value_of(a/val<3>, at(a = 2.0)), 2.0/3.0));
+        expect(eq(value_of(a/val<2>, at(a = 3)), 1));
+    };
+
+    "log_operator_of_pow"_test = [] () {
+        var a;
+        let b;
+        static_assert(std::is_same_v<decltype(log(pow(a, b))), decltype(b*log(a))>);
+        static_assert(std::is_same_v<decltype(log(pow(a, val<3>))), decltype(val<3>*log(a))>);
+        static_assert(std::is_same_v<decltype(log(pow(a, val<2>))), operation<operators::log, decltype(pow(a, val<2>))>>);
+        expect(fuzzy_eq(value_of(log(pow(a, b)), at(a = 2.0, b = 3.0)), std::log(8.0)));
+    };
+
     "operation_derivative_wrt_expression"_test = [] () {
         static constexpr let a;
         static constexpr var b;
@@ -354,6 +380,27 @@ int main() {
         static_assert(is_any_of_v<decltype(expr), unique_composites>);
     };
 
+    "operation_unique_nodes_of_order"_test = [] () {
+        using namespace xp::traits;
+
+        let a;
+        var b;
+        auto sum_1 = a + b;
+        auto sum_2 = b + a;
+        auto expr = sum_1*sum_2 + a;
+
+        // of equal nodes, the last occurrence in the list of all nodes is kept
+        using unique_nodes = unique_nodes_of_t<decltype(expr)>;
+        static_assert(std::is_same_v<
+            unique_nodes,
+            xp::type_list<decltype(expr), decltype(sum_1*sum_2), decltype(sum_2), decltype(b), decltype(a)>
+        >);
+        static_assert(std::is_same_v<
+            xp::filtered_list_t<is_leaf_node, unique_nodes>,
+            xp::type_list<decltype(b), decltype(a)>
+        >);
+    };
+
     "operation_symbols_variables_of"_test = [] () {
         using namespace xp::traits;
 
@@ -373,6 +420,117 @@ int main() {
         static_assert(is_any_of_v<decltype(b), variables>);
     };
 
+    "nary_sum_and_product"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr var c;
+        static constexpr auto s = sum(a, b, c, val<0>, a);
+        static constexpr auto p = product(a, b, val<1>, c);
+        static_assert(traits::children_of_t<std::remove_cvref_t<decltype(s)>>::size == 4);
+        static_assert(traits::children_of_t<std::remove_cvref_t<decltype(p)>>::size == 3);
+        static_assert(traits::depth_of_v<std::remove_cvref_t<decltype(s)>> == 2);
+        static_assert(value_of(s, at(a = 1, b = 2, c = 3)) == 7);
+        static_assert(value_of(p, at(a = 2, b = 3, c = 4)) == 24);
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(sum(a))>, std::remove_cvref_t<decltype(a)>>);
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(product(a, val<0>, b))>, value<0>>);
+
+        // extending n-ary operations keeps them flat
+        static_assert(traits::children_of_t<std::remove_cvref_t<decltype(s + b)>>::size == 5);
+        static_assert(traits::children_of_t<std::remove_cvref_t<decltype(p*b)>>::size == 4);
+
+        // operands of n-ary sums may be permuted, whereas products of tensors are not associative
+        static_assert(sum(a, b, c) == sum(c, a, b));
+        static_assert(product(a, b, c) != product(b, c, a));
+        static_assert(sum(a, a, b) != sum(a, b, b));
+    };
+
+    "nary_product_of_tensors_keeps_operand_order"_test = [] () {
+        static constexpr vector<2> a{};
+        static constexpr vector<2> b{};
+        static constexpr vector<2> c{};
+        static constexpr auto values = at(
+            a = linalg::tensor{shape<2>, 1, 2},
+            b = linalg::tensor{shape<2>, 3, 4},
+            c = linalg::tensor{shape<2>, 5, 6}
+        );
+        // (a*b)*c != a*(b*c) for scalar products
+        static_assert(value_of(product(a, b, c), values) == linalg::tensor{shape<2>, 55, 66});
+        static_assert(value_of(product(a, b, c), values) == value_of(a*b*c, values));
+    };
+
+    "nary_product_of_non_commutative_operands"_test = [] () {
+        struct matrix {
+            int a00, a01, a10, a11;
+            constexpr bool operator==(const matrix&) const = default;
+            constexpr matrix operator*(const matrix& o) const {
+                return {a00*o.a00 + a01*o.a10, a00*o.a01 + a01*o.a11, a10*o.a00 + a11*o.a10, a10*o.a01 + a11*o.a11};
+            }
+        };
+
+        static constexpr matrix A{1, 1, 0, 1};
+        static constexpr matrix B{1, 0, 1, 1};
+        static constexpr matrix I{1, 0, 0, 1};
+        static_assert(A*B != B*A);
+        static_assert(xp::detail::apply_operator(operators::multiply{}, A, B, I) == A*B);
+        static_assert(xp::detail::apply_operator(operators::multiply{}, B, A, I) == B*A);
+        static_assert(xp::detail::apply_operator(operators::multiply{}, I, B, A, I) == B*A);
+    };
+
+    "nary_sum_and_product_derivative"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr var c;
+        static constexpr auto s = sum(a*b, b, c*a);
+        static constexpr auto p = product(a, b, c, a);
+        static_assert(derivative_of(s, wrt(a), at(a = 1, b = 2, c = 3)) == 5);
+        static_assert(derivative_of(s, wrt(b), at(a = 1, b = 2, c = 3)) == 2);
+        static_assert(derivative_of(p, wrt(a), at(a = 2, b = 3, c = 4)) == 2*2*3*4);
+        static_assert(derivative_of(p, wrt(c), at(a = 2, b = 3, c = 4)) == 2*3*2);
+        expect(eq(derivative_of(p, wrt(b), at(a = 2, b = 3, c = 4)), 2*4*2));
+    };
+
+    "operation_introspection"_test = [] () {
+        using namespace xp::traits;
+
+        var a;
+        var b;
+        auto sum = a + b;
+        auto expr = sum*sum + log(sum)/b;
+        using E = decltype(expr);
+
+        static_assert(depth_of_v<decltype(a)> == 1);
+        static_assert(depth_of_v<decltype(sum)> == 2);
+        static_assert(depth_of_v<E> == 5);
+
+        static_assert(node_count_of_v<E> == 14);
+        static_assert(unique_node_count_of_v<E> == 7);
+
+        static_assert(operation_count_of_v<operators::add, E> == 4);
+        static_assert(operation_count_of_v<operators::multiply, E> == 1);
+        static_assert(operation_count_of_v<operators::log, E> == 1);
+        static_assert(operation_count_of_v<operators::pow, E> == 0);
+        static_assert(unique_operation_count_of_v<operators::add, E> == 2);
+
+        static_assert(evaluation_cost_of_v<E> == 4 + 1 + operator_cost_v<operators::log> + operator_cost_v<operators::divide>);
+        static_assert(unique_evaluation_cost_of_v<E> == 2 + 1 + operator_cost_v<operators::log> + operator_cost_v<operators::divide>);
+    };
+
+    "nary_operation_introspection"_test = [] () {
+        using namespace xp::traits;
+
+        var a;
+        var b;
+        var c;
+        using S = decltype(sum(a, b, c, a*b));
+        using P = decltype(product(a, b, c));
+        static_assert(operation_count_of_v<operators::add, S> == 3);
+        static_assert(operation_count_of_v<operators::multiply, S> == 1);
+        static_assert(evaluation_cost_of_v<S> == evaluation_cost_of_v<decltype(a + b + c + a*b)>);
+        static_assert(operation_count_of_v<operators::multiply, P> == 2);
+        static_assert(evaluation_cost_of_v<P> == 2*operator_cost_v<operators::multiply>);
+        static_assert(unique_evaluation_cost_of_v<decltype(sum(a, b, c)*sum(a, b, c))> == 2 + operator_cost_v<operators::multiply>);
+    };
+
     "operation_dtype_with_any"_test = [] () {
         let<dtype::real> a;
         let<dtype::integral> b;
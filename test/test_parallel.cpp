@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <span>
+#include <vector>
+#include <execution>
+
+#include <xpress/xp.hpp>
+#include <xpress/parallel.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    static constexpr var a;
+    static constexpr var b;
+    static constexpr auto expr = a*b + log(a)*b - a/b;
+    static constexpr std::size_t n = 1000;
+
+    const auto make_bindings = [] () {
+        std::vector<decltype(at(a = 0.0, b = 0.0))> result;
+        for (std::size_t i = 0; i < n; ++i)
+            result.push_back(at(a = 1.0 + 0.01*static_cast<double>(i), b = 2.0 + 0.1*static_cast<double>(i)));
+        return result;
+    };
+
+    "parallel_evaluate_with_threads"_test = [&] () {
+        const auto points = make_bindings();
+        std::vector<double> values(n);
+        parallel_evaluate(expr, points, values, threads{4});
+        for (std::size_t i = 0; i < n; ++i)
+            expect(fuzzy_eq(values[i], value_of(expr, points[i])));
+    };
+
+    "parallel_evaluate_with_execution_policy"_test = [&] () {
+        const auto points = make_bindings();
+        std::vector<double> values(n);
+        parallel_evaluate(expr, points, values, std::execution::par);
+        for (std::size_t i = 0; i < n; ++i)
+            expect(fuzzy_eq(values[i], value_of(expr, points[i])));
+    };
+
+    "parallel_evaluate_derivatives"_test = [&] () {
+        const auto points = make_bindings();
+        std::vector<double> derivs(n);
+        parallel_evaluate([] (const auto& p) { return derivatives_of(expr, wrt(a), p)[a]; }, points, derivs, threads{3});
+        for (std::size_t i = 0; i < n; ++i)
+            expect(fuzzy_eq(derivs[i], derivatives_of(expr, wrt(a), points[i])[a]));
+    };
+
+    "parallel_batch"_test = [&] () {
+        std::vector<double> a_values(n);
+        std::vector<double> b_values(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            a_values[i] = 1.0 + 0.01*static_cast<double>(i);
+            b_values[i] = 2.0 + 0.1*static_cast<double>(i);
+        }
+        std::vector<double> out(n);
+        parallel_batch(expr, std::span{out}, threads{3}, a = std::span{a_values}, b = b_values);
+        for (std::size_t i = 0; i < n; ++i)
+            expect(fuzzy_eq(out[i], value_of(expr, at(a = a_values[i], b = b_values[i]))));
+    };
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+
+#include <xpress/xp.hpp>
+#include <xpress/reverse.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "reverse_gradient_simple"_test = [] () {
+        static constexpr var a;
+        static constexpr var b;
+        static constexpr auto expr = a*b + a;
+        constexpr auto grad = gradient_of(expr, at(a = 2, b = 3), reverse);
+        static_assert(grad[a] == 4);
+        static_assert(grad[b] == 2);
+        expect(eq(grad[a], 4));
+        expect(eq(grad[b], 2));
+    };
+
+    "reverse_gradient_matches_symbolic"_test = [] () {
+        var a;
+        var b;
+        let c;
+        auto unit = a*((a + b)*b + (a*b) + b);
+        auto expr = unit*log(a*b) + pow(unit, c)/b - unit;
+        const auto values = at(a = 1.5, b = 2.5, c = 2.0);
+        const auto symbolic = gradient_of(expr, values);
+        const auto adjoint = gradient_of(expr, values, reverse);
+        expect(fuzzy_eq(adjoint[a], symbolic[a]));
+        expect(fuzzy_eq(adjoint[b], symbolic[b]));
+    };
+
+    "reverse_derivatives_selected_variables"_test = [] () {
+        var a;
+        var b;
+        var c;
+        auto expr = a*b*c + c*c;
+        const auto derivs = derivatives_of(expr, wrt(c, a), at(a = 1.0, b = 2.0, c = 3.0), reverse);
+        expect(fuzzy_eq(derivs[a], 6.0));
+        expect(fuzzy_eq(derivs[c], 2.0 + 6.0));
+    };
+
+    "reverse_derivative_wrt_sub_expression"_test = [] () {
+        var a;
+        var b;
+        auto sum = a + b;
+        auto expr = val<42>*sum + sum*sum;
+        const auto derivs = derivatives_of(expr, wrt(sum), at(a = 1.0, b = 2.0), reverse);
+        expect(fuzzy_eq(derivs[sum], 42.0 + 2.0*3.0));
+    };
+
+    "reverse_gradient_of_leaf"_test = [] () {
+        static constexpr var a;
+        static_assert(gradient_of(a, at(a = 42), reverse)[a] == 1);
+    };
+
+    "reverse_gradient_with_tensor_operands"_test = [] () {
+        var a;
+        var b;
+        auto v1 = vector_expression::from(a, a*b);
+        auto v2 = vector_expression::from(b, a);
+        auto expr = v1*v2 + a*b;
+        const auto values = at(a = 2.0, b = 3.0);
+        const auto symbolic = gradient_of(expr, values);
+        const auto adjoint = gradient_of(expr, values, reverse);
+        expect(fuzzy_eq(adjoint[a], symbolic[a]));
+        expect(fuzzy_eq(adjoint[b], symbolic[b]));
+    };
+
+    "value_and_gradient_of_reverse"_test = [] () {
+        var a;
+        var b;
+        auto expr = a*log(b) + a*a*b;
+        const auto values = at(a = 2.0, b = 3.0);
+        const auto [value, grad] = value_and_gradient_of(expr, values, reverse);
+        const auto symbolic = gradient_of(expr, values);
+        expect(fuzzy_eq(value, value_of(expr, values)));
+        expect(fuzzy_eq(grad[a], symbolic[a]));
+        expect(fuzzy_eq(grad[b], symbolic[b]));
+    };
+
+    "reverse_derivatives_evaluated_later"_test = [] () {
+        var a;
+        var b;
+        auto expr = a*log(b) + a*a*b;
+        const auto symbolic = derivatives_of(expr, wrt(a, b));
+        const auto adjoint = derivatives_of(expr, wrt(a, b), reverse);
+        const auto expected = symbolic.at(a = 2.0, b = 3.0);
+        const auto actual = adjoint.at(a = 2.0, b = 3.0);
+        expect(fuzzy_eq(actual[a], expected[a]));
+        expect(fuzzy_eq(actual[b], expected[b]));
+        expect(fuzzy_eq(gradient_of(expr, reverse).at(at(a = 2.0, b = 3.0))[b], expected[b]));
+    };
+
+    return 0;
+}
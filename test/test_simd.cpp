@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+
+#include <xpress/xp.hpp>
+#include <xpress/simd.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+#ifdef __cpp_lib_experimental_parallel_simd
+    using pack = std::experimental::native_simd<double>;
+
+    "simd_pack_is_scalar"_test = [] () {
+        static_assert(is_scalar_v<pack>);
+        static_assert(std::is_same_v<scalar_type_t<pack>, pack>);
+        static_assert(bindable_to<pack, dtype::real>);
+        static_assert(!bindable_to<pack, dtype::integral>);
+    };
+
+    "simd_pack_evaluation"_test = [] () {
+        var a;
+        var b;
+        auto expr = a*b + log(a)/pow(b, val<2>) - a/val<2>;
+        const pack a_values([] (auto i) { return 1.0 + static_cast<double>(i); });
+        const pack b_values([] (auto i) { return 2.0 + 0.5*static_cast<double>(i); });
+
+        const pack result = value_of(expr, at(a = a_values, b = b_values));
+        for (std::size_t i = 0; i < pack::size(); ++i)
+            expect(fuzzy_eq(
+                static_cast<double>(result[i]),
+                value_of(expr, at(a = static_cast<double>(a_values[i]), b = static_cast<double>(b_values[i])))
+            ));
+
+        const auto grad = gradient_of(expr, at(a = a_values, b = b_values));
+        for (std::size_t i = 0; i < pack::size(); ++i)
+            expect(fuzzy_eq(
+                static_cast<double>(grad[a][i]),
+                gradient_of(expr, at(a = static_cast<double>(a_values[i]), b = static_cast<double>(b_values[i])))[a]
+            ));
+    };
+#endif
+
+    return 0;
+}
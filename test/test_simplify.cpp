@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <type_traits>
+
+#include <xpress/xp.hpp>
+#include <xpress/simplify.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "simplify_like_terms"_test = [] () {
+        var a;
+        var b;
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a*b + b*a + a*b)>, decltype(product(val<3>, a, b))>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a + b - a)>, decltype(b)>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a*b - b*a)>, value<0>>);
+    };
+
+    "simplify_coefficients"_test = [] () {
+        var a;
+        var b;
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(val<2>*a*val<3>)>, decltype(val<6>*a)>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(val<1> + a + val<2>)>, decltype(a + val<3>)>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a - val<2>*b - b)>, decltype(a - val<3>*b)>);
+    };
+
+    "simplify_powers"_test = [] () {
+        var a;
+        var b;
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a*b*a)>, decltype((a*a)*b)>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a*a*b*pow(a, val<-2>))>, decltype(b)>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(a*pow(a, b))>, decltype(pow(a, b + val<1>))>);
+    };
+
+    "simplify_derivative"_test = [] () {
+        var a;
+        auto derivative = derivative_of(a*a*a, wrt(a));
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(derivative)>, decltype(val<3>*(a*a))>);
+        static_assert(
+            traits::unique_nodes_of_t<decltype(simplify(derivative))>::size
+            < traits::unique_nodes_of_t<decltype(derivative)>::size
+        );
+    };
+
+    "simplify_preserves_value"_test = [] () {
+        var a;
+        var b;
+        auto unit = a*((a + b)*b + (a*b) + b);
+        auto expr = unit*log(a*b) + unit*unit/b - b*a*(b + a);
+        const auto values = at(a = 1.5, b = 2.5);
+        expect(fuzzy_eq(value_of(simplify(expr), values), value_of(expr, values)));
+        const auto derivs = gradient_of(expr, values);
+        expect(fuzzy_eq(value_of(simplify(derivative_of(expr, wrt(a))), values), derivs[a]));
+        expect(fuzzy_eq(value_of(simplify(derivative_of(expr, wrt(b))), values), derivs[b]));
+    };
+
+    "simplify_tensor_products"_test = [] () {
+        static constexpr vector<2> v1{};
+        static constexpr vector<2> v2{};
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(v1*v2 + v1*v2)>, decltype(val<2>*(v1*v2))>);
+        static_assert(std::is_same_v<traits::simplified_of_t<decltype(v1*v1)>, decltype(v1*v1)>);
+    };
+
+    return 0;
+}
@@ -1,8 +1,14 @@
 // SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
 // SPDX-License-Identifier: MIT
 
+#include <cmath>
+#include <span>
+#include <vector>
+
 #include <xpress/xp.hpp>
 #include <xpress/solvers/newton.hpp>
+#include <xpress/solvers/batched_newton.hpp>
+#include <xpress/solvers/levenberg_marquardt.hpp>
 
 #include "testing.hpp"
 
@@ -63,5 +69,309 @@ int main() {
         expect(fuzzy_eq((*solution)[b], 1.0));
     };
 
+    "newton_solver_3d_vector_equation"_test = [] () {
+        var a;
+        var b;
+        var c;
+        constexpr auto eq_system = vector_expression_builder<3>{}
+                                    .with(a*a + b - val<3.0>, at<0>())
+                                    .with(a*b*c - val<6.0>, at<1>())
+                                    .with(c*c - b*a - val<7.0>, at<2>())
+                                    .build();
+        auto solution = solvers::newton{{
+            .threshold = 1e-10,
+            .max_iterations = 50
+        }}.find_root_of(eq_system, starting_from(a = 1.5, b = 1.5, c = 2.5));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[a], 1.0));
+        expect(fuzzy_eq((*solution)[b], 2.0));
+        expect(fuzzy_eq((*solution)[c], 3.0));
+    };
+
+    "newton_solver_singular_jacobian"_test = [] () {
+        var a;
+        expect(!solvers::newton{{
+            .threshold = 1e-6,
+            .max_iterations = 20
+        }}.find_root_of(a*a + val<1.0>, starting_from(a = 0.0)).has_value());
+    };
+
+    "newton_solver_frozen_jacobian"_test = [] () {
+        var a;
+        var b;
+        constexpr auto eq_system = vector_expression_builder<2>{}
+                                    .with(a*a - val<1.0>, at<0>())
+                                    .with(b*b - val<1.0>, at<1>())
+                                    .build();
+        auto solution = solvers::newton{
+            {.threshold = 1e-10, .max_iterations = 100},
+            {.update = jacobian_update::frozen, .reevaluation_interval = 3}
+        }.find_root_of(eq_system, starting_from(a = 3.0, b = 4.0));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[a], 1.0));
+        expect(fuzzy_eq((*solution)[b], 1.0));
+    };
+
+    "newton_solver_observer"_test = [] () {
+        var a;
+        std::vector<solver_event<double>> events;
+        auto solution = solvers::newton{solver_options{
+            .threshold = 1e-10,
+            .max_iterations = 20,
+            .observer = [&] (const solver_event<double>& e) { events.push_back(e); }
+        }}.find_scalar_root_of(a*a - val<2.0>, starting_from(a = 3.0));
+        expect(solution.has_value());
+        expect(events.size() > std::size_t{2});
+        expect(events.front().status == solver_status::iterating);
+        expect(events.back().status == solver_status::converged);
+        expect(eq(events.back().iteration, events.size() - 1));
+        expect(events.back().residual_norm <= 1e-10);
+        for (const auto& e : events) {
+            expect(e.timings.jacobian_evaluation >= 0.0);
+            expect(e.timings.linear_solve >= 0.0);
+        }
+    };
+
+    "newton_solver_observer_failure"_test = [] () {
+        var a;
+        solver_status status = solver_status::iterating;
+        expect(!solvers::newton{solver_options{
+            .threshold = 1e-6,
+            .max_iterations = 20,
+            .observer = [&] (const solver_event<double>& e) { status = e.status; }
+        }}.find_root_of(a*a + val<1.0>, starting_from(a = 0.0)).has_value());
+        expect(status == solver_status::singular_jacobian);
+    };
+
+    "newton_solver_broyden_scalar_constexpr"_test = [] () {
+        var a;
+        constexpr auto solution = solvers::newton{
+            {.threshold = 1e-10, .max_iterations = 50},
+            {.update = jacobian_update::broyden}
+        }.find_scalar_root_of(a*a - val<2.0>, starting_from(a = 3.0));
+        static_assert(solution.has_value());
+        static_assert(fuzzy_eq(*solution, 1.4142135623730951));
+    };
+
+    "newton_solver_broyden_3d_vector_equation"_test = [] () {
+        var a;
+        var b;
+        var c;
+        constexpr auto eq_system = vector_expression_builder<3>{}
+                                    .with(a*a + b - val<3.0>, at<0>())
+                                    .with(a*b*c - val<6.0>, at<1>())
+                                    .with(c*c - b*a - val<7.0>, at<2>())
+                                    .build();
+        auto solution = solvers::newton{
+            {.threshold = 1e-10, .max_iterations = 100},
+            {.update = jacobian_update::broyden}
+        }.find_root_of(eq_system, starting_from(a = 1.1, b = 1.9, c = 2.9));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[a], 1.0));
+        expect(fuzzy_eq((*solution)[b], 2.0));
+        expect(fuzzy_eq((*solution)[c], 3.0));
+    };
+
+    "newton_solver_block_diagonal_system"_test = [] () {
+        var a;
+        var b;
+        var c;
+        var d;
+        // (a, c) and (b, d) form two independent 2x2 systems
+        constexpr auto eq_system = vector_expression::from(
+            a + c - val<3.0>,
+            b*d - val<12.0>,
+            a*c - val<2.0>,
+            d - b - val<1.0>
+        );
+        static_assert(linalg::block_lu_factorization<
+            double, 4, traits::jacobian_pattern_of_t<decltype(eq_system), decltype(wrt(a, b, c, d))>
+        >::block_count() == 2);
+
+        auto solution = solvers::newton{{
+            .threshold = 1e-12,
+            .max_iterations = 50
+        }}.find_root_of(eq_system, starting_from(a = 1.2, b = 2.5, c = 1.8, d = 4.5));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[a], 1.0));
+        expect(fuzzy_eq((*solution)[b], 3.0));
+        expect(fuzzy_eq((*solution)[c], 2.0));
+        expect(fuzzy_eq((*solution)[d], 4.0));
+    };
+
+    "newton_solver_broyden_block_diagonal_system"_test = [] () {
+        var a;
+        var b;
+        var c;
+        constexpr auto eq_system = vector_expression::from(a*a - val<4.0>, b*c - val<6.0>, c - b - val<1.0>);
+        auto solution = solvers::newton{
+            {.threshold = 1e-10, .max_iterations = 100},
+            {.update = jacobian_update::broyden}
+        }.find_root_of(eq_system, starting_from(a = 2.2, b = 1.9, c = 3.1));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[a], 2.0));
+        expect(fuzzy_eq((*solution)[b], 2.0));
+        expect(fuzzy_eq((*solution)[c], 3.0));
+    };
+
+    "newton_solver_structurally_singular_system"_test = [] () {
+        var a;
+        var b;
+        var c;
+        // the last two equations only depend on a
+        constexpr auto eq_system = vector_expression::from(b + c, a*a - val<1.0>, a - val<1.0>);
+        expect(!solvers::newton{{
+            .threshold = 1e-6,
+            .max_iterations = 20
+        }}.find_root_of(eq_system, starting_from(a = 3.0, b = 1.0, c = 2.0)).has_value());
+    };
+
+    "batched_newton_solver"_test = [] () {
+        var x;
+        let c;
+        std::vector<double> guesses(150, 1.0);
+        std::vector<double> params(150);
+        for (std::size_t i = 0; i < params.size(); ++i)
+            params[i] = 1.0 + static_cast<double>(i);
+
+        const auto report = batched_newton{{
+            .threshold = 1e-10,
+            .max_iterations = 50
+        }}.find_roots_of(x*x - c, x = std::span{guesses}, c = std::span{params});
+        expect(report.all_converged());
+        expect(eq(report.size(), std::size_t{150}));
+        expect(eq(report.iterations[0], std::size_t{0}));
+        expect(report.iterations[149] > std::size_t{1});
+        for (std::size_t i = 0; i < guesses.size(); ++i)
+            expect(fuzzy_eq(guesses[i], std::sqrt(params[i])));
+    };
+
+    "batched_newton_solver_with_shared_parameter"_test = [] () {
+        var x;
+        let c;
+        std::vector<double> guesses{0.0, 1.0, 3.0, -2.0};
+        const auto report = batched_newton{{
+            .threshold = 1e-10,
+            .max_iterations = 50
+        }}.find_roots_of(x*x - c, x = std::span{guesses}, c = 4.0);
+        expect(eq(report.converged_count(), std::size_t{3}));
+        expect(report.status[0] == batch_status::singular_jacobian);
+        expect(report.status[1] == batch_status::converged);
+        expect(fuzzy_eq(guesses[1], 2.0));
+        expect(fuzzy_eq(guesses[2], 2.0));
+        expect(fuzzy_eq(guesses[3], -2.0));
+    };
+
+    "batched_newton_solver_failure"_test = [] () {
+        var x;
+        std::vector<double> guesses{3.0, 1.0};
+        const auto report = batched_newton{{
+            .threshold = 1e-10,
+            .max_iterations = 1
+        }}.find_roots_of(x*x - val<1.0>, x = std::span{guesses});
+        expect(report.status[0] == batch_status::not_converged);
+        expect(eq(report.iterations[0], std::size_t{1}));
+        expect(report.status[1] == batch_status::converged);
+    };
+
+    "batched_newton_solver_non_finite_residual"_test = [] () {
+        var x;
+        std::vector<double> guesses{-1.0, 2.0, 0.0};
+        const auto report = batched_newton{{
+            .threshold = 1e-10,
+            .max_iterations = 50
+        }}.find_roots_of(log(x) - val<1.0>, x = std::span{guesses});
+        expect(report.status[0] == batch_status::diverged);
+        expect(eq(report.iterations[0], std::size_t{0}));
+        expect(report.status[1] == batch_status::converged);
+        expect(fuzzy_eq(guesses[1], std::exp(1.0)));
+        expect(report.status[2] == batch_status::diverged);
+        expect(eq(guesses[0], -1.0));
+    };
+
+    "batched_newton_solver_parallel"_test = [] () {
+        var x;
+        let c;
+        std::vector<double> guesses(1000, 1.0);
+        std::vector<double> params(1000);
+        for (std::size_t i = 0; i < params.size(); ++i)
+            params[i] = 1.0 + 0.5*static_cast<double>(i);
+
+        const auto report = batched_newton{{
+            .threshold = 1e-10,
+            .max_iterations = 50
+        }}.find_roots_of(threads{4}, x*x - c, x = std::span{guesses}, c = std::span{params});
+        expect(report.all_converged());
+        for (std::size_t i = 0; i < guesses.size(); ++i)
+            expect(fuzzy_eq(guesses[i], std::sqrt(params[i])));
+    };
+
+    "levenberg_marquardt_linear_fit"_test = [] () {
+        var p0;
+        var p1;
+        // fit a line through the points (0, 1), (1, 3), (2, 4), (3, 8)
+        constexpr auto residuals = vector_expression_builder<4>{}
+                                    .with(p0 - val<1.0>, at<0>())
+                                    .with(p0 + p1 - val<3.0>, at<1>())
+                                    .with(p0 + val<2.0>*p1 - val<4.0>, at<2>())
+                                    .with(p0 + val<3.0>*p1 - val<8.0>, at<3>())
+                                    .build();
+        const auto solution = levenberg_marquardt{{
+            .threshold = 1e-10,
+            .max_iterations = 50
+        }}.find_least_squares_solution_of(residuals, starting_from(p0 = 0.0, p1 = 0.0));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[p0], 0.7));
+        expect(fuzzy_eq((*solution)[p1], 2.2));
+    };
+
+    "levenberg_marquardt_rosenbrock"_test = [] () {
+        var a;
+        var b;
+        constexpr auto residuals = vector_expression_builder<2>{}
+                                    .with(val<10.0>*(b - a*a), at<0>())
+                                    .with(val<1.0> - a, at<1>())
+                                    .build();
+        const auto solution = levenberg_marquardt{{
+            .threshold = 1e-12,
+            .max_iterations = 200
+        }}.find_least_squares_solution_of(residuals, starting_from(a = -1.2, b = 1.0));
+        expect(solution.has_value());
+        expect(fuzzy_eq((*solution)[a], 1.0));
+        expect(fuzzy_eq((*solution)[b], 1.0));
+    };
+
+    "gauss_newton_constexpr"_test = [] () {
+        var a;
+        var b;
+        constexpr auto solution = levenberg_marquardt{
+            {.threshold = 1e-10, .max_iterations = 50},
+            {.initial = 0.0}
+        }.find_least_squares_solution_of(
+            vector_expression_builder<3>{}
+                .with(a - val<1.0>, at<0>())
+                .with(b - val<2.0>, at<1>())
+                .with(a + b - val<4.0>, at<2>())
+                .build(),
+            starting_from(a = 0.0, b = 0.0)
+        );
+        static_assert(solution.has_value());
+        static_assert(fuzzy_eq((*solution)[a], 4.0/3.0));
+        static_assert(fuzzy_eq((*solution)[b], 7.0/3.0));
+    };
+
+    "levenberg_marquardt_failure"_test = [] () {
+        var a;
+        var b;
+        constexpr auto residuals = vector_expression_builder<2>{}
+                                    .with(val<10.0>*(b - a*a), at<0>())
+                                    .with(val<1.0> - a, at<1>())
+                                    .build();
+        expect(!levenberg_marquardt{{
+            .threshold = 1e-12,
+            .max_iterations = 1
+        }}.find_least_squares_solution_of(residuals, starting_from(a = -1.2, b = 1.0)).has_value());
+    };
+
     return 0;
 }
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <type_traits>
+
+#include <xpress/xp.hpp>
+#include <xpress/specialize.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "specialize_stages_maximal_parameter_subtrees"_test = [] () {
+        let c;
+        let d;
+        var x;
+        auto prefactor = log(c*c + d);
+        auto expr = prefactor*x + c*x;
+        const auto f = specialize(expr, at(c = 2.0, d = 1.0));
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(f)>::staged_nodes, type_list<decltype(prefactor)>>);
+        expect(fuzzy_eq(f[prefactor], std::log(5.0)));
+        expect(fuzzy_eq(f(x = 3.0), std::log(5.0)*3.0 + 6.0));
+        expect(fuzzy_eq(f.at(at(x = 3.0)), value_of(expr, at(c = 2.0, d = 1.0, x = 3.0))));
+    };
+
+    "specialize_without_variable_dependent_part"_test = [] () {
+        let c;
+        const auto f = specialize(c*log(c), at(c = 3.0));
+        expect(fuzzy_eq(f(), 3.0*std::log(3.0)));
+    };
+
+    "specialize_copies_parameters"_test = [] () {
+        let c;
+        var x;
+        double value = 2.0;
+        const auto f = specialize(c*c*x, at(c = value));
+        value = 10.0;
+        expect(fuzzy_eq(f(x = 3.0), 12.0));
+    };
+
+    "specialize_constexpr"_test = [] () {
+        static constexpr let c;
+        static constexpr var x;
+        constexpr auto f = specialize(c*(c + val<1>)*x + c, at(c = 2));
+        static_assert(f(x = 3) == 20);
+    };
+}
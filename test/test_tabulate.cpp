@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+
+#include <xpress/xp.hpp>
+#include <xpress/tabulate.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "tabulate_cubic_reproduces_cubic_polynomials"_test = [] () {
+        static constexpr var t;
+        static constexpr auto table = tabulate<5>(t*t*t - val<2>*t, wrt(t), interval{-1.0, 1.0});
+        static_assert(fuzzy_eq(table(t = 0.3), 0.3*0.3*0.3 - 0.6));
+        static_assert(fuzzy_eq(table(t = -0.85), -0.85*0.85*0.85 + 1.7));
+        static_assert(fuzzy_eq(table(t = 1.0), -1.0));
+    };
+
+    "tabulate_linear_reproduces_linear_functions"_test = [] () {
+        static constexpr var t;
+        static constexpr auto table = tabulate<3, interpolation::linear>(val<3>*t + val<1>, wrt(t), interval{0.0, 2.0});
+        static_assert(fuzzy_eq(table(t = 0.7), 3.1));
+        static_assert(fuzzy_eq(table(t = 1.9), 6.7));
+    };
+
+    "tabulate_clamps_to_range"_test = [] () {
+        static constexpr var t;
+        static constexpr auto table = tabulate<4>(t*t, wrt(t), interval{0.0, 1.0});
+        static_assert(fuzzy_eq(table(t = -1.0), 0.0));
+        static_assert(fuzzy_eq(table(t = 2.0), 1.0));
+    };
+
+    "tabulate_1d_error"_test = [] () {
+        var t;
+        const auto expr = log(t)*pow(t, val<3>);
+        const auto cubic = tabulate<65>(expr, wrt(t), interval{1.0, 2.0});
+        const auto linear = tabulate<65, interpolation::linear>(expr, wrt(t), interval{1.0, 2.0});
+        expect(fuzzy_eq(cubic(t = 1.234), std::log(1.234)*std::pow(1.234, 3), 1e-8));
+        expect(fuzzy_eq(linear(t = 1.234), std::log(1.234)*std::pow(1.234, 3), 1e-3));
+
+        const auto cubic_error = cubic.estimated_error();
+        const auto linear_error = linear.estimated_error();
+        expect(cubic_error.max_absolute < 1e-8);
+        expect(cubic_error.max_relative < 1e-6);
+        expect(linear_error.max_absolute < 1e-3);
+        expect(cubic_error.max_absolute < linear_error.max_absolute);
+    };
+
+    "tabulate_2d"_test = [] () {
+        var t;
+        var p;
+        const auto expr = log(t*p)*t + p*p;
+        const auto table = tabulate<33>(expr, wrt(t, p), interval{1.0, 2.0}, interval{0.5, 1.5});
+        expect(fuzzy_eq(table(t = 1.3, p = 0.77), std::log(1.3*0.77)*1.3 + 0.77*0.77, 1e-5));
+        expect(fuzzy_eq(table(p = 0.77, t = 1.3), table(t = 1.3, p = 0.77)));
+        expect(table.estimated_error().max_absolute < 1e-5);
+    };
+
+    return 0;
+}
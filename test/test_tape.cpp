@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2024 Dennis Gläser <dennis.a.glaeser@gmail.com>
+// SPDX-License-Identifier: MIT
+
+#include <cmath>
+#include <array>
+#include <span>
+#include <vector>
+
+#include <xpress/xp.hpp>
+#include <xpress/tape.hpp>
+
+#include "testing.hpp"
+
+int main() {
+    using namespace xp;
+    using namespace xp::testing;
+
+    "tape_assembled_programmatically"_test = [] () {
+        // (x*y + 1)/log(x)
+        tape<double> t{2};
+        const auto xy = t.multiply(t.input(0), t.input(1));
+        t.mark_output(t.divide(t.add(xy, t.constant(1.0)), t.log(t.input(0))));
+        expect(eq(t.input_count(), std::size_t{2}));
+        expect(eq(t.size(), std::size_t{7}));
+
+        const std::array inputs{2.0, 3.0};
+        expect(fuzzy_eq(t.value(inputs), 7.0/std::log(2.0)));
+
+        std::array<double, 2> gradient{};
+        expect(fuzzy_eq(t.value_and_gradient(inputs, gradient), 7.0/std::log(2.0)));
+        expect(fuzzy_eq(gradient[0], 3.0/std::log(2.0) - 7.0/(2.0*std::log(2.0)*std::log(2.0))));
+        expect(fuzzy_eq(gradient[1], 2.0/std::log(2.0)));
+    };
+
+    "tape_recorded_from_expression"_test = [] () {
+        var a;
+        var b;
+        let c;
+        const auto expr = a*b*c + log(a*b)/pow(b, val<2>) - val<3>*a;
+        const auto t = tape_of(expr, wrt(a, b, c));
+        expect(eq(t.input_count(), std::size_t{3}));
+
+        const std::array inputs{1.5, 2.0, 0.5};
+        const auto values = at(a = 1.5, b = 2.0, c = 0.5);
+        expect(fuzzy_eq(t.value(inputs), value_of(expr, values)));
+
+        std::array<double, 3> gradient{};
+        t.gradient(inputs, gradient);
+        const auto expected = derivatives_of(expr, wrt(a, b, c), values);
+        expect(fuzzy_eq(gradient[0], expected[a]));
+        expect(fuzzy_eq(gradient[1], expected[b]));
+        expect(fuzzy_eq(gradient[2], expected[c]));
+    };
+
+    "tape_shares_common_subexpressions"_test = [] () {
+        var a;
+        var b;
+        const auto t = tape_of(a*b + log(a*b), wrt(a, b));
+        // two inputs, one multiplication, one log and one addition
+        expect(eq(t.size(), std::size_t{5}));
+    };
+
+    "tape_shares_constants"_test = [] () {
+        var a;
+        var b;
+        const auto expr = a*val<2> + b*val<2> - val<2>;
+        const auto t = tape_of(expr, wrt(a, b));
+        // two inputs, one constant, two multiplications, one addition and one subtraction
+        expect(eq(t.size(), std::size_t{7}));
+        expect(fuzzy_eq(t.value(std::array{1.0, 3.0}), value_of(expr, at(a = 1.0, b = 3.0))));
+    };
+
+    "tape_pow_gradient_at_zero"_test = [] () {
+        // the derivative of pow w.r.t. the base vanishes for a zero exponent, also at a zero base
+        tape<double> t{2};
+        t.mark_output(t.pow(t.input(0), t.input(1)));
+        const std::array inputs{0.0, 0.0};
+        std::array<double, 2> gradient{};
+        expect(eq(t.value_and_gradient(inputs, gradient), 1.0));
+        expect(eq(gradient[0], 0.0));
+
+        // the derivative w.r.t. a constant exponent (not finite for negative bases) is not evaluated
+        tape<double> squared{1};
+        squared.mark_output(squared.pow(squared.input(0), squared.add(squared.constant(1.0), squared.constant(1.0))));
+        std::array<double, 1> squared_gradient{};
+        expect(eq(squared.value_and_gradient(std::array{-3.0}, squared_gradient), 9.0));
+        expect(fuzzy_eq(squared_gradient[0], -6.0));
+    };
+
+    "tape_with_multiple_outputs"_test = [] () {
+        var a;
+        var b;
+        tape<double> t{2};
+        t.mark_output(t.record(a + b, wrt(a, b)));
+        t.mark_output(t.record(a*b, wrt(a, b)));
+        t.mark_output(t.record(b, wrt(a, b)));
+
+        std::array<double, 3> outputs{};
+        t.evaluate(std::array{2.0, 3.0}, outputs);
+        expect(fuzzy_eq(outputs[0], 5.0));
+        expect(fuzzy_eq(outputs[1], 6.0));
+        expect(fuzzy_eq(outputs[2], 3.0));
+    };
+
+    "tape_batch_evaluation"_test = [] () {
+        var a;
+        var b;
+        const auto expr = a*a + log(b) - a/b;
+        const auto t = tape_of(expr, wrt(a, b));
+
+        const std::size_t count = 150;
+        std::vector<double> a_values(count), b_values(count), results(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            a_values[i] = 0.5 + 0.01*static_cast<double>(i);
+            b_values[i] = 1.0 + 0.02*static_cast<double>(i);
+        }
+
+        const std::array<std::span<const double>, 2> inputs{a_values, b_values};
+        const std::array<std::span<double>, 1> outputs{results};
+        t.batch(inputs, outputs);
+        for (std::size_t i = 0; i < count; ++i)
+            expect(fuzzy_eq(results[i], value_of(expr, at(a = a_values[i], b = b_values[i]))));
+    };
+}
@@ -2,14 +2,21 @@
 // SPDX-License-Identifier: MIT
 
 #include <array>
+#include <cstdint>
+#include <cmath>
 #include <utility>
 #include <algorithm>
 #include <type_traits>
 #include <sstream>
+#include <span>
+#if __has_include(<mdspan>)
+#include <mdspan>
+#endif
 
 #include <xpress/operators.hpp>
 #include <xpress/symbols.hpp>
 #include <xpress/tensor.hpp>
+#include <xpress/hessian.hpp>
 
 #include "testing.hpp"
 
@@ -139,6 +146,104 @@ int main() {
         expect(value_of(pow(t, val<2>), at(t = m)) == squared_m);
     };
 
+    "aligned_tensor_elementwise_operations"_test = [] () {
+        using aligned = linalg::aligned_tensor<double, md_shape<5>>;
+        const aligned a{shape<5>, 1.0, 2.0, 3.0, 4.0, 5.0};
+        const aligned b{shape<5>, 2.0, 2.0, 2.0, 2.0, 2.0};
+        static_assert(alignof(aligned) == linalg::simd_alignment);
+        static_assert(sizeof(aligned) % linalg::simd_alignment == 0);
+        expect(eq(a.as_array().size(), std::size_t{5}));
+        expect(eq(reinterpret_cast<std::uintptr_t>(a.data()) % linalg::simd_alignment, std::uintptr_t{0}));
+
+        const tensor t1{shape<5>};
+        const tensor t2{shape<5>};
+        const auto values = at(t1 = a, t2 = b);
+        const auto sum = value_of(t1 + t2, values);
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(sum)>, aligned>);
+        expect(sum == linalg::tensor{shape<5>, 3.0, 4.0, 5.0, 6.0, 7.0});
+        expect(value_of(t1 - t2, values) == linalg::tensor{shape<5>, -1.0, 0.0, 1.0, 2.0, 3.0});
+        expect(value_of(t1*val<2>, values) == linalg::tensor{shape<5>, 2.0, 4.0, 6.0, 8.0, 10.0});
+        expect(value_of(t1/val<2>, values) == linalg::tensor{shape<5>, 0.5, 1.0, 1.5, 2.0, 2.5});
+        expect(value_of(pow(t1, val<2>), values) == linalg::tensor{shape<5>, 1.0, 4.0, 9.0, 16.0, 25.0});
+        expect(value_of(log(t1), values) == linalg::tensor{shape<5>,
+            std::log(1.0), std::log(2.0), std::log(3.0), std::log(4.0), std::log(5.0)
+        });
+        expect(fuzzy_eq(value_of(t1*t2, values), 30.0));
+        expect(value_of(t1 + t2, at(t1 = a, t2 = linalg::tensor{shape<5>, 1.0, 1.0, 1.0, 1.0, 1.0}))
+            == linalg::tensor{shape<5>, 2.0, 3.0, 4.0, 5.0, 6.0});
+    };
+
+    "structured_tensor_elementwise_operations"_test = [] () {
+        const tensor t1{shape<3, 3>};
+        const tensor t2{shape<3, 3>};
+        const linalg::diagonal_tensor D1{shape<3, 3>, 1.0, 2.0, 3.0};
+        const linalg::diagonal_tensor D2{shape<3, 3>, 4.0, 5.0, 6.0};
+        const auto sum = value_of(t1 + t2, at(t1 = D1, t2 = D2));
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(sum)>, linalg::diagonal_tensor<double, 3>>);
+        expect(sum == linalg::diagonal_tensor{shape<3, 3>, 5.0, 7.0, 9.0});
+        expect(value_of(t1*val<2>, at(t1 = D1)) == linalg::diagonal_tensor{shape<3, 3>, 2.0, 4.0, 6.0});
+
+        const linalg::symmetric_tensor S{shape<2, 2>, 1.0, 2.0, 4.0};
+        const tensor t3{shape<2, 2>};
+        const auto squared = value_of(pow(t3, val<2>), at(t3 = S));
+        static_assert(std::is_same_v<std::remove_cvref_t<decltype(squared)>, linalg::symmetric_tensor<double, 2>>);
+        expect(squared == linalg::symmetric_tensor{shape<2, 2>, 1.0, 4.0, 16.0});
+        expect(value_of(t3 - t3*val<2>, at(t3 = S)) == linalg::symmetric_tensor{shape<2, 2>, -1.0, -2.0, -4.0});
+    };
+
+    "span_and_mdspan_bindings"_test = [] () {
+        // structure-of-arrays buffer with three 3d vectors
+        static constexpr std::array<double, 9> buffer{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0};
+        static constexpr tensor t1{shape<3>};
+        static constexpr tensor t2{shape<3>};
+        using view = std::span<const double, 3>;
+        static_assert(tensorial<view>);
+        static_assert(shape_of_t<view>{} == shape<3>);
+        static_assert(std::is_same_v<scalar_type_t<view>, double>);
+
+        constexpr auto values = at(t1 = std::span{buffer}.subspan<0, 3>(), t2 = std::span{buffer}.subspan<6, 3>());
+        static_assert(value_of(t1*t2, values) == 1.0*7.0 + 2.0*8.0 + 3.0*9.0);
+        static_assert(value_of(t1 + t2, values) == linalg::tensor{shape<3>, 8.0, 10.0, 12.0});
+        static_assert(value_of(t1*val<2>, values) == linalg::tensor{shape<3>, 2.0, 4.0, 6.0});
+        static_assert(value_of(t2[at<1>()], values) == 8.0);
+
+#ifdef __cpp_lib_mdspan
+        static constexpr tensor m{shape<3, 3>};
+        const std::mdspan matrix{buffer.data(), std::extents<std::size_t, 3, 3>{}};
+        static_assert(tensorial<decltype(matrix)>);
+        expect(eq(value_of(det(m), at(m = matrix)), 0.0));
+        expect(eq(value_of(m[at<2, 1>()], at(m = matrix)), 8.0));
+#endif
+    };
+
+    "fused_elementwise_tensor_expressions"_test = [] () {
+        static constexpr tensor t1{shape<2, 2>};
+        static constexpr tensor t2{shape<2, 2>};
+        static constexpr tensor t3{shape<2, 2>};
+        static constexpr var x;
+        static constexpr auto values = at(
+            t1 = linalg::tensor{shape<2, 2>, 1.0, 2.0, 3.0, 4.0},
+            t2 = linalg::tensor{shape<2, 2>, 2.0, 3.0, 4.0, 5.0},
+            t3 = linalg::tensor{shape<2, 2>, 1.0, 1.0, 2.0, 2.0},
+            x = 2.0
+        );
+        static_assert(value_of(t1 + t2 + t3, values) == linalg::tensor{shape<2, 2>, 4.0, 6.0, 9.0, 11.0});
+        static_assert(value_of(x*(t1 - t3) + t2/val<2>, values) == linalg::tensor{shape<2, 2>, 1.0, 3.5, 4.0, 6.5});
+        expect(value_of(pow(t1 + t2, val<2>) - log(t3), values) == linalg::tensor{shape<2, 2>,
+            9.0 - std::log(1.0), 25.0 - std::log(1.0), 49.0 - std::log(2.0), 81.0 - std::log(2.0)
+        });
+
+        // element-wise trees around non-element-wise operations, and products of tensors (i.e. scalar products)
+        static constexpr vector<2> v{};
+        static_assert(value_of(mat_mul(t1 + t2, v) + mat_mul(t3, v), at(
+            t1 = linalg::tensor{shape<2, 2>, 1, 0, 0, 1},
+            t2 = linalg::tensor{shape<2, 2>, 1, 1, 0, 1},
+            t3 = linalg::tensor{shape<2, 2>, 1, 0, 0, 0},
+            v = linalg::tensor{shape<2>, 1, 2}
+        )) == linalg::tensor{shape<2>, 5, 4});
+        static_assert(value_of((t1 + t2)*t3 + x, values) == 3.0*1.0 + 5.0*1.0 + 7.0*2.0 + 9.0*2.0 + 2.0);
+    };
+
     "tensor_pow_operator_derivative"_test = [] () {
         linalg::tensor m{shape<2, 2>, 1.0, 2.0, 3.0, 4.0};
         const tensor t{shape<2, 2>};
@@ -348,6 +453,89 @@ int main() {
         expect(fuzzy_eq(ddetT_dT[at<2, 2>()], expected[at<2, 2>()]));
     };
 
+    "tensor_4x4_determinant_and_derivative"_test = [] () {
+        const linalg::tensor value{shape<4, 4>,
+            2.0, 0.0, 1.0, 0.0,
+            0.0, 3.0, 0.0, 0.0,
+            1.0, 0.0, 4.0, 0.0,
+            1.0, 2.0, 0.0, 5.0
+        };
+        const tensor T{shape<4, 4>};
+        const auto determinant = value_of(det(T), at(T = value));
+        expect(fuzzy_eq(determinant, 105.0));
+
+        // by Jacobi's formula, the derivative is det(T)*T^-T, and thus, T^T*ddetT_dT = det(T)*I
+        const auto ddetT_dT = derivative_of(det(T), wrt(T), at(T = value));
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j) {
+                double entry = 0.0;
+                for (std::size_t k = 0; k < 4; ++k)
+                    entry += value[k, i]*ddetT_dT[k, j];
+                expect(fuzzy_eq(entry, i == j ? determinant : 0.0));
+            }
+    };
+
+    "tensor_4x4_determinant_shares_factorization_with_derivative"_test = [] () {
+        using namespace xp::traits;
+        const tensor T{shape<4, 4>};
+        using D = decltype(det(T));
+        using dD = std::remove_cvref_t<decltype(derivative_of(det(T), wrt(T)))>;
+        static_assert(std::is_same_v<children_of_t<D>, children_of_t<dD>>);
+        static_assert(std::is_same_v<dD, std::remove_cvref_t<decltype(cofactors(T))>>);
+
+        const linalg::tensor value{shape<4, 4>,
+            2.0, 0.0, 1.0, 0.0,
+            0.0, 3.0, 0.0, 0.0,
+            1.0, 0.0, 4.0, 0.0,
+            1.0, 2.0, 0.0, 5.0
+        };
+        const auto [determinant, derivatives] = value_and_derivatives_of(det(T), wrt(T), at(T = value));
+        expect(fuzzy_eq(determinant, 105.0));
+        const auto cofactors = linalg::cofactors_of(value);
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j)
+                expect(fuzzy_eq(derivatives[T][i, j], cofactors[i, j]));
+    };
+
+    "tensor_4x4_integral_determinant"_test = [] () {
+        const linalg::tensor value{shape<4, 4>,
+            2, 0, 1, 0,
+            0, 3, 0, 0,
+            1, 0, 4, 0,
+            1, 2, 0, 5
+        };
+        const tensor T{shape<4, 4>};
+        static_assert(std::is_same_v<decltype(value_of(det(T), at(T = value))), int>);
+        expect(eq(value_of(det(T), at(T = value)), 105));
+    };
+
+    "tensor_4x4_determinant_hessian"_test = [] () {
+        const linalg::tensor value{shape<4, 4>,
+            2.0, 0.0, 1.0, 0.0,
+            0.0, 3.0, 0.0, 0.0,
+            1.0, 0.0, 4.0, 0.0,
+            1.0, 2.0, 0.0, 5.0
+        };
+        const tensor T{shape<4, 4>};
+        const auto hessian = hessian_of(det(T), wrt(T), at(T = value));
+        const auto& second_derivatives = hessian[0, 0];
+        const auto cofactors = linalg::cofactors_of(value);
+        // determinant of the matrix without the rows 0, 1 and the columns 0, 1
+        expect(fuzzy_eq(second_derivatives[0, 0][1, 1], 20.0));
+        expect(fuzzy_eq(second_derivatives[0, 0][0, 0], 0.0));
+        for (std::size_t i = 0; i < 4; ++i)
+            for (std::size_t j = 0; j < 4; ++j) {
+                // the determinant is homogeneous of degree 4, and thus, dcof(A)/dA : A = 3*cof(A)
+                double contracted = 0.0;
+                for (std::size_t k = 0; k < 4; ++k)
+                    for (std::size_t l = 0; l < 4; ++l) {
+                        contracted += second_derivatives[i, j][k, l]*value[k, l];
+                        expect(fuzzy_eq(second_derivatives[i, j][k, l], second_derivatives[k, l][i, j]));
+                    }
+                expect(fuzzy_eq(contracted, 3.0*cofactors[i, j]));
+            }
+    };
+
     "vector_scalar_product"_test = [] () {
         constexpr std::array<int, 2> data{1, 2};
         static constexpr vector<2> v1{};